@@ -0,0 +1,182 @@
+/*
+ * Microbenchmark of the key state: the byte arrays minimal used before against
+ * the bitsets of src/input.c, both reduced to the key state alone. The library
+ * column runs the real functions with everything else they keep per frame.
+ * Built against the headless backend, so it runs without a display:
+ *
+ *   python3 singleheader.py
+ *   cc -O2 -I. bench/input.c -o input_bench
+ *
+ * Every frame starts with the update, receives two key events and then queries
+ * the keys. The time per frame is the minimum over several runs.
+ */
+#define MINIMAL_IMPLEMENTATION
+#define MINIMAL_PLATFORM_HEADLESS
+#define MINIMAL_NO_CONTEXT
+#include "minimal.h"
+
+#include <stdio.h>
+
+#define BENCH_FRAMES    200000
+#define BENCH_RUNS      15
+
+/* --------------------------| byte arrays |----------------------------- */
+static struct
+{
+    uint8_t keys[MINIMAL_KEY_LAST + 1];
+    uint8_t prev_keys[MINIMAL_KEY_LAST + 1];
+
+    uint8_t buttons[MINIMAL_MOUSE_BUTTON_LAST + 1];
+    uint8_t prev_buttons[MINIMAL_MOUSE_BUTTON_LAST + 1];
+} bytes;
+
+static void bytesUpdateInput()
+{
+    MINIMAL_MEMCPY(&bytes.prev_keys, &bytes.keys, MINIMAL_KEY_LAST + 1);
+    MINIMAL_MEMCPY(&bytes.prev_buttons, &bytes.buttons, MINIMAL_MOUSE_BUTTON_LAST + 1);
+}
+
+static uint8_t bytesProcessKey(MinimalKeycode keycode, uint8_t action)
+{
+    if (minimalKeycodeValid(keycode) && bytes.keys[keycode] != action)
+    {
+        bytes.keys[keycode] = action;
+        return MINIMAL_OK;
+    }
+
+    return MINIMAL_FAIL;
+}
+
+// without the logging the old minimalKeyPressed did for keys that were down
+static uint8_t bytesKeyPressed(MinimalKeycode keycode)
+{
+    if (!minimalKeycodeValid(keycode)) return 0;
+    return bytes.keys[keycode] && !bytes.prev_keys[keycode];
+}
+
+static uint8_t bytesKeyReleased(MinimalKeycode keycode)
+{
+    if (!minimalKeycodeValid(keycode)) return 0;
+    return bytes.prev_keys[keycode] && !bytes.keys[keycode];
+}
+
+/* --------------------------| bitsets |--------------------------------- */
+#define BENCH_BIT_TEST(bits, i)     (((bits)[(i) >> 6] >> ((i) & 63)) & 1)
+
+static struct
+{
+    uint64_t keys[4];
+    uint64_t prev_keys[4];
+    uint64_t pressed_keys[4];
+    uint64_t released_keys[4];
+
+    uint8_t buttons;
+    uint8_t prev_buttons;
+} bits;
+
+static void bitsUpdateInput()
+{
+    MINIMAL_MEMCPY(bits.prev_keys, bits.keys, sizeof(bits.keys));
+    MINIMAL_MEMSET(bits.pressed_keys, 0, sizeof(bits.pressed_keys));
+    MINIMAL_MEMSET(bits.released_keys, 0, sizeof(bits.released_keys));
+    bits.prev_buttons = bits.buttons;
+}
+
+static uint8_t bitsProcessKey(MinimalKeycode keycode, uint8_t action)
+{
+    if (!minimalKeycodeValid(keycode) || BENCH_BIT_TEST(bits.keys, keycode) == (action != 0))
+        return MINIMAL_FAIL;
+
+    uint64_t bit = (uint64_t)1 << (keycode & 63);
+    int w = keycode >> 6;
+
+    if (action) bits.keys[w] |= bit;
+    else        bits.keys[w] &= ~bit;
+
+    bits.pressed_keys[w] = bits.keys[w] & ~bits.prev_keys[w];
+    bits.released_keys[w] = bits.prev_keys[w] & ~bits.keys[w];
+    return MINIMAL_OK;
+}
+
+static uint8_t bitsKeyPressed(MinimalKeycode keycode)
+{
+    if (!minimalKeycodeValid(keycode)) return 0;
+    return BENCH_BIT_TEST(bits.pressed_keys, keycode);
+}
+
+static uint8_t bitsKeyReleased(MinimalKeycode keycode)
+{
+    if (!minimalKeycodeValid(keycode)) return 0;
+    return BENCH_BIT_TEST(bits.released_keys, keycode);
+}
+
+/* --------------------------| benchmark |------------------------------- */
+static const MinimalKeycode benchKeys[16] = {
+    MINIMAL_KEY_W, MINIMAL_KEY_A, MINIMAL_KEY_S, MINIMAL_KEY_D,
+    MINIMAL_KEY_Q, MINIMAL_KEY_E, MINIMAL_KEY_R, MINIMAL_KEY_F,
+    MINIMAL_KEY_SPACE, MINIMAL_KEY_LSHIFT, MINIMAL_KEY_LCONTROL, MINIMAL_KEY_TAB,
+    MINIMAL_KEY_ESCAPE, MINIMAL_KEY_1, MINIMAL_KEY_2, MINIMAL_KEY_3
+};
+
+static volatile uint32_t benchSink;
+
+/* the keys a game checks every frame */
+#define BENCH_QUERY_FEW(pressed, released, hits)                            \
+    for (int i = 0; i < 16; ++i)                                            \
+        hits += pressed(benchKeys[i]) + released(benchKeys[i]);
+
+/* every keycode, like a rebinding screen waiting for any key */
+#define BENCH_QUERY_ALL(pressed, released, hits)                            \
+    for (MinimalKeycode key = MINIMAL_KEY_FIRST; key <= MINIMAL_KEY_LAST; ++key) \
+        hits += pressed(key);
+
+/* a loop per layout and query, so the calls can be inlined like in an app */
+#define BENCH_RUN(name, update, process, pressed, released, query)          \
+static double name()                                                        \
+{                                                                           \
+    uint64_t best = UINT64_MAX;                                             \
+    for (int run = 0; run < BENCH_RUNS; ++run)                              \
+    {                                                                       \
+        uint32_t hits = 0;                                                  \
+        uint64_t start = minimalGetTimeNs();                                \
+        for (uint32_t frame = 0; frame < BENCH_FRAMES; ++frame)             \
+        {                                                                   \
+            update();                                                       \
+            process(benchKeys[frame & 15], MINIMAL_PRESS);                  \
+            process(benchKeys[(frame + 8) & 15], MINIMAL_RELEASE);          \
+            query(pressed, released, hits)                                  \
+        }                                                                   \
+        uint64_t elapsed = minimalGetTimeNs() - start;                      \
+        benchSink = hits;                                                   \
+                                                                            \
+        if (elapsed < best) best = elapsed;                                 \
+    }                                                                       \
+    return (double)best / BENCH_FRAMES;                                     \
+}
+
+BENCH_RUN(benchBytesFew, bytesUpdateInput, bytesProcessKey, bytesKeyPressed, bytesKeyReleased, BENCH_QUERY_FEW)
+BENCH_RUN(benchBytesAll, bytesUpdateInput, bytesProcessKey, bytesKeyPressed, bytesKeyReleased, BENCH_QUERY_ALL)
+BENCH_RUN(benchBitsFew, bitsUpdateInput, bitsProcessKey, bitsKeyPressed, bitsKeyReleased, BENCH_QUERY_FEW)
+BENCH_RUN(benchBitsAll, bitsUpdateInput, bitsProcessKey, bitsKeyPressed, bitsKeyReleased, BENCH_QUERY_ALL)
+BENCH_RUN(benchLibFew, minimalUpdateInput, minimalProcessKey, minimalKeyPressed, minimalKeyReleased, BENCH_QUERY_FEW)
+BENCH_RUN(benchLibAll, minimalUpdateInput, minimalProcessKey, minimalKeyPressed, minimalKeyReleased, BENCH_QUERY_ALL)
+
+int main()
+{
+    // platforms stamp events with the time the system reported, otherwise every transition reads the clock
+    minimalSetEventTime(1);
+
+    printf("ns per frame, minimum of %d runs of %d frames\n", BENCH_RUNS, BENCH_FRAMES);
+    printf("  %-26s %10s %10s %10s\n", "", "bytes", "bitsets", "library");
+
+    printf("  %-26s", "16 keys pressed+released");
+    printf(" %10.1f", benchBytesFew());
+    printf(" %10.1f", benchBitsFew());
+    printf(" %10.1f\n", benchLibFew());
+
+    printf("  %-26s", "scan of all keys");
+    printf(" %10.1f", benchBytesAll());
+    printf(" %10.1f", benchBitsAll());
+    printf(" %10.1f\n", benchLibAll());
+    return 0;
+}
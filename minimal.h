@@ -1,6 +1,15 @@
 #ifndef MINIMAL_H
 #define MINIMAL_H
 
+/*
+ The linux platforms use posix functions hidden by strict -std=c modes. The
+ define has to come before any system header, so include minimal.h first in
+ the file with the implementation or define _DEFAULT_SOURCE yourself.
+*/
+#if defined(MINIMAL_IMPLEMENTATION) && defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -29,19 +38,19 @@ typedef struct MinimalEvent MinimalEvent;
 /* --------------------------| logging |--------------------------------- */
 #ifndef MINIMAL_DISABLE_LOGGING
 
-#define MINIMAL_TRACE(s, ...)       minimalLoggerPrint(MINIMAL_LOG_TRACE, s, __VA_ARGS__)
-#define MINIMAL_INFO(s, ...)        minimalLoggerPrint(MINIMAL_LOG_INFO, s, __VA_ARGS__)
-#define MINIMAL_WARN(s, ...)        minimalLoggerPrint(MINIMAL_LOG_WARN, s, __VA_ARGS__)
-#define MINIMAL_ERROR(s, ...)       minimalLoggerPrint(MINIMAL_LOG_ERROR, s, __VA_ARGS__)
-#define MINIMAL_CRITICAL(s, ...)    minimalLoggerPrint(MINIMAL_LOG_CRITICAL, s, __VA_ARGS__)
+#define MINIMAL_TRACE(...)          minimalLoggerPrint(MINIMAL_LOG_TRACE, __VA_ARGS__)
+#define MINIMAL_INFO(...)           minimalLoggerPrint(MINIMAL_LOG_INFO, __VA_ARGS__)
+#define MINIMAL_WARN(...)           minimalLoggerPrint(MINIMAL_LOG_WARN, __VA_ARGS__)
+#define MINIMAL_ERROR(...)          minimalLoggerPrint(MINIMAL_LOG_ERROR, __VA_ARGS__)
+#define MINIMAL_CRITICAL(...)       minimalLoggerPrint(MINIMAL_LOG_CRITICAL, __VA_ARGS__)
 
 #else
 
-#define MINIMAL_TRACE(s, ...)
-#define MINIMAL_INFO(s, ...)
-#define MINIMAL_WARN(s, ...)
-#define MINIMAL_ERROR(s, ...)
-#define MINIMAL_CRITICAL(s, ...)
+#define MINIMAL_TRACE(...)
+#define MINIMAL_INFO(...)
+#define MINIMAL_WARN(...)
+#define MINIMAL_ERROR(...)
+#define MINIMAL_CRITICAL(...)
 
 #endif
 
@@ -69,6 +78,8 @@ void minimalLoggerPrintV(MinimalLogLevel level, const char* fmt, va_list args);
 #define MINIMAL_ALLOC(size)             malloc(size)
 #define MINIMAL_FREE(block, size)       free(block)
 #define MINIMAL_MEMCPY(dst, src, size)  memcpy(dst, src, size);
+#define MINIMAL_MEMMOVE(dst, src, size) memmove(dst, src, size)
+#define MINIMAL_MEMSET(dst, val, size)  memset(dst, val, size)
 
 
 /* --------------------------| input |----------------------------------- */
@@ -255,6 +266,15 @@ uint8_t minimalProcessKey(MinimalKeycode keycode, uint8_t action);
 uint8_t minimalProcessMouseButton(MinimalMouseButton button, uint8_t action);
 uint8_t minimalProcessMouseMove(float x, float y);
 
+/*
+ Raw motion is the unaccelerated relative movement reported by the device, in
+ 24.8 fixed point counts. Platforms only report it to windows with
+ MINIMAL_EVENT_MOUSE_RAW enabled in their event mask.
+*/
+#define MINIMAL_MOUSE_RAW_ONE       256
+
+uint8_t minimalProcessMouseRaw(int32_t dx, int32_t dy);
+
 uint8_t minimalKeycodeValid(MinimalKeycode keycode);
 uint8_t minimalMouseButtonValid(MinimalMouseButton button);
 
@@ -268,10 +288,149 @@ uint8_t minimalMousePressed(MinimalMouseButton button);
 uint8_t minimalMouseReleased(MinimalMouseButton button);
 uint8_t minimalMouseDown(MinimalMouseButton button);
 
+/*
+ Keys and buttons that changed since the last minimalUpdateInput, in the order
+ they changed. A key pressed and released within one frame shows up in both.
+ Return the number of entries written to the array.
+*/
+#ifndef MINIMAL_INPUT_LOG_SIZE
+#define MINIMAL_INPUT_LOG_SIZE          64  /* transitions logged per frame */
+#endif
+
+uint32_t minimalGetPressedKeys(MinimalKeycode* keys, uint32_t max);
+uint32_t minimalGetReleasedKeys(MinimalKeycode* keys, uint32_t max);
+uint32_t minimalGetPressedButtons(MinimalMouseButton* buttons, uint32_t max);
+uint32_t minimalGetReleasedButtons(MinimalMouseButton* buttons, uint32_t max);
+
+/*
+ Every logged transition carries the time of its event, so taps shorter than a
+ frame are counted even though they never show up as pressed. The time is the
+ one of the first press in the frame, on the clock of minimalGetTimeNs.
+*/
+uint32_t minimalKeyPressCount(MinimalKeycode keycode);
+uint8_t minimalKeyPressedAt(MinimalKeycode keycode, uint64_t* time);
+uint32_t minimalMousePressCount(MinimalMouseButton button);
+uint8_t minimalMousePressedAt(MinimalMouseButton button, uint64_t* time);
+
 void minimalCursorPos(float* x, float* y);
 float minimalCursorX();
 float minimalCursorY();
 
+/* raw motion summed since the last minimalUpdateInput */
+void minimalMouseDelta(float* dx, float* dy);
+
+/* every cursor sample since the last minimalUpdateInput, recorded only when enabled */
+#ifndef MINIMAL_MOUSE_HISTORY_SIZE
+#define MINIMAL_MOUSE_HISTORY_SIZE      256
+#endif
+
+typedef struct
+{
+    float x, y;
+} MinimalMouseSample;
+
+void minimalSetMouseHistory(uint8_t enable);
+const MinimalMouseSample* minimalGetMouseHistory(uint32_t* count);
+
+/* actions */
+/*
+ Actions are ids below MINIMAL_ACTION_MAX bound to keys and buttons, optionally
+ with required key mods, or to the cursor movement of the current frame. Bindings
+ take effect once they are compiled, so they can be swapped at runtime. The value
+ of an action sums the scale of its active digital bindings and the scaled
+ movement of its axes.
+*/
+#ifndef MINIMAL_ACTION_MAX
+#define MINIMAL_ACTION_MAX              64  /* at most 64 */
+#endif
+
+#ifndef MINIMAL_ACTION_MAX_BINDINGS
+#define MINIMAL_ACTION_MAX_BINDINGS     128
+#endif
+
+typedef enum
+{
+    MINIMAL_MOUSE_AXIS_X,
+    MINIMAL_MOUSE_AXIS_Y
+} MinimalMouseAxis;
+
+uint8_t minimalBindKey(uint32_t action, MinimalKeycode key, uint32_t keymod, float scale);
+uint8_t minimalBindMouseButton(uint32_t action, MinimalMouseButton button, uint32_t keymod, float scale);
+uint8_t minimalBindMouseAxis(uint32_t action, MinimalMouseAxis axis, float scale);
+void minimalClearBindings();
+void minimalCompileBindings();
+
+uint8_t minimalActionDown(uint32_t action);
+uint8_t minimalActionPressed(uint32_t action);
+uint8_t minimalActionReleased(uint32_t action);
+float minimalActionValue(uint32_t action);
+
+/* --------------------------| gamepad |--------------------------------- */
+/*
+ Gamepads and joysticks are read from evdev devices on linux, other platforms
+ report none. minimalGamepadInit opens the connected devices and watches for new
+ ones, minimalRun updates them once per frame with every complete report the
+ devices sent since the last frame. Buttons and axes are mapped to the
+ layout of an xbox controller, sticks range from -1 to 1 with y pointing down,
+ triggers from 0 to 1. Values inside the deadzone read as zero.
+*/
+#ifndef MINIMAL_GAMEPAD_MAX
+#define MINIMAL_GAMEPAD_MAX             4
+#endif
+
+#ifndef MINIMAL_GAMEPAD_DEADZONE
+#define MINIMAL_GAMEPAD_DEADZONE        0.15f   /* initial deadzone as a fraction of the range */
+#endif
+
+#define MINIMAL_GAMEPAD_BUTTON_UNKNOWN      -1
+
+#define MINIMAL_GAMEPAD_BUTTON_A            0
+#define MINIMAL_GAMEPAD_BUTTON_B            1
+#define MINIMAL_GAMEPAD_BUTTON_X            2
+#define MINIMAL_GAMEPAD_BUTTON_Y            3
+#define MINIMAL_GAMEPAD_BUTTON_LEFT_BUMPER  4
+#define MINIMAL_GAMEPAD_BUTTON_RIGHT_BUMPER 5
+#define MINIMAL_GAMEPAD_BUTTON_BACK         6
+#define MINIMAL_GAMEPAD_BUTTON_START        7
+#define MINIMAL_GAMEPAD_BUTTON_GUIDE        8
+#define MINIMAL_GAMEPAD_BUTTON_LEFT_THUMB   9
+#define MINIMAL_GAMEPAD_BUTTON_RIGHT_THUMB  10
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_UP      11
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_RIGHT   12
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_DOWN    13
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT    14
+
+#define MINIMAL_GAMEPAD_BUTTON_LAST         MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT
+
+#define MINIMAL_GAMEPAD_AXIS_LEFT_X         0
+#define MINIMAL_GAMEPAD_AXIS_LEFT_Y         1
+#define MINIMAL_GAMEPAD_AXIS_RIGHT_X        2
+#define MINIMAL_GAMEPAD_AXIS_RIGHT_Y        3
+#define MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER   4
+#define MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER  5
+
+#define MINIMAL_GAMEPAD_AXIS_LAST           MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER
+
+typedef int8_t MinimalGamepadButton;
+typedef int8_t MinimalGamepadAxis;
+
+uint8_t minimalGamepadInit();
+void minimalGamepadTerminate();
+
+/* starts a new frame for all gamepads, does nothing before minimalGamepadInit */
+void minimalUpdateGamepads();
+
+void minimalSetGamepadDeadzone(float deadzone);
+
+uint8_t minimalGamepadConnected(uint32_t pad);
+const char* minimalGamepadName(uint32_t pad);
+
+uint8_t minimalGamepadPressed(uint32_t pad, MinimalGamepadButton button);
+uint8_t minimalGamepadReleased(uint32_t pad, MinimalGamepadButton button);
+uint8_t minimalGamepadDown(uint32_t pad, MinimalGamepadButton button);
+
+float minimalGamepadAxis(uint32_t pad, MinimalGamepadAxis axis);
+
 /* --------------------------| event |----------------------------------- */
 #define MINIMAL_EVENT_UNKOWN            0
 
@@ -288,20 +447,182 @@ float minimalCursorY();
 #define MINIMAL_EVENT_MOUSE_BUTTON      12
 #define MINIMAL_EVENT_MOUSE_MOVED       13
 #define MINIMAL_EVENT_MOUSE_SCROLLED    14
+#define MINIMAL_EVENT_MOUSE_RAW         15
+
+#define MINIMAL_EVENT_LAST              MINIMAL_EVENT_MOUSE_RAW
 
-#define MINIMAL_EVENT_LAST              MINIMAL_EVENT_MOUSE_SCROLLED
+struct MinimalEvent
+{
+    uint32_t type;
+    uint32_t seq;
+    MinimalWindow* window;
+    uint64_t time;
+    union
+    {
+        struct
+        {
+            uint32_t uParam;
+            int32_t lParam;
+            int32_t rParam;
+        };
+        const void* external;
+    };
+};
 
 /* Dispatch */
 typedef uint8_t(*MinimalEventCB)(void* context, const MinimalEvent* e);
 void minimalSetEventHandler(void* context, MinimalEventCB callback);
 
+/*
+ Subscribers only see events of their type. External types share one list, and
+ its limit, but are still told apart. Higher priorities run first, a callback
+ returning nonzero consumes the event and stops it from reaching lower
+ priorities and the event handler, which runs last. Callbacks may subscribe and
+ unsubscribe, removed subscribers are not called anymore and new ones only see
+ events dispatched after the current delivery returns.
+*/
+#ifndef MINIMAL_EVENT_MAX_SUBSCRIBERS
+#define MINIMAL_EVENT_MAX_SUBSCRIBERS   8   /* per event type */
+#endif
+
+/*
+ With a batch handler the events of one poll are collected and passed in a
+ single call, sorted by arrival, when the platform flushes at the end of the
+ poll. It replaces subscribers and the event handler in callback mode.
+*/
+typedef void(*MinimalEventBatchCB)(void* context, const MinimalEvent* events, size_t count);
+void minimalSetEventBatchHandler(void* context, MinimalEventBatchCB callback);
+
+uint8_t minimalSubscribeEvent(uint32_t type, int32_t priority, void* context, MinimalEventCB callback);
+void minimalUnsubscribeEvent(uint32_t type, void* context, MinimalEventCB callback);
+
+/* Queue */
+#ifndef MINIMAL_EVENT_QUEUE_SIZE
+#define MINIMAL_EVENT_QUEUE_SIZE        256 /* must be a power of two */
+#endif
+
+typedef enum
+{
+    MINIMAL_EVENT_MODE_CALLBACK,    /* events are passed to the event handler while polling */
+    MINIMAL_EVENT_MODE_QUEUE        /* events are buffered until they are pulled with minimalPollEvent */
+} MinimalEventMode;
+
+void minimalSetEventMode(MinimalEventMode mode);
+
+/*
+ Coalescing merges consecutive mouse moves of a window into one event carrying
+ the final position and the summed delta, consecutive raw motion into its sum
+ and consecutive resizes into the last size. In callback mode the last merged event is delivered by minimalFlushEvents,
+ which the platform calls at the end of every poll.
+*/
+void minimalSetEventCoalescing(uint8_t enable);
+void minimalFlushEvents();
+
+uint8_t minimalPollEvent(MinimalEvent* e);
+uint32_t minimalGetDroppedEventCount();
+
 void minimalDispatchEvent(uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam);
+void minimalDispatchWindowEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam);
 void minimalDispatchExternalEvent(uint32_t type, const void* data);
 
+/*
+ While discarding, input from the platforms, gamepads and other threads is
+ drained without updating the input state or reaching any handler. minimalRun
+ discards live input while it replays a recording.
+*/
+void minimalDiscardEvents(uint8_t discard);
+uint8_t minimalEventsDiscarded();
+
+/*
+ Motion events carry the distance to the last motion event of the same window.
+ Platforms reset it when the cursor leaves a window or the window is destroyed,
+ so the next move starts with a zero delta instead of a jump.
+*/
+void minimalResetMouseDelta(MinimalWindow* window);
+
+/*
+ Copies the payload into an arena owned by the event system, so it can be
+ deferred without keeping the data alive. minimalRun resets the arena at the
+ start of every frame, copies are valid until then.
+*/
+#ifndef MINIMAL_EVENT_ARENA_SIZE
+#define MINIMAL_EVENT_ARENA_SIZE        16384   /* must be a multiple of 8 */
+#endif
+
+uint8_t minimalDispatchExternalEventCopy(uint32_t type, const void* data, size_t size);
+void minimalResetEventArena();
+
+/*
+ Events are stamped on the clock of minimalGetTimeNs when they are dispatched.
+ Platforms pass the time the os reported for the input they translate instead,
+ rebasing its millisecond clock with minimalRebaseEventTime. Zero clears it.
+*/
+void minimalSetEventTime(uint64_t ns);
+uint64_t minimalRebaseEventTime(uint32_t ms);
+
+/* the time the next dispatched event is stamped with */
+uint64_t minimalGetEventTime();
+
+/*
+ Posting is safe from any thread and never blocks. The payload is copied into a
+ fixed size slot and handed to handlers as external event data on the main thread
+ by minimalDispatchPostedEvents, which minimalRun calls once per frame. The data
+ is moved to the event arena and stays valid like a copied event, its slot is
+ free again right away. Events are dropped if the queue is full and wait for the
+ next frame if the arena is.
+*/
+#ifndef MINIMAL_POST_QUEUE_SIZE
+#define MINIMAL_POST_QUEUE_SIZE         256 /* must be a power of two */
+#endif
+
+#ifndef MINIMAL_POST_EVENT_SIZE
+#define MINIMAL_POST_EVENT_SIZE         64  /* must be a multiple of 8 */
+#endif
+
+uint8_t minimalPostExternalEvent(uint32_t type, const void* data, size_t size);
+void minimalDispatchPostedEvents();
+uint32_t minimalGetDroppedPostedEventCount();
+
+/*
+ Masked out event types are dropped by the platform before any translation work,
+ on X11 the server stops sending them. Masked keys and mouse buttons do not update
+ the input state either. Windows start with every type but raw motion enabled.
+*/
+#define MINIMAL_EVENT_MASK(type)        ((uint32_t)1 << (type))
+#define MINIMAL_EVENT_MASK_ALL          0xffffffff
+#define MINIMAL_EVENT_MASK_DEFAULT      (MINIMAL_EVENT_MASK_ALL & ~MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW))
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask);
+
+/* used by the platforms, events without a window are always enabled */
+#define MINIMAL_EVENT_ENABLED(window, type) (!(window) || ((window)->eventMask & MINIMAL_EVENT_MASK(type)))
+
+/* Statistics */
+typedef struct
+{
+    uint32_t dispatched[MINIMAL_EVENT_LAST + 2];    /* per builtin type, external events in the last slot */
+    uint32_t coalesced;                             /* events merged into an earlier one */
+    uint32_t dropped;                               /* events lost to a full queue or batch */
+    uint32_t highWater;                             /* most events waiting in the queue or batch */
+    uint64_t pollTime;                              /* ns spent polling in minimalRun, including handlers */
+    uint64_t handlerTime;                           /* ns spent in subscribers and handlers */
+} MinimalEventStats;
+
+/* counters accumulate until they are reset, e.g. once per frame */
+void minimalGetEventStats(MinimalEventStats* stats);
+void minimalResetEventStats();
+
 /* Utility */
 uint8_t minimalEventIsType(const MinimalEvent* e, uint32_t type);
 uint8_t minimalEventIsExternal(const MinimalEvent* e);
 
+/* window the event was sent to, NULL for events without a window */
+MinimalWindow* minimalEventWindow(const MinimalEvent* e);
+
+/* nanoseconds on the clock of minimalGetTimeNs and a number counting up with every dispatched event */
+uint64_t minimalEventTimestamp(const MinimalEvent* e);
+uint32_t minimalEventSequence(const MinimalEvent* e);
+
 const void* minimalExternalEvent(const MinimalEvent* e);
 
 uint8_t minimalEventWindowSize(const MinimalEvent* e, uint32_t* w, uint32_t* h);
@@ -312,6 +633,8 @@ uint8_t minimalEventMouseButtonReleased(const MinimalEvent* e, MinimalMouseButto
 uint16_t minimalEventMouseButtonAction(const MinimalEvent* e);
 
 uint8_t minimalEventMouseMoved(const MinimalEvent* e, float* x, float* y);
+uint8_t minimalEventMouseDelta(const MinimalEvent* e, int32_t* dx, int32_t* dy);
+uint8_t minimalEventMouseRaw(const MinimalEvent* e, float* dx, float* dy);
 uint8_t minimalEventMouseScrolled(const MinimalEvent* e, float* xoffset, float* yoffset);
 
 MinimalKeycode minimalEventKey(const MinimalEvent* e);
@@ -320,26 +643,69 @@ MinimalKeycode minimalEventKeyReleased(const MinimalEvent* e);
 
 char minimalEventChar(const MinimalEvent* e);
 
+/* --------------------------| record |---------------------------------- */
+/*
+ Recordings capture the input minimalRun polls and the time of every frame in a
+ compact binary log. Events dispatched by handlers or on_tick are left out, the
+ replay dispatches them again. Payloads of external events are kept if their
+ size is known (copied and posted events), events passed with a payload to
+ minimalDispatchExternalEvent are left out with a warning. Replaying feeds the
+ events back through the input state and the handlers, with minimalRun running
+ on the recorded clock as fast as possible and returning at the end of the
+ recording. Replayed events are sent to the window passed to minimalRun, live
+ input is discarded until the replay ends.
+*/
+uint8_t minimalRecordStart(const char* path);
+
+/* fails if the recording is incomplete, a failed write ends it early */
+uint8_t minimalRecordStop();
+
+uint8_t minimalReplayStart(const char* path);
+void minimalReplayStop();
+uint8_t minimalReplaying();
+
 
 /* --------------------------| platform |-------------------------------- */
 /*
  Possible platforms
 
 #define MINIMAL_PLATFORM_WINDOWS
+#define MINIMAL_PLATFORM_X11        (link with -lX11 -lXext -lXi -lGL)
+#define MINIMAL_PLATFORM_WAYLAND    (link with -lwayland-client -lwayland-egl -lxkbcommon -lEGL,
+                                     generate the client header and private code of xdg-shell,
+                                     relative-pointer-unstable-v1 and pointer-constraints-unstable-v1
+                                     with wayland-scanner and compile the three protocol .c files)
+#define MINIMAL_PLATFORM_HEADLESS   (link with -lEGL, no display required)
 #define MINIMAL_PLATFORM_GLFW
 
 dissable opengl context creation with:
 #define MINIMAL_NO_CONTEXT
 
+create the context through egl instead of wgl/glx with:
+#define MINIMAL_CONTEXT_EGL         (link with -lEGL, wayland and headless always use egl)
+
 */
 
+#if (defined(MINIMAL_PLATFORM_WAYLAND) || defined(MINIMAL_PLATFORM_HEADLESS)) && !defined(MINIMAL_CONTEXT_EGL)
+#define MINIMAL_CONTEXT_EGL
+#endif
+
+#ifdef MINIMAL_NO_CONTEXT
+#undef MINIMAL_CONTEXT_EGL
+#endif
+
 typedef enum
 {
     MINIMAL_HINT_CONTEXT_MAJOR_VERSION,
     MINIMAL_HINT_CONTEXT_MINOR_VERSION,
+    MINIMAL_HINT_CLIENT_API,
     MINIMAL_HINT_MAX_ENUM
 } MinimalWindowHint;
 
+/* values for MINIMAL_HINT_CLIENT_API, windows without api get no context (e.g. for vulkan) */
+#define MINIMAL_OPENGL_API  0
+#define MINIMAL_NO_API      1
+
 void minimalSetWindowHint(MinimalWindowHint name, int32_t value);
 
 uint8_t minimalPlatformInit();
@@ -352,19 +718,55 @@ void minimalSetWindowTitle(MinimalWindow* window, const char* title);
 
 void minimalPollWindowEvents(MinimalWindow* window);
 
+/* processes the events of every window in one pass */
+void minimalPollAllEvents();
+
+/*
+ * sleeps until events arrive, the timeout in nanoseconds expires or minimalWakeWindow
+ * is called, then processes the events of every window like minimalPollAllEvents
+ */
+#define MINIMAL_WAIT_INFINITE   UINT64_MAX
+
+void minimalWaitWindowEvents(MinimalWindow* window, uint64_t timeout);
+void minimalWakeWindow(MinimalWindow* window); /* can be called from any thread */
+
 uint8_t minimalShouldClose(const MinimalWindow* window);
 void minimalClose(MinimalWindow* window);
 
 void minimalMaximize(MinimalWindow* window);
 void minimalMinimize(MinimalWindow* window);
 
+/* hides the cursor and keeps it inside the window, e.g. for camera control with raw motion */
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock);
+
+/* time since minimalPlatformInit */
 double minimalGetTime();
+uint64_t minimalGetTimeNs();
+
+/* cheap timestamps for hot paths (invariant tsc if available, else nanoseconds) */
+uint64_t minimalGetTicks();
+uint64_t minimalTicksToNs(uint64_t ticks);
 
 void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h);
 void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale);
 
 void* minimalGetNativeWindowHandle(const MinimalWindow* window);
 
+/* Display* on x11, wl_display* on wayland, HINSTANCE on windows */
+void* minimalGetNativeDisplayHandle();
+
+/* cpu framebuffer of 0x00RRGGBB pixels, rows are tightly packed */
+#define MINIMAL_FRAMEBUFFER_COUNT   2
+
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h);
+void minimalDestroyFramebuffer(MinimalWindow* window);
+
+/*
+ * presents the current buffer and returns the one to draw the next frame into,
+ * its previous content is undefined. NULL if the window closes first.
+ */
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window);
+
 #ifndef MINIMAL_NO_CONTEXT
 
 void* minimalGetGLProcAddress(const char* name);
@@ -374,6 +776,41 @@ void minimalSwapBuffers(MinimalWindow* context);
 
 #endif
 
+/* --------------------------| vulkan |---------------------------------- */
+/* instance extensions needed by minimalCreateVulkanSurface, NULL if vulkan is unavailable */
+const char** minimalGetRequiredVulkanInstanceExtensions(uint32_t* count);
+
+#ifdef VK_VERSION_1_0
+VkResult minimalCreateVulkanSurface(VkInstance instance, const MinimalWindow* window, const VkAllocationCallbacks* allocator, VkSurfaceKHR* surface);
+#endif
+
+#ifdef MINIMAL_PLATFORM_HEADLESS
+
+/* queue an event to be processed by the next minimalPollWindowEvents */
+uint8_t minimalInjectEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam);
+
+#endif
+
+#ifdef MINIMAL_CONTEXT_EGL
+
+/* egl context creation shared by the platform backends */
+typedef struct
+{
+    void* surface;
+    void* context;
+} MinimalEGLContext;
+
+uint8_t minimalEGLInit(uint32_t platform, void* nativeDisplay);
+void minimalEGLTerminate();
+
+uint8_t minimalEGLCreateContext(MinimalEGLContext* egl, void* nativeWindow, uint32_t w, uint32_t h, int32_t major, int32_t minor);
+void minimalEGLDestroyContext(MinimalEGLContext* egl);
+
+void minimalEGLSwapBuffers(MinimalEGLContext* egl);
+void minimalEGLSwapInterval(int32_t interval);
+
+#endif
+
 /* --------------------------| game loop |------------------------------- */
 typedef struct
 {
@@ -386,6 +823,18 @@ void minimalRun(MinimalWindow* window, MinimalTickCB on_tick, void* context);
 
 void minimalClose(MinimalWindow* window);
 
+/* --------------------------| internal |-------------------------------- */
+/* shared between the modules, not meant to be called by applications */
+void minimalInitTicks();
+void minimalAddEventPollTime(uint64_t ticks);
+
+void minimalRecordFrame(uint64_t time, uint64_t delta);
+void minimalRecordCapture(uint8_t capture);
+void minimalRecordEvent(const MinimalEvent* e, const void* data, size_t size);
+
+uint8_t minimalReplayFrame(uint64_t* time, uint64_t* delta);
+void minimalReplayEvents(MinimalWindow* window);
+
 /* --------------------------| context |--------------------------------- */
 void minimalSetCurrentContext(MinimalWindow* context);
 MinimalWindow* minimalGetCurrentContext();
@@ -416,30 +865,159 @@ const char* minimalGetVersionString()
     return MINIMAL_MAKE_VERSION_STR(MINIMAL_VERSION_MAJOR, MINIMAL_VERSION_MINOR, MINIMAL_VERSION_REVISION);
 }
 
+/* --------------------------| time |------------------------------------ */
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define MINIMAL_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #include <cpuid.h>
+    #define MINIMAL_TSC
+#endif
+
+#define MINIMAL_TSC_CALIBRATION_NS  5000000
+
+typedef enum
+{
+    MINIMAL_TICKS_UNKNOWN,
+    MINIMAL_TICKS_TSC,
+    MINIMAL_TICKS_NS
+} MinimalTickSource;
+
+static MinimalTickSource _minimalTickSource = MINIMAL_TICKS_UNKNOWN;
+static uint64_t _minimalTickFrequency = 1000000000;
+
+#ifdef MINIMAL_TSC
+static uint8_t minimalHasInvariantTSC()
+{
+    uint32_t regs[4] = { 0 };
+#ifdef _MSC_VER
+    __cpuid((int*)regs, 0x80000000);
+    if (regs[0] < 0x80000007) return 0;
+    __cpuid((int*)regs, 0x80000007);
+#else
+    if (!__get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3])) return 0;
+#endif
+    // edx bit 8: tsc runs at a constant rate in all p-/c-states
+    return (regs[3] >> 8) & 1;
+}
+#endif
+
+/*
+ * Picks the tick source, called by minimalPlatformInit once its clock runs.
+ * The tsc frequency is measured against minimalGetTimeNs by spinning for a few
+ * milliseconds, which would otherwise stall the first call to minimalGetTicks.
+ */
+void minimalInitTicks()
+{
+    _minimalTickSource = MINIMAL_TICKS_NS;
+    _minimalTickFrequency = 1000000000;
+
+#ifdef MINIMAL_TSC
+    if (!minimalHasInvariantTSC()) return;
+
+    uint64_t ns0 = minimalGetTimeNs();
+    uint64_t tsc0 = __rdtsc();
+
+    uint64_t ns1 = ns0;
+    while (ns1 - ns0 < MINIMAL_TSC_CALIBRATION_NS)
+        ns1 = minimalGetTimeNs();
+
+    uint64_t tsc1 = __rdtsc();
+
+    if (tsc1 <= tsc0) return;
+
+    _minimalTickFrequency = (tsc1 - tsc0) * 1000000000 / (ns1 - ns0);
+    _minimalTickSource = MINIMAL_TICKS_TSC;
+#endif
+}
+
+double minimalGetTime()
+{
+    return (double)minimalGetTimeNs() / 1000000000.0;
+}
+
+uint64_t minimalGetTicks()
+{
+    if (_minimalTickSource == MINIMAL_TICKS_UNKNOWN)
+        minimalInitTicks();
+
+#ifdef MINIMAL_TSC
+    if (_minimalTickSource == MINIMAL_TICKS_TSC)
+        return __rdtsc();
+#endif
+
+    return minimalGetTimeNs();
+}
+
+uint64_t minimalTicksToNs(uint64_t ticks)
+{
+    if (_minimalTickSource != MINIMAL_TICKS_TSC)
+        return ticks;
+
+    // split the division so the multiplication can not overflow
+    uint64_t seconds = ticks / _minimalTickFrequency;
+    uint64_t remainder = ticks % _minimalTickFrequency;
+    return seconds * 1000000000 + remainder * 1000000000 / _minimalTickFrequency;
+}
+
 /* --------------------------| game loop |------------------------------- */
 void minimalRun(MinimalWindow* window, MinimalTickCB on_tick, void* context)
 {
-    double seconds = 0.0;
-    double lastframe = 0.0;
+    uint64_t seconds = 0;
+    uint64_t lastframe = 0;
     uint32_t frames = 0;
 
     MinimalFrameData framedata = {0};
 
     while (!minimalShouldClose(window))
     {
-        double time = minimalGetTime();
-        framedata.deltatime = (float)(time - lastframe);
+        uint64_t time = minimalGetTimeNs();
+        uint64_t delta = lastframe ? time - lastframe : 0;
+
+        // replays run on the recorded clock and end with the recording
+        if (minimalReplaying() && !minimalReplayFrame(&time, &delta))
+        {
+            minimalReplayStop();
+            break;
+        }
+
+        framedata.deltatime = (float)((double)delta / 1000000000);
         lastframe = time;
 
+        minimalRecordFrame(time, delta);
+
+        minimalResetEventArena();
         minimalUpdateInput();
-        minimalPollWindowEvents(window);
+
+        uint64_t pollStart = minimalGetTicks();
+        if (minimalReplaying())
+        {
+            // live input is drained to keep the window responsive, the frame only sees the recording
+            minimalDiscardEvents(1);
+            minimalPollWindowEvents(window);
+            minimalUpdateGamepads();
+            minimalDispatchPostedEvents();
+            minimalDiscardEvents(0);
+
+            minimalReplayEvents(window);
+        }
+        else
+        {
+            minimalRecordCapture(1);
+            minimalPollWindowEvents(window);
+            minimalUpdateGamepads();
+            minimalDispatchPostedEvents();
+            minimalRecordCapture(0);
+        }
+        minimalAddEventPollTime(minimalGetTicks() - pollStart);
 
         on_tick(context, &framedata);
 
         frames++;
-        if ((minimalGetTime() - seconds) > 1.0)
+        if ((time - seconds) > 1000000000)
         {
-            seconds += 1.0;
+            seconds += 1000000000;
             framedata.fps = frames;
             frames = 0;
         }
@@ -504,55 +1082,186 @@ void minimalLoggerPrintV(MinimalLogLevel level, const char* fmt, va_list args)
 
 
 
+/* one bit per keycode, 256 bits cover every valid keycode */
+#define MINIMAL_KEY_WORDS   4
+
+#if MINIMAL_KEY_LAST >= MINIMAL_KEY_WORDS * 64
+#error "keycodes have to fit into the key bitset"
+#endif
+
+#define MINIMAL_BIT_TEST(bits, i)   (((bits)[(i) >> 6] >> ((i) & 63)) & 1)
+#define MINIMAL_BIT_SET(bits, i)    ((bits)[(i) >> 6] |= (uint64_t)1 << ((i) & 63))
+#define MINIMAL_BIT_CLEAR(bits, i)  ((bits)[(i) >> 6] &= ~((uint64_t)1 << ((i) & 63)))
+
+/* a key or button that changed, in the order the changes happened */
 typedef struct
 {
-    uint8_t keys[MINIMAL_KEY_LAST + 1];
-    uint8_t prev_keys[MINIMAL_KEY_LAST + 1];
+    uint64_t time;
+    int16_t code;
+    uint8_t action;
+} MinimalTransition;
+
+typedef struct
+{
+    uint64_t keys[MINIMAL_KEY_WORDS];
+    uint64_t prev_keys[MINIMAL_KEY_WORDS];
+
+    // edges since the start of the frame, kept up to date with every key event
+    uint64_t pressed_keys[MINIMAL_KEY_WORDS];
+    uint64_t released_keys[MINIMAL_KEY_WORDS];
 
-    uint8_t buttons[MINIMAL_MOUSE_BUTTON_LAST + 1];
-    uint8_t prev_buttons[MINIMAL_MOUSE_BUTTON_LAST + 1];
+    uint8_t buttons;
+    uint8_t prev_buttons;
+
+    // transitions since the start of the frame, later ones are not logged once full
+    MinimalTransition keyLog[MINIMAL_INPUT_LOG_SIZE];
+    uint32_t keyLogCount;
+    MinimalTransition buttonLog[MINIMAL_INPUT_LOG_SIZE];
+    uint32_t buttonLogCount;
 
     float cursorX, cursorY;
+    float frameCursorX, frameCursorY;
+
+    // raw motion of the frame in 24.8 fixed point, exact no matter how many samples add up
+    int32_t rawX, rawY;
+
+    uint8_t recordHistory;
+    uint32_t historyCount;
+    MinimalMouseSample history[MINIMAL_MOUSE_HISTORY_SIZE];
 } MinimalInputState;
 
 static MinimalInputState state = { 0 };
 
+#if MINIMAL_ACTION_MAX > 64
+#error "MINIMAL_ACTION_MAX can be at most 64"
+#endif
+
+#define MINIMAL_BINDING_KEY         0
+#define MINIMAL_BINDING_BUTTON      1
+#define MINIMAL_BINDING_AXIS        2
+
+typedef struct
+{
+    uint8_t kind;
+    uint8_t action;
+    int16_t code;
+    uint32_t keymod;
+    float scale;
+} MinimalBinding;
+
+/*
+ * Bindings are registered in any order and compiled into a table grouped by
+ * kind, which is evaluated in one pass on the first query after the input changed.
+ */
+static struct
+{
+    MinimalBinding bindings[MINIMAL_ACTION_MAX_BINDINGS];
+    uint32_t count;
+
+    MinimalBinding table[MINIMAL_ACTION_MAX_BINDINGS];
+    uint32_t keyCount;
+    uint32_t buttonCount;
+    uint32_t axisCount;
+
+    uint64_t down;
+    uint64_t prev;
+    float values[MINIMAL_ACTION_MAX];
+    uint8_t dirty;
+} actions;
+
+static void minimalEvaluateActions();
+
 void minimalUpdateInput()
 {
-    MINIMAL_MEMCPY(&state.prev_keys, &state.keys, MINIMAL_KEY_LAST + 1);
-    MINIMAL_MEMCPY(&state.prev_buttons, &state.buttons, MINIMAL_MOUSE_BUTTON_LAST + 1);
+    // the previous frame has to be settled before its state becomes the previous one
+    if (actions.dirty) minimalEvaluateActions();
+    actions.prev = actions.down;
+    actions.dirty = 1;
+
+    state.frameCursorX = state.cursorX;
+    state.frameCursorY = state.cursorY;
+    state.rawX = 0;
+    state.rawY = 0;
+
+    // the keys of the frame become the previous ones and there are no edges yet
+    MINIMAL_MEMCPY(state.prev_keys, state.keys, sizeof(state.keys));
+    MINIMAL_MEMSET(state.pressed_keys, 0, sizeof(state.pressed_keys));
+    MINIMAL_MEMSET(state.released_keys, 0, sizeof(state.released_keys));
+    state.prev_buttons = state.buttons;
+    state.keyLogCount = 0;
+    state.buttonLogCount = 0;
+    state.historyCount = 0;
 }
 
 uint8_t minimalProcessKey(MinimalKeycode keycode, uint8_t action)
 {
-    if (minimalKeycodeValid(keycode) && state.keys[keycode] != action)
-    {
-        state.keys[keycode] = action;
-        return MINIMAL_OK;
-    }
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
 
-    return MINIMAL_FAIL;
+    if (!minimalKeycodeValid(keycode) || MINIMAL_BIT_TEST(state.keys, keycode) == (action != 0))
+        return MINIMAL_FAIL;
+
+    if (action) MINIMAL_BIT_SET(state.keys, keycode);
+    else        MINIMAL_BIT_CLEAR(state.keys, keycode);
+
+    // only the word holding the key can change its edges
+    int w = keycode >> 6;
+    state.pressed_keys[w] = state.keys[w] & ~state.prev_keys[w];
+    state.released_keys[w] = state.prev_keys[w] & ~state.keys[w];
+
+    if (state.keyLogCount < MINIMAL_INPUT_LOG_SIZE)
+        state.keyLog[state.keyLogCount++] = (MinimalTransition){ minimalGetEventTime(), keycode, action != 0 };
+
+    actions.dirty = 1;
+    return MINIMAL_OK;
 }
 
 uint8_t minimalProcessMouseButton(MinimalMouseButton button, uint8_t action)
 {
-    if (minimalMouseButtonValid(button) && state.buttons[button] != action)
-    {
-        state.buttons[button] = action;
-        return MINIMAL_OK;
-    }
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
 
-    return MINIMAL_FAIL;
+    if (!minimalMouseButtonValid(button)) return MINIMAL_FAIL;
+
+    uint8_t bit = (uint8_t)(1 << button);
+    if (((state.buttons & bit) != 0) == (action != 0)) return MINIMAL_FAIL;
+
+    if (action) state.buttons |= bit;
+    else        state.buttons &= ~bit;
+
+    if (state.buttonLogCount < MINIMAL_INPUT_LOG_SIZE)
+        state.buttonLog[state.buttonLogCount++] = (MinimalTransition){ minimalGetEventTime(), button, action != 0 };
+
+    actions.dirty = 1;
+    return MINIMAL_OK;
 }
 
 uint8_t minimalProcessMouseMove(float x, float y)
 {
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
+
     state.cursorX = x;
     state.cursorY = y;
+
+    // samples past the capacity are dropped, the cursor position stays current
+    if (state.recordHistory && state.historyCount < MINIMAL_MOUSE_HISTORY_SIZE)
+        state.history[state.historyCount++] = (MinimalMouseSample){ x, y };
+
+    actions.dirty = 1;
     return MINIMAL_OK;
 }
 
-uint8_t minimalKeycodeValid(MinimalKeycode keycode)
+uint8_t minimalProcessMouseRaw(int32_t dx, int32_t dy)
+{
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
+
+    if (!dx && !dy) return MINIMAL_FAIL;
+
+    state.rawX += dx;
+    state.rawY += dy;
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalKeycodeValid(MinimalKeycode keycode)
 {
     return keycode >= MINIMAL_KEY_FIRST && keycode <= MINIMAL_KEY_LAST;
 }
@@ -564,39 +1273,34 @@ uint8_t minimalMouseButtonValid(MinimalMouseButton button)
 
 uint8_t minimalKeyPressed(MinimalKeycode keycode)
 {
-    if (state.keys[keycode])
-    {
-        MINIMAL_INFO("State: %d", state.keys[keycode]);
-        MINIMAL_INFO("Prev:  %d", state.prev_keys[keycode]);
-    }
     if (!minimalKeycodeValid(keycode)) return 0;
-    return state.keys[keycode] && !state.prev_keys[keycode];
+    return MINIMAL_BIT_TEST(state.pressed_keys, keycode);
 }
 
 uint8_t minimalKeyReleased(MinimalKeycode keycode)
 {
     if (!minimalKeycodeValid(keycode)) return 0;
-    return state.prev_keys[keycode] && !state.keys[keycode];
+    return MINIMAL_BIT_TEST(state.released_keys, keycode);
 }
 
 uint8_t minimalKeyDown(MinimalKeycode keycode)
 {
     if (!minimalKeycodeValid(keycode)) return 0;
-    return state.keys[keycode];
+    return MINIMAL_BIT_TEST(state.keys, keycode);
 }
 
 uint8_t minimalKeyModActive(uint32_t keymod)
 {
     if (keymod == 0) return 1;
 
-    if ((keymod & MINIMAL_KEY_MOD_SHIFT) && !state.keys[MINIMAL_KEY_SHIFT])
+    if ((keymod & MINIMAL_KEY_MOD_SHIFT) && !MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_SHIFT))
         return 0;
-    if ((keymod & MINIMAL_KEY_MOD_CONTROL) && !state.keys[MINIMAL_KEY_CONTROL])
+    if ((keymod & MINIMAL_KEY_MOD_CONTROL) && !MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_CONTROL))
         return 0;
-    if ((keymod & MINIMAL_KEY_MOD_ALT) && !state.keys[MINIMAL_KEY_ALT])
+    if ((keymod & MINIMAL_KEY_MOD_ALT) && !MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_ALT))
         return 0;
     if ((keymod & MINIMAL_KEY_MOD_COMMAND) 
-        && !(state.keys[MINIMAL_KEY_LCOMMAND] || state.keys[MINIMAL_KEY_RCOMMAND]))
+        && !(MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_LCOMMAND) || MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_RCOMMAND)))
         return 0;
 
     return 1;
@@ -606,750 +1310,6183 @@ uint8_t minimalKeyModActive(uint32_t keymod)
 uint8_t minimalMousePressed(MinimalMouseButton button)
 {
     if (!minimalMouseButtonValid(button)) return 0;
-    return state.buttons[button] && !state.prev_buttons[button];
+    return (state.buttons & ~state.prev_buttons) >> button & 1;
 }
 
 uint8_t minimalMouseReleased(MinimalMouseButton button)
 {
     if (!minimalMouseButtonValid(button)) return 0;
-    return state.prev_buttons[button] && !state.buttons[button];
+    return (state.prev_buttons & ~state.buttons) >> button & 1;
 }
 
 uint8_t minimalMouseDown(MinimalMouseButton button)
 {
     if (!minimalMouseButtonValid(button)) return 0;
-    return state.buttons[button];
+    return state.buttons >> button & 1;
 }
 
-void minimalCursorPos(float* x, float* y)
+static uint32_t minimalReadKeyLog(uint8_t action, MinimalKeycode* keys, uint32_t max)
 {
-    if (x) *x = state.cursorX;
-    if (y) *y = state.cursorY;
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < state.keyLogCount && written < max; ++i)
+    {
+        if (state.keyLog[i].action == action)
+            keys[written++] = state.keyLog[i].code;
+    }
+    return written;
 }
 
-float minimalCursorX() { return state.cursorX; }
-float minimalCursorY() { return state.cursorY; }
-
-
-
-#define MINIMAL_LOWORD(dw) ((uint16_t)(dw))
-#define MINIMAL_HIWORD(dw) ((uint16_t)(((uint32_t)(dw)) >> 16))
+static uint32_t minimalReadButtonLog(uint8_t action, MinimalMouseButton* buttons, uint32_t max)
+{
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < state.buttonLogCount && written < max; ++i)
+    {
+        if (state.buttonLog[i].action == action)
+            buttons[written++] = (MinimalMouseButton)state.buttonLog[i].code;
+    }
+    return written;
+}
 
-struct MinimalEvent
+/* number of presses of the code in a log and the time of the first one */
+static uint32_t minimalCountPresses(const MinimalTransition* log, uint32_t count, int16_t code, uint64_t* time)
 {
-    uint32_t type;
-    union
+    uint32_t presses = 0;
+    for (uint32_t i = 0; i < count; ++i)
     {
-        struct
-        {
-            uint32_t uParam;
-            int32_t lParam;
-            int32_t rParam;
-        };
-        const void* external;
-    };
-};
+        if (log[i].code != code || log[i].action != MINIMAL_PRESS) continue;
 
-static struct
+        if (!presses && time) *time = log[i].time;
+        presses++;
+    }
+    return presses;
+}
+
+uint32_t minimalKeyPressCount(MinimalKeycode keycode)
 {
-    void* context;
-    MinimalEventCB callback;
-} event_handler;
+    return minimalCountPresses(state.keyLog, state.keyLogCount, keycode, NULL);
+}
 
-void minimalSetEventHandler(void* context, MinimalEventCB callback)
+uint8_t minimalKeyPressedAt(MinimalKeycode keycode, uint64_t* time)
 {
-    event_handler.context = context;
-    event_handler.callback = callback;
+    return minimalCountPresses(state.keyLog, state.keyLogCount, keycode, time) > 0;
 }
 
-void minimalDispatchEvent(uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
+uint32_t minimalMousePressCount(MinimalMouseButton button)
 {
-    MinimalEvent e = { .type = type, .uParam = uParam, .lParam = lParam, .rParam = rParam };
-    if (event_handler.callback) event_handler.callback(event_handler.context, &e);
+    return minimalCountPresses(state.buttonLog, state.buttonLogCount, button, NULL);
 }
 
-void minimalDispatchExternalEvent(uint32_t type, const void* data)
+uint8_t minimalMousePressedAt(MinimalMouseButton button, uint64_t* time)
 {
-    MinimalEvent e = { .type = type, .external = data };
-    if (event_handler.callback) event_handler.callback(event_handler.context, &e);
+    return minimalCountPresses(state.buttonLog, state.buttonLogCount, button, time) > 0;
 }
 
-uint8_t minimalEventIsType(const MinimalEvent* e, uint32_t type)  { return e->type == type; }
-uint8_t minimalEventIsExternal(const MinimalEvent* e)        { return e->type > MINIMAL_EVENT_LAST; }
+uint32_t minimalGetPressedKeys(MinimalKeycode* keys, uint32_t max)              { return minimalReadKeyLog(MINIMAL_PRESS, keys, max); }
+uint32_t minimalGetReleasedKeys(MinimalKeycode* keys, uint32_t max)             { return minimalReadKeyLog(MINIMAL_RELEASE, keys, max); }
+uint32_t minimalGetPressedButtons(MinimalMouseButton* buttons, uint32_t max)    { return minimalReadButtonLog(MINIMAL_PRESS, buttons, max); }
+uint32_t minimalGetReleasedButtons(MinimalMouseButton* buttons, uint32_t max)   { return minimalReadButtonLog(MINIMAL_RELEASE, buttons, max); }
 
-const void* minimalExternalEvent(const MinimalEvent* e)
+void minimalCursorPos(float* x, float* y)
 {
-    return minimalEventIsExternal(e) ? e->external : NULL;
+    if (x) *x = state.cursorX;
+    if (y) *y = state.cursorY;
 }
 
-uint8_t minimalEventWindowSize(const MinimalEvent* e, uint32_t* w, uint32_t* h)
-{
-    if (!minimalEventIsType(e, MINIMAL_EVENT_WINDOW_SIZE)) return 0;
+float minimalCursorX() { return state.cursorX; }
+float minimalCursorY() { return state.cursorY; }
 
-    if (w) *w = (uint32_t)e->lParam;
-    if (h) *h = (uint32_t)e->rParam;
+void minimalMouseDelta(float* dx, float* dy)
+{
+    if (dx) *dx = (float)state.rawX / MINIMAL_MOUSE_RAW_ONE;
+    if (dy) *dy = (float)state.rawY / MINIMAL_MOUSE_RAW_ONE;
+}
 
-    return 1;
+void minimalSetMouseHistory(uint8_t enable)
+{
+    state.recordHistory = enable;
+    state.historyCount = 0;
 }
 
-uint8_t minimalEventMouseButton(const MinimalEvent* e, MinimalMouseButton button, float* x, float* y)
+const MinimalMouseSample* minimalGetMouseHistory(uint32_t* count)
 {
-    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_BUTTON)) return 0;
+    if (count) *count = state.historyCount;
+    return state.history;
+}
 
-    if (button != (MinimalMouseButton)MINIMAL_HIWORD(e->uParam)) return 0;
+/* --------------------------| actions |--------------------------------- */
+/* the action is checked before it is narrowed to fit the binding */
+static uint8_t minimalAddBinding(uint8_t kind, uint32_t action, int16_t code, uint32_t keymod, float scale)
+{
+    if (action >= MINIMAL_ACTION_MAX || actions.count >= MINIMAL_ACTION_MAX_BINDINGS)
+    {
+        MINIMAL_ERROR("[Input] Failed to bind action %u", action);
+        return MINIMAL_FAIL;
+    }
 
-    if (x) *x = (float)e->lParam;
-    if (y) *y = (float)e->rParam;
+    actions.bindings[actions.count++] = (MinimalBinding){ kind, (uint8_t)action, code, keymod, scale };
+    return MINIMAL_OK;
+}
 
-    return 1;
+uint8_t minimalBindKey(uint32_t action, MinimalKeycode key, uint32_t keymod, float scale)
+{
+    if (!minimalKeycodeValid(key)) return MINIMAL_FAIL;
+    return minimalAddBinding(MINIMAL_BINDING_KEY, action, key, keymod, scale);
 }
 
-uint8_t minimalEventMouseButtonPressed(const MinimalEvent* e, MinimalMouseButton button, float* x, float* y)
+uint8_t minimalBindMouseButton(uint32_t action, MinimalMouseButton button, uint32_t keymod, float scale)
 {
-    return minimalEventMouseButton(e, button, x, y) && MINIMAL_LOWORD(e->uParam) == MINIMAL_PRESS;
+    if (!minimalMouseButtonValid(button)) return MINIMAL_FAIL;
+    return minimalAddBinding(MINIMAL_BINDING_BUTTON, action, button, keymod, scale);
 }
 
-uint8_t minimalEventMouseButtonReleased(const MinimalEvent* e, MinimalMouseButton button, float* x, float* y)
+uint8_t minimalBindMouseAxis(uint32_t action, MinimalMouseAxis axis, float scale)
 {
-    return minimalEventMouseButton(e, button, x, y) && MINIMAL_LOWORD(e->uParam) == MINIMAL_RELEASE;
+    if (axis != MINIMAL_MOUSE_AXIS_X && axis != MINIMAL_MOUSE_AXIS_Y) return MINIMAL_FAIL;
+    return minimalAddBinding(MINIMAL_BINDING_AXIS, action, (int16_t)axis, 0, scale);
 }
 
-uint16_t minimalEventMouseButtonAction(const MinimalEvent* e)
+void minimalClearBindings()
 {
-    return MINIMAL_LOWORD(e->uParam);
+    actions.count = 0;
 }
 
-uint8_t minimalEventMouseMoved(const MinimalEvent* e, float* x, float* y)
+void minimalCompileBindings()
 {
-    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_MOVED)) return 0;
+    uint32_t count = 0;
+    for (uint8_t kind = MINIMAL_BINDING_KEY; kind <= MINIMAL_BINDING_AXIS; ++kind)
+    {
+        uint32_t first = count;
+        for (uint32_t i = 0; i < actions.count; ++i)
+        {
+            if (actions.bindings[i].kind == kind)
+                actions.table[count++] = actions.bindings[i];
+        }
 
-    if (x) *x = (float)e->lParam;
-    if (y) *y = (float)e->rParam;
+        if (kind == MINIMAL_BINDING_KEY)    actions.keyCount = count - first;
+        if (kind == MINIMAL_BINDING_BUTTON) actions.buttonCount = count - first;
+        if (kind == MINIMAL_BINDING_AXIS)   actions.axisCount = count - first;
+    }
 
-    return 1;
+    actions.dirty = 1;
 }
 
-uint8_t minimalEventMouseScrolled(const MinimalEvent* e, float* xoffset, float* yoffset)
+static void minimalEvaluateActions()
 {
-    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
+    uint64_t down = 0;
+    MINIMAL_MEMSET(actions.values, 0, sizeof(actions.values));
 
-    if (xoffset) *xoffset = (float)e->lParam;
-    if (yoffset) *yoffset = (float)e->rParam;
+    const MinimalBinding* b = actions.table;
+    for (const MinimalBinding* end = b + actions.keyCount; b < end; ++b)
+    {
+        if (MINIMAL_BIT_TEST(state.keys, b->code) && minimalKeyModActive(b->keymod))
+        {
+            down |= (uint64_t)1 << b->action;
+            actions.values[b->action] += b->scale;
+        }
+    }
 
-    return 1;
+    for (const MinimalBinding* end = b + actions.buttonCount; b < end; ++b)
+    {
+        if ((state.buttons >> b->code & 1) && minimalKeyModActive(b->keymod))
+        {
+            down |= (uint64_t)1 << b->action;
+            actions.values[b->action] += b->scale;
+        }
+    }
+
+    // axes report the cursor movement since the start of the frame
+    for (const MinimalBinding* end = b + actions.axisCount; b < end; ++b)
+    {
+        float delta = b->code == MINIMAL_MOUSE_AXIS_X ? state.cursorX - state.frameCursorX : state.cursorY - state.frameCursorY;
+        if (delta != 0.0f)
+        {
+            down |= (uint64_t)1 << b->action;
+            actions.values[b->action] += delta * b->scale;
+        }
+    }
+
+    actions.down = down;
+    actions.dirty = 0;
 }
 
-MinimalKeycode minimalEventKey(const MinimalEvent* e)
+uint8_t minimalActionDown(uint32_t action)
 {
-    return (e->type == MINIMAL_EVENT_KEY) ? e->uParam : MINIMAL_KEY_UNKNOWN;
+    if (action >= MINIMAL_ACTION_MAX) return 0;
+    if (actions.dirty) minimalEvaluateActions();
+    return actions.down >> action & 1;
 }
 
-MinimalKeycode minimalEventKeyPressed(const MinimalEvent* e)
+uint8_t minimalActionPressed(uint32_t action)
 {
-    return (e->type == MINIMAL_EVENT_KEY && e->lParam == MINIMAL_PRESS) ? e->uParam : MINIMAL_KEY_UNKNOWN;
+    if (action >= MINIMAL_ACTION_MAX) return 0;
+    if (actions.dirty) minimalEvaluateActions();
+    return (actions.down & ~actions.prev) >> action & 1;
 }
 
-MinimalKeycode minimalEventKeyReleased(const MinimalEvent* e)
+uint8_t minimalActionReleased(uint32_t action)
 {
-    return (e->type == MINIMAL_EVENT_KEY && e->lParam == MINIMAL_RELEASE) ? e->uParam : MINIMAL_KEY_UNKNOWN;
+    if (action >= MINIMAL_ACTION_MAX) return 0;
+    if (actions.dirty) minimalEvaluateActions();
+    return (actions.prev & ~actions.down) >> action & 1;
 }
 
-char minimalEventChar(const MinimalEvent* e)
+float minimalActionValue(uint32_t action)
 {
-    return (e->type == MINIMAL_EVENT_CHAR) ? (char)e->uParam : '\0';
+    if (action >= MINIMAL_ACTION_MAX) return 0.0f;
+    if (actions.dirty) minimalEvaluateActions();
+    return actions.values[action];
 }
 
 
 
-#ifdef MINIMAL_PLATFORM_WINDOWS
+#define MINIMAL_LOWORD(dw) ((uint16_t)(dw))
+#define MINIMAL_HIWORD(dw) ((uint16_t)(((uint32_t)(dw)) >> 16))
 
-#ifndef WIN32_LEAN_AND_MEAN
-    #define WIN32_LEAN_AND_MEAN
+#if (MINIMAL_EVENT_QUEUE_SIZE & (MINIMAL_EVENT_QUEUE_SIZE - 1)) != 0
+#error "MINIMAL_EVENT_QUEUE_SIZE must be a power of two"
 #endif
-#include <windows.h>
 
-#define MINIMAL_WNDCLASSNAME L"MINIMALWNDCLASS"
-
-static uint64_t _minimalTimerFrequency = 0;
-static uint64_t _minimalTimerOffset = 0;
+#if (MINIMAL_POST_QUEUE_SIZE & (MINIMAL_POST_QUEUE_SIZE - 1)) != 0
+#error "MINIMAL_POST_QUEUE_SIZE must be a power of two"
+#endif
 
-static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+#if MINIMAL_EVENT_LAST >= 32
+#error "builtin event types have to fit into the event mask"
+#endif
 
-#ifndef MINIMAL_NO_CONTEXT
+#if (MINIMAL_EVENT_ARENA_SIZE % 8) != 0
+#error "MINIMAL_EVENT_ARENA_SIZE must be a multiple of 8"
+#endif
 
-static uint8_t minimalWGLInit();
-static void minimalWGLTerminate();
-static HGLRC minimalCreateRenderContext(HDC dc);
+#ifdef _MSC_VER
+#include <intrin.h>
 
+#define MINIMAL_ATOMIC_LOAD(p)              ((uint32_t)_InterlockedOr((volatile long*)(p), 0))
+#define MINIMAL_ATOMIC_STORE(p, v)          _InterlockedExchange((volatile long*)(p), (long)(v))
+#define MINIMAL_ATOMIC_CAS(p, expected, v)  (_InterlockedCompareExchange((volatile long*)(p), (long)(v), (long)(expected)) == (long)(expected))
+#define MINIMAL_ATOMIC_INCREMENT(p)         _InterlockedIncrement((volatile long*)(p))
+#else
+#define MINIMAL_ATOMIC_LOAD(p)              __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define MINIMAL_ATOMIC_STORE(p, v)          __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define MINIMAL_ATOMIC_CAS(p, expected, v)  __atomic_compare_exchange_n(p, &(uint32_t){ expected }, v, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define MINIMAL_ATOMIC_INCREMENT(p)         __atomic_fetch_add(p, 1, __ATOMIC_RELAXED)
 #endif
 
-uint8_t minimalPlatformInit()
+static struct
 {
-    // register window class
-    WNDCLASSEXW wndClass = {
-        .cbSize         = sizeof(WNDCLASSEXW),
-        .hInstance      = GetModuleHandleW(NULL),
-        .lpfnWndProc    = minimalWindowProc,
-        .style          = CS_HREDRAW | CS_VREDRAW | CS_OWNDC,
-        .lpszClassName  = MINIMAL_WNDCLASSNAME,
-        .lpszMenuName   = NULL,
-        .hIcon          = LoadIconW(NULL, IDI_APPLICATION),
-        .hIconSm        = LoadIconW(NULL, IDI_APPLICATION),
-        .hCursor        = LoadCursorW(NULL, IDC_ARROW)
-    };
+    void* context;
+    MinimalEventCB callback;
+} event_handler;
 
-    if (!RegisterClassExW(&wndClass))
-    {
-        MINIMAL_ERROR("[Platform] Failed to register WindowClass");
-        return FALSE;
-    }
+/* times are kept in ticks and converted when read */
+static struct
+{
+    MinimalEventStats counters;
+    uint64_t pollTicks;
+    uint64_t handlerTicks;
+    uint32_t handlerDepth;
+} event_stats;
 
-    // init time
-    if (!QueryPerformanceFrequency((LARGE_INTEGER*)&_minimalTimerFrequency))
-    {
-        MINIMAL_ERROR("[Platform] High-resolution performance counter is not supported");
-        return MINIMAL_FAIL;
-    }
+/* events of one poll collected for the batch handler, sorted by arrival */
+static struct
+{
+    void* context;
+    MinimalEventBatchCB callback;
+    MinimalEvent events[MINIMAL_EVENT_QUEUE_SIZE];
+    uint32_t count;
+    uint32_t delivering;
+} event_batch;
 
-    QueryPerformanceCounter((LARGE_INTEGER*)&_minimalTimerOffset);
+/* external events share the slot past the last builtin type, their subscribers are told apart by type */
+#define MINIMAL_EVENT_SLOT(type)    ((type) > MINIMAL_EVENT_LAST ? MINIMAL_EVENT_LAST + 1 : (type))
+#define MINIMAL_EVENT_SLOT_COUNT    (MINIMAL_EVENT_LAST + 2)
 
-#ifndef MINIMAL_NO_CONTEXT
-    // init wgl
-    if (!minimalWGLInit())
-    {
-        MINIMAL_ERROR("[Platform] Failed to initialize WGL");
-        return MINIMAL_FAIL;
-    }
-#endif
+typedef struct
+{
+    uint32_t type;
+    void* context;
+    MinimalEventCB callback;
+    int32_t priority;
+} MinimalEventSubscriber;
 
-    return MINIMAL_OK;
-}
+/*
+ * Each slot is kept sorted by descending priority. While events are delivered
+ * the slots are not reordered: removed subscribers only lose their callback and
+ * new ones wait in pending. Both are applied once the outermost delivery returns
+ * so running loops keep their position.
+ */
+static struct
+{
+    MinimalEventSubscriber entries[MINIMAL_EVENT_SLOT_COUNT][MINIMAL_EVENT_MAX_SUBSCRIBERS];
+    uint32_t count[MINIMAL_EVENT_SLOT_COUNT];
+    MinimalEventSubscriber pending[MINIMAL_EVENT_MAX_SUBSCRIBERS];
+    uint32_t pendingCount;
+    uint32_t delivering;
+    uint8_t removed;
+} event_subscribers;
+
+/* single producer (the platform pump) and single consumer (the app) on one thread */
+static struct
+{
+    MinimalEvent events[MINIMAL_EVENT_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+    MinimalEventMode mode;
+} event_queue;
 
-uint8_t minimalPlatformTerminate()
+/*
+ * Bounded multi producer, single consumer queue for events posted from other
+ * threads. Each cell carries a sequence number telling producers and the
+ * consumer whose turn it is. Sequences are stored relative to the cell index,
+ * which makes the zeroed static storage a valid empty queue.
+ */
+typedef struct
 {
-#ifndef MINIMAL_NO_CONTEXT
-    minimalWGLTerminate();
-#endif
+    uint32_t sequence;
+    uint32_t type;
+    uint32_t size;
+    uint64_t data[MINIMAL_POST_EVENT_SIZE / sizeof(uint64_t)];
+} MinimalPostedEvent;
 
-    // unregister window class
-    if (!UnregisterClassW(MINIMAL_WNDCLASSNAME, GetModuleHandleW(NULL)))
-    {
-        MINIMAL_ERROR("[Platform] Failed to unregister WindowClass");
-        return MINIMAL_FAIL;
-    }
-    return MINIMAL_OK;
-}
+static struct
+{
+    MinimalPostedEvent cells[MINIMAL_POST_QUEUE_SIZE];
+    uint32_t enqueue;
+    uint32_t dequeue;
+    uint32_t dropped;
+} post_queue;
 
-static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+static void minimalDispatchExternalEventSized(uint32_t type, const void* data, size_t size);
 
-void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
-{
-    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
-        windowHints[name] = value;
-}
+#define MINIMAL_POST_LAP(pos)   ((pos) & ~(uint32_t)(MINIMAL_POST_QUEUE_SIZE - 1))
 
-struct MinimalWindow
+/* bump allocator for copied payloads, reset as a whole once per frame */
+static struct
 {
-    HWND handle;
+    uint64_t memory[MINIMAL_EVENT_ARENA_SIZE / sizeof(uint64_t)];
+    size_t offset;
+} event_arena;
 
-#ifndef MINIMAL_NO_CONTEXT
-    HDC         deviceContext;
-    HGLRC       renderContext;
-#endif
+/* NULL if the arena is full, every allocation stays 8 byte aligned */
+static void* minimalEventArenaAlloc(size_t size)
+{
+    size_t aligned = (size + 7) & ~(size_t)7;
+    if (aligned > MINIMAL_EVENT_ARENA_SIZE - event_arena.offset) return NULL;
 
-    uint8_t shouldClose;
-};
+    void* memory = (uint8_t*)event_arena.memory + event_arena.offset;
+    event_arena.offset += aligned;
+    return memory;
+}
 
-MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+static struct
 {
-    MinimalWindow* window = malloc(sizeof(MinimalWindow));
-    if (!window) return NULL;
+    uint64_t time;
+    uint32_t seq;
 
-    // create window
-    HINSTANCE instance = GetModuleHandleW(NULL);
+    // os clock extended past its 32 bit wrap and its estimated offset to ours
+    int64_t source;
+    uint32_t last;
+    int64_t offset;
+    uint8_t synced;
+} event_clock;
 
-    RECT rect = { 0 };
-    DWORD style = WS_OVERLAPPEDWINDOW | WS_VISIBLE;
-    DWORD styleEx = WS_EX_APPWINDOW;
-    AdjustWindowRectEx(&rect, style, 0, styleEx);
+/* merged motion and resize events, in callback mode the last one is held back until the next flush */
+static struct
+{
+    uint8_t enabled;
+    uint8_t hasPending;
+    MinimalEvent pending;
+} event_coalesce;
 
-    x += rect.left;
-    y += rect.top;
-    w += rect.right - rect.left;
-    h += rect.bottom - rect.top;
+/* set while live input is drained without effect */
+static uint8_t event_discard;
 
-    window->handle = CreateWindowExW(styleEx, MINIMAL_WNDCLASSNAME, NULL, style, x, y, w, h, 0, 0, instance, 0);
-    if (!window->handle)
-    {
-        MINIMAL_ERROR("[Platform] Failed to create window");
-        minimalDestroyWindow(window);
-        return NULL;
-    }
+/* last motion event, deltas are only measured between moves in the same window */
+static struct
+{
+    MinimalWindow* window;
+    int32_t x, y;
+    uint8_t tracking;
+} event_cursor;
 
-    minimalSetWindowTitle(window, title);
-
-    window->shouldClose = 0;
+void minimalSetEventHandler(void* context, MinimalEventCB callback)
+{
+    event_handler.context = context;
+    event_handler.callback = callback;
+}
 
-#ifndef MINIMAL_NO_CONTEXT
+/* behind all subscribers with the same or a higher priority */
+static void minimalInsertSubscriber(MinimalEventSubscriber subscriber)
+{
+    uint32_t slot = MINIMAL_EVENT_SLOT(subscriber.type);
+    MinimalEventSubscriber* entries = event_subscribers.entries[slot];
 
-    window->deviceContext = GetDC(window->handle);
-    window->renderContext = minimalCreateRenderContext(window->deviceContext);
-    if (!window->renderContext)
+    uint32_t index = event_subscribers.count[slot];
+    while (index > 0 && entries[index - 1].priority < subscriber.priority)
     {
-        minimalDestroyWindow(window);
-        return NULL;
+        entries[index] = entries[index - 1];
+        index--;
     }
 
-#endif
-
-    return window;
+    entries[index] = subscriber;
+    event_subscribers.count[slot]++;
 }
 
-void minimalDestroyWindow(MinimalWindow* window)
+uint8_t minimalSubscribeEvent(uint32_t type, int32_t priority, void* context, MinimalEventCB callback)
 {
-#ifndef MINIMAL_NO_CONTEXT
+    uint32_t slot = MINIMAL_EVENT_SLOT(type);
+    const MinimalEventSubscriber* entries = event_subscribers.entries[slot];
 
-    // destroy render context
-    if (window->renderContext)
+    // removed and pending subscribers are only counted once the slot is compacted
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < event_subscribers.count[slot]; ++i)
     {
-        if (!wglMakeCurrent(NULL, NULL))
-        {
-            MINIMAL_ERROR("[WGL] Failed to realease render context");
-        }
+        if (entries[i].callback) count++;
+    }
 
-        if (!wglDeleteContext(window->renderContext))
-        {
-            MINIMAL_ERROR("[WGL] Failed to delete render context");
-        }
+    for (uint32_t i = 0; i < event_subscribers.pendingCount; ++i)
+    {
+        if (MINIMAL_EVENT_SLOT(event_subscribers.pending[i].type) == slot) count++;
     }
 
-    // destroy device context
-    if (window->deviceContext && !ReleaseDC(window->handle, window->deviceContext))
+    if (count >= MINIMAL_EVENT_MAX_SUBSCRIBERS)
     {
-        MINIMAL_ERROR("[Platform] Failed to release device context");
+        MINIMAL_ERROR("[Event] Too many subscribers for event type %u", type);
+        return MINIMAL_FAIL;
     }
 
-#endif
+    MinimalEventSubscriber subscriber = { .type = type, .context = context, .callback = callback, .priority = priority };
+    if (!event_subscribers.delivering)
+    {
+        minimalInsertSubscriber(subscriber);
+        return MINIMAL_OK;
+    }
 
-    // destroy window
-    if (window->handle && !DestroyWindow(window->handle))
+    // the running delivery does not see it, it is added once delivery returns
+    if (event_subscribers.pendingCount >= MINIMAL_EVENT_MAX_SUBSCRIBERS)
     {
-        MINIMAL_ERROR("[Platform] Failed to destroy window");
+        MINIMAL_ERROR("[Event] Too many subscribers added during delivery");
+        return MINIMAL_FAIL;
     }
 
-    free(window);
+    event_subscribers.pending[event_subscribers.pendingCount++] = subscriber;
+    return MINIMAL_OK;
 }
 
-void minimalPollWindowEvents(MinimalWindow* context)
+void minimalUnsubscribeEvent(uint32_t type, void* context, MinimalEventCB callback)
 {
-    MSG msg;
-    while (PeekMessageW(&msg, context->handle, 0, 0, PM_REMOVE))
+    uint32_t slot = MINIMAL_EVENT_SLOT(type);
+    MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+    for (uint32_t i = 0; i < event_subscribers.count[slot]; ++i)
     {
-        TranslateMessage(&msg);
-        DispatchMessageW(&msg);
+        if (entries[i].type == type && entries[i].context == context && entries[i].callback == callback)
+        {
+            if (event_subscribers.delivering)
+            {
+                entries[i].callback = NULL;
+                event_subscribers.removed = 1;
+                return;
+            }
+
+            event_subscribers.count[slot]--;
+            MINIMAL_MEMMOVE(&entries[i], &entries[i + 1], (event_subscribers.count[slot] - i) * sizeof(MinimalEventSubscriber));
+            return;
+        }
     }
-}
 
-void minimalSetWindowTitle(MinimalWindow* context, const char* title)
-{
-    SetWindowTextA(context->handle, title);
+    // pending subscribers are not iterated by any delivery
+    MinimalEventSubscriber* pending = event_subscribers.pending;
+    for (uint32_t i = 0; i < event_subscribers.pendingCount; ++i)
+    {
+        if (pending[i].type == type && pending[i].context == context && pending[i].callback == callback)
+        {
+            event_subscribers.pendingCount--;
+            MINIMAL_MEMMOVE(&pending[i], &pending[i + 1], (event_subscribers.pendingCount - i) * sizeof(MinimalEventSubscriber));
+            return;
+        }
+    }
 }
 
+/* drops the subscribers removed and adds the ones subscribed during delivery */
+static void minimalCompactSubscribers()
+{
+    for (uint32_t slot = 0; slot < MINIMAL_EVENT_SLOT_COUNT; ++slot)
+    {
+        MinimalEventSubscriber* entries = event_subscribers.entries[slot];
 
-uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
-void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
-
-void minimalMaximize(MinimalWindow* window) { ShowWindow(window->handle, SW_SHOWMAXIMIZED); }
-void minimalMinimize(MinimalWindow* window) { ShowWindow(window->handle, SW_MINIMIZE); }
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < event_subscribers.count[slot]; ++i)
+        {
+            if (entries[i].callback) entries[count++] = entries[i];
+        }
+        event_subscribers.count[slot] = count;
+    }
 
-double minimalGetTime()
-{
-    uint64_t value;
-    QueryPerformanceCounter((LARGE_INTEGER*)&value);
+    for (uint32_t i = 0; i < event_subscribers.pendingCount; ++i)
+        minimalInsertSubscriber(event_subscribers.pending[i]);
 
-    return (double)(value - _minimalTimerOffset) / _minimalTimerFrequency;
+    event_subscribers.pendingCount = 0;
+    event_subscribers.removed = 0;
 }
 
-void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+void minimalSetEventBatchHandler(void* context, MinimalEventBatchCB callback)
 {
-    RECT rect;
-    if (GetClientRect(context->handle, &rect))
-    {
-        if (w) *w = rect.right - rect.left;
-        if (h) *h = rect.bottom - rect.top;
-    }
+    minimalFlushEvents();
+    event_batch.context = context;
+    event_batch.callback = callback;
 }
 
-void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+void minimalSetEventMode(MinimalEventMode mode)
 {
-    const HDC dc = GetDC(NULL);
-    UINT xdpi = GetDeviceCaps(dc, LOGPIXELSX);
-    UINT ydpi = GetDeviceCaps(dc, LOGPIXELSY);
-    ReleaseDC(NULL, dc);
-
-    if (xscale) *xscale = xdpi / (float)USER_DEFAULT_SCREEN_DPI;
-    if (yscale) *yscale = ydpi / (float)USER_DEFAULT_SCREEN_DPI;
+    minimalFlushEvents();
+    event_queue.mode = mode;
 }
 
-void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+void minimalSetEventCoalescing(uint8_t enable)
 {
-    return window->handle;
+    minimalFlushEvents();
+    event_coalesce.enabled = enable;
 }
 
-
-static uint32_t minimalGetKeyMods()
+static int16_t minimalClampDelta(int32_t value)
 {
-    uint32_t mods = 0;
-    if (GetKeyState(VK_SHIFT) & 0x8000)                         mods |= MINIMAL_KEY_MOD_SHIFT;
-    if (GetKeyState(VK_CONTROL) & 0x8000)                       mods |= MINIMAL_KEY_MOD_CONTROL;
-    if (GetKeyState(VK_MENU) & 0x8000)                          mods |= MINIMAL_KEY_MOD_ALT;
-    if ((GetKeyState(VK_LWIN) | GetKeyState(VK_RWIN)) & 0x8000) mods |= MINIMAL_KEY_MOD_COMMAND;
-    if (GetKeyState(VK_CAPITAL) & 1)                            mods |= MINIMAL_KEY_MOD_CAPS_LOCK;
-    if (GetKeyState(VK_NUMLOCK) & 1)                            mods |= MINIMAL_KEY_MOD_NUM_LOCK;
-    return mods;
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return (int16_t)value;
 }
 
-static uint32_t minimalGetMouseButton(UINT msg, WPARAM wParam)
+static uint32_t minimalPackDelta(int32_t dx, int32_t dy)
 {
-    if (msg == WM_LBUTTONDOWN || msg == WM_LBUTTONUP)   return MINIMAL_MOUSE_BUTTON_LEFT;
-    if (msg == WM_RBUTTONDOWN || msg == WM_RBUTTONUP)   return MINIMAL_MOUSE_BUTTON_RIGHT;
-    if (msg == WM_MBUTTONDOWN || msg == WM_MBUTTONUP)   return MINIMAL_MOUSE_BUTTON_MIDDLE;
-    if (GET_XBUTTON_WPARAM(wParam) == XBUTTON1)         return MINIMAL_MOUSE_BUTTON_4;
-    else                                                return MINIMAL_MOUSE_BUTTON_5;
+    return (uint16_t)minimalClampDelta(dx) | ((uint32_t)(uint16_t)minimalClampDelta(dy) << 16);
 }
 
-#define MINIMAL_GET_X_LPARAM(lp)    ((int32_t)(int16_t)LOWORD(lp))
-#define MINIMAL_GET_Y_LPARAM(lp)    ((int32_t)(int16_t)HIWORD(lp))
-
-#define MINIMAL_GET_SCROLL(wp)      ((int32_t)((int16_t)HIWORD(wp) / (float)WHEEL_DELTA))
-
-static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+/* folds e into dst if both are motion or resize events of the same window */
+static uint8_t minimalCoalesceEvent(MinimalEvent* dst, const MinimalEvent* e)
 {
-    MinimalWindow* context = minimalGetCurrentContext();
+    if (dst->type != e->type || dst->window != e->window) return 0;
 
-    if (!context) return DefWindowProcW(hwnd, msg, wParam, lParam);
-
-    switch (msg)
+    if (e->type == MINIMAL_EVENT_MOUSE_MOVED)
     {
-    case WM_DESTROY:
-        PostQuitMessage(0);
-        return 0;
-    case WM_QUIT:
-    case WM_CLOSE:
-        minimalClose(context);
-        return 0;
-    case WM_CHAR:
-    case WM_SYSCHAR:
-    case WM_UNICHAR:
+        int32_t dx = (int16_t)MINIMAL_LOWORD(dst->uParam) + (int16_t)MINIMAL_LOWORD(e->uParam);
+        int32_t dy = (int16_t)MINIMAL_HIWORD(dst->uParam) + (int16_t)MINIMAL_HIWORD(e->uParam);
+        dst->uParam = minimalPackDelta(dx, dy);
+    }
+    else if (e->type == MINIMAL_EVENT_WINDOW_SIZE)
     {
-        uint32_t codepoint = (uint32_t)wParam;
-        uint32_t mods = minimalGetKeyMods();
-
-        if (codepoint > 31)
-            minimalDispatchEvent(MINIMAL_EVENT_CHAR, codepoint, 0, mods);
-
-        return 0;
+        dst->uParam = e->uParam;
     }
-    case WM_KEYDOWN:
-    case WM_SYSKEYDOWN:
-    case WM_KEYUP:
-    case WM_SYSKEYUP:
+    else if (e->type != MINIMAL_EVENT_MOUSE_RAW)
     {
-        uint8_t action = (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN);
-        uint32_t keycode = (uint16_t)wParam;
-        uint32_t mods = minimalGetKeyMods();
-
-        if (minimalProcessKey(keycode, action))
-            minimalDispatchEvent(MINIMAL_EVENT_KEY, keycode, action, mods);
-
         return 0;
     }
-    case WM_LBUTTONDOWN:
-    case WM_RBUTTONDOWN:
-    case WM_MBUTTONDOWN:
-    case WM_XBUTTONDOWN:
-    case WM_LBUTTONUP:
-    case WM_RBUTTONUP:
-    case WM_MBUTTONUP:
-    case WM_XBUTTONUP:
-    {
-        uint32_t action = msg == WM_LBUTTONDOWN
-                        || msg == WM_RBUTTONDOWN
-                        || msg == WM_MBUTTONDOWN
-                        || msg == WM_XBUTTONDOWN;
-
-        uint16_t button = minimalGetMouseButton(msg, wParam);
-        int32_t x = MINIMAL_GET_X_LPARAM(lParam);
-        int32_t y = MINIMAL_GET_Y_LPARAM(lParam);
 
-        if (minimalProcessMouseButton(button, action))
-            minimalDispatchEvent(MINIMAL_EVENT_MOUSE_BUTTON, (button << 16) + action, x, y);
+    event_stats.counters.coalesced++;
 
-        return msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP;
-    }
-    case WM_MOUSEMOVE:
+    // the merged event describes the newest state, raw motion has no state and adds up instead
+    dst->seq = e->seq;
+    dst->time = e->time;
+    if (e->type == MINIMAL_EVENT_MOUSE_RAW)
     {
-        int32_t x = MINIMAL_GET_X_LPARAM(lParam);
-        int32_t y = MINIMAL_GET_Y_LPARAM(lParam);
-
-        if (minimalProcessMouseMove((float)x, (float)y))
-            minimalDispatchEvent(MINIMAL_EVENT_MOUSE_MOVED, 0, x, y);
-        return 0;
+        dst->lParam += e->lParam;
+        dst->rParam += e->rParam;
     }
-    case WM_MOUSEWHEEL:
+    else
     {
-        int32_t scroll = MINIMAL_GET_SCROLL(wParam);
-
-        minimalDispatchEvent(MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, scroll);
-        return 0;
+        dst->lParam = e->lParam;
+        dst->rParam = e->rParam;
     }
-    case WM_MOUSEHWHEEL:
-    {
-        int32_t scroll = MINIMAL_GET_SCROLL(wParam);
+    return 1;
+}
 
-        minimalDispatchEvent(MINIMAL_EVENT_MOUSE_SCROLLED, 0, scroll, 0);
-        return 0;
+uint8_t minimalPostExternalEvent(uint32_t type, const void* data, size_t size)
+{
+    if (type <= MINIMAL_EVENT_LAST || size > MINIMAL_POST_EVENT_SIZE)
+    {
+        MINIMAL_ERROR("[Event] Posted events need an external type and at most %d bytes", MINIMAL_POST_EVENT_SIZE);
+        return MINIMAL_FAIL;
     }
-    case WM_SIZE:
+
+    MinimalPostedEvent* cell;
+    uint32_t pos = MINIMAL_ATOMIC_LOAD(&post_queue.enqueue);
+    for (;;)
     {
-        /*
-        uint8_t minimized = wParam == SIZE_MINIMIZED;
-        uint8_t maximized = wParam == SIZE_MAXIMIZED || (_current_context->maximized && wParam != SIZE_RESTORED);
+        cell = &post_queue.cells[pos & (MINIMAL_POST_QUEUE_SIZE - 1)];
+        int32_t diff = (int32_t)(MINIMAL_ATOMIC_LOAD(&cell->sequence) - MINIMAL_POST_LAP(pos));
 
-        if (_current_context->minimized != minimized)
+        if (diff == 0)
         {
-            _current_context->minimized = minimized;
-            minimalDispatchEvent(event_handler, MINIMAL_EVENT_WINDOW_MINIMIZE, minimized, 0, 0);
+            // the cell is free, claim it unless another producer was faster
+            if (MINIMAL_ATOMIC_CAS(&post_queue.enqueue, pos, pos + 1)) break;
+            pos = MINIMAL_ATOMIC_LOAD(&post_queue.enqueue);
         }
-
-        if (_current_context->maximized != maximized)
+        else if (diff < 0)
         {
-            _current_context->maximized = maximized;
-            minimalDispatchEvent(event_handler, MINIMAL_EVENT_WINDOW_MAXIMIZE, maximized, 0, 0);
+            // the consumer has not released the cell of the previous lap
+            MINIMAL_ATOMIC_INCREMENT(&post_queue.dropped);
+            return MINIMAL_FAIL;
         }
-        */
+        else
+        {
+            pos = MINIMAL_ATOMIC_LOAD(&post_queue.enqueue);
+        }
+    }
 
-        int32_t width  = LOWORD(lParam);
-        int32_t height = HIWORD(lParam);
+    cell->type = type;
+    cell->size = (uint32_t)size;
+    if (size) MINIMAL_MEMCPY(cell->data, data, size);
 
-        minimalDispatchEvent(MINIMAL_EVENT_WINDOW_SIZE, 0, width, height);
-        return 0;
-    }
-    default: return DefWindowProcW(hwnd, msg, wParam, lParam);
-    }
+    MINIMAL_ATOMIC_STORE(&cell->sequence, MINIMAL_POST_LAP(pos) + 1);
+    return MINIMAL_OK;
 }
 
-/* --------------------------| wgl |------------------------------------- */
-#ifndef MINIMAL_NO_CONTEXT
+void minimalDispatchPostedEvents()
+{
+    for (;;)
+    {
+        uint32_t pos = post_queue.dequeue;
+        MinimalPostedEvent* cell = &post_queue.cells[pos & (MINIMAL_POST_QUEUE_SIZE - 1)];
+        if (MINIMAL_ATOMIC_LOAD(&cell->sequence) != MINIMAL_POST_LAP(pos) + 1) break;
 
-/* Accepted as an attribute name in <*attribList> */
-#define WGL_CONTEXT_MAJOR_VERSION_ARB               0x2091
-#define WGL_CONTEXT_MINOR_VERSION_ARB               0x2092
-#define WGL_CONTEXT_FLAGS_ARB                       0x2094
-#define WGL_CONTEXT_PROFILE_MASK_ARB                0x9126
+        // the payload moves to the frame arena so the cell is free for producers right away
+        uint32_t type = cell->type;
+        uint32_t size = cell->size;
+        void* data = minimalEventArenaAlloc(size);
 
-/* Accepted as bits in the attribute value for WGL_CONTEXT_FLAGS in <*attribList> */
-#define WGL_CONTEXT_DEBUG_BIT_ARB                   0x0001
-#define WGL_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB      0x0002
+        // events not fitting into the arena stay queued until the next frame
+        if (!data) break;
 
-#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB            0x00000001
-#define WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB   0x00000002
+        if (size) MINIMAL_MEMCPY(data, cell->data, size);
 
-// See https://www.opengl.org/registry/specs/ARB/wgl_pixel_format.txt for all values
-#define WGL_DRAW_TO_WINDOW_ARB                      0x2001
-#define WGL_ACCELERATION_ARB                        0x2003
-#define WGL_SUPPORT_OPENGL_ARB                      0x2010
-#define WGL_DOUBLE_BUFFER_ARB                       0x2011
-#define WGL_PIXEL_TYPE_ARB                          0x2013
-#define WGL_COLOR_BITS_ARB                          0x2014
-#define WGL_DEPTH_BITS_ARB                          0x2022
-#define WGL_STENCIL_BITS_ARB                        0x2023
+        post_queue.dequeue++;
+        MINIMAL_ATOMIC_STORE(&cell->sequence, MINIMAL_POST_LAP(pos) + MINIMAL_POST_QUEUE_SIZE);
 
-#define WGL_FULL_ACCELERATION_ARB                   0x2027
-#define WGL_TYPE_RGBA_ARB                           0x202B
+        minimalDispatchExternalEventSized(type, data, size);
+    }
 
+    minimalFlushEvents();
+}
 
-// WGL extension pointer typedefs
-typedef BOOL(WINAPI* wglSwapIntervalEXT_T)(int);
-typedef BOOL(WINAPI* wglChoosePixelFormatARB_T)(HDC, const int*, const float*, UINT, int*, UINT*);
-typedef HGLRC(WINAPI* wglCreateContextAttribsARB_T)(HDC, HGLRC, const int*);
+uint32_t minimalGetDroppedPostedEventCount()
+{
+    return MINIMAL_ATOMIC_LOAD(&post_queue.dropped);
+}
 
-static wglCreateContextAttribsARB_T _wglCreateContextAttrARB = NULL;
-static wglSwapIntervalEXT_T         _wglSwapIntervalEXT = NULL;
-static wglChoosePixelFormatARB_T    _wglChoosePixelFormatARB = NULL;
+/* handlers dispatching events themselves are only timed once */
+static uint64_t minimalHandlerEnter()
+{
+    return event_stats.handlerDepth++ ? 0 : minimalGetTicks();
+}
 
-static HMODULE glModule = NULL;
+static void minimalHandlerLeave(uint64_t start)
+{
+    if (--event_stats.handlerDepth == 0)
+        event_stats.handlerTicks += minimalGetTicks() - start;
+}
 
-uint8_t minimalWGLInit()
+static void minimalDeliverEvent(const MinimalEvent* e)
 {
-    // load opengl library
-    glModule = LoadLibraryA("opengl32.dll");
-    if (!glModule)
+    uint32_t slot = MINIMAL_EVENT_SLOT(e->type);
+    const MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+    uint64_t start = minimalHandlerEnter();
+    event_subscribers.delivering++;
+
+    // a nonzero return consumes the event
+    uint8_t consumed = 0;
+    for (uint32_t i = 0; i < event_subscribers.count[slot] && !consumed; ++i)
     {
-        MINIMAL_ERROR("[WGL] Failed to load opengl32.dll");
-        return MINIMAL_FAIL;
+        if (entries[i].type == e->type && entries[i].callback)
+            consumed = entries[i].callback(entries[i].context, e);
     }
 
-    // create helper window
-    HINSTANCE instance = GetModuleHandleW(NULL);
-    LPCWSTR className = MINIMAL_WNDCLASSNAME;
-    DWORD exStyle = WS_EX_OVERLAPPEDWINDOW;
+    if (!consumed && event_handler.callback) event_handler.callback(event_handler.context, e);
+
+    if (--event_subscribers.delivering == 0 && (event_subscribers.removed || event_subscribers.pendingCount))
+        minimalCompactSubscribers();
+
+    minimalHandlerLeave(start);
+}
+
+static void minimalDeliverPending()
+{
+    if (!event_coalesce.hasPending) return;
+
+    event_coalesce.hasPending = 0;
+    minimalDeliverEvent(&event_coalesce.pending);
+}
+
+static void minimalDeliverBatch()
+{
+    if (!event_batch.count || event_batch.delivering) return;
+
+    // events dispatched by the batch handler itself are appended behind the span it reads
+    uint32_t count = event_batch.count;
+    event_batch.delivering = count;
+
+    uint64_t start = minimalHandlerEnter();
+    event_batch.callback(event_batch.context, event_batch.events, count);
+    minimalHandlerLeave(start);
+
+    event_batch.delivering = 0;
+
+    event_batch.count -= count;
+    MINIMAL_MEMMOVE(event_batch.events, event_batch.events + count, event_batch.count * sizeof(MinimalEvent));
+}
+
+static void minimalBatchEvent(const MinimalEvent* e)
+{
+    if (event_coalesce.enabled && event_batch.count > event_batch.delivering
+        && minimalCoalesceEvent(&event_batch.events[event_batch.count - 1], e))
+        return;
+
+    if (event_batch.count == MINIMAL_EVENT_QUEUE_SIZE)
+    {
+        // a full batch goes out early, unless it is being read right now
+        if (event_batch.delivering)
+        {
+            event_queue.dropped++;
+            event_stats.counters.dropped++;
+            return;
+        }
+        minimalDeliverBatch();
+    }
+
+    event_batch.events[event_batch.count++] = *e;
+
+    if (event_batch.count > event_stats.counters.highWater)
+        event_stats.counters.highWater = event_batch.count;
+}
+
+void minimalFlushEvents()
+{
+    minimalDeliverPending();
+
+    if (event_batch.callback) minimalDeliverBatch();
+}
+
+static void minimalPushEvent(const MinimalEvent* e)
+{
+    if (event_queue.mode == MINIMAL_EVENT_MODE_CALLBACK && event_batch.callback)
+    {
+        minimalBatchEvent(e);
+        return;
+    }
+
+    if (event_queue.mode == MINIMAL_EVENT_MODE_CALLBACK)
+    {
+        if (!event_coalesce.enabled)
+        {
+            minimalDeliverEvent(e);
+            return;
+        }
+
+        if (event_coalesce.hasPending && minimalCoalesceEvent(&event_coalesce.pending, e))
+            return;
+
+        // anything else delivers the held event first to keep the order intact
+        minimalDeliverPending();
+
+        if (e->type == MINIMAL_EVENT_MOUSE_MOVED || e->type == MINIMAL_EVENT_MOUSE_RAW || e->type == MINIMAL_EVENT_WINDOW_SIZE)
+        {
+            event_coalesce.pending = *e;
+            event_coalesce.hasPending = 1;
+            return;
+        }
+
+        minimalDeliverEvent(e);
+        return;
+    }
+
+    // only events not pulled yet can absorb newer ones
+    if (event_coalesce.enabled && event_queue.tail != event_queue.head)
+    {
+        MinimalEvent* last = &event_queue.events[(event_queue.tail - 1) & (MINIMAL_EVENT_QUEUE_SIZE - 1)];
+        if (minimalCoalesceEvent(last, e)) return;
+    }
+
+    // head and tail run freely, their difference is the fill level
+    if (event_queue.tail - event_queue.head >= MINIMAL_EVENT_QUEUE_SIZE)
+    {
+        event_queue.dropped++;
+        event_stats.counters.dropped++;
+        return;
+    }
+
+    event_queue.events[event_queue.tail++ & (MINIMAL_EVENT_QUEUE_SIZE - 1)] = *e;
+
+    if (event_queue.tail - event_queue.head > event_stats.counters.highWater)
+        event_stats.counters.highWater = event_queue.tail - event_queue.head;
+}
+
+void minimalDiscardEvents(uint8_t discard)
+{
+    event_discard = discard;
+}
+
+uint8_t minimalEventsDiscarded()
+{
+    return event_discard;
+}
+
+void minimalResetMouseDelta(MinimalWindow* window)
+{
+    if (event_cursor.window == window) event_cursor.tracking = 0;
+}
+
+uint8_t minimalPollEvent(MinimalEvent* e)
+{
+    if (event_queue.head == event_queue.tail) return 0;
+
+    *e = event_queue.events[event_queue.head++ & (MINIMAL_EVENT_QUEUE_SIZE - 1)];
+    return 1;
+}
+
+uint32_t minimalGetDroppedEventCount()
+{
+    return event_queue.dropped;
+}
+
+void minimalAddEventPollTime(uint64_t ticks)
+{
+    event_stats.pollTicks += ticks;
+}
+
+void minimalGetEventStats(MinimalEventStats* stats)
+{
+    *stats = event_stats.counters;
+    stats->pollTime = minimalTicksToNs(event_stats.pollTicks);
+    stats->handlerTime = minimalTicksToNs(event_stats.handlerTicks);
+}
+
+void minimalResetEventStats()
+{
+    MINIMAL_MEMSET(&event_stats.counters, 0, sizeof(event_stats.counters));
+    event_stats.pollTicks = 0;
+    event_stats.handlerTicks = 0;
+}
+
+void minimalSetEventTime(uint64_t ns)
+{
+    event_clock.time = ns;
+}
+
+uint64_t minimalRebaseEventTime(uint32_t ms)
+{
+    uint64_t now = minimalGetTimeNs();
+
+    event_clock.source = event_clock.synced ? event_clock.source + (int32_t)(ms - event_clock.last) : ms;
+    event_clock.last = ms;
+
+    // input is never seen before it happens, so the smallest distance between both clocks is the best guess for their offset
+    int64_t source = event_clock.source * 1000000;
+    int64_t offset = (int64_t)now - source;
+    if (!event_clock.synced || offset < event_clock.offset)
+        event_clock.offset = offset;
+    event_clock.synced = 1;
+
+    // input from before our clock started is clamped to its start
+    int64_t time = source + event_clock.offset;
+    return time > 0 ? (uint64_t)time : 0;
+}
+
+uint64_t minimalGetEventTime()
+{
+    return event_clock.time ? event_clock.time : minimalGetTimeNs();
+}
+
+static void minimalStampEvent(MinimalEvent* e)
+{
+    e->time = minimalGetEventTime();
+    e->seq = ++event_clock.seq;
+
+    event_stats.counters.dispatched[MINIMAL_EVENT_SLOT(e->type)]++;
+}
+
+void minimalDispatchEvent(uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
+{
+    minimalDispatchWindowEvent(NULL, type, uParam, lParam, rParam);
+}
+
+void minimalDispatchWindowEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
+{
+    if (event_discard) return;
+
+    MinimalEvent e = { .type = type, .window = window, .uParam = uParam, .lParam = lParam, .rParam = rParam };
+
+    // motion events carry the distance to the previous position, the first one in a window has none
+    if (type == MINIMAL_EVENT_MOUSE_MOVED)
+    {
+        if (event_cursor.tracking && event_cursor.window == window)
+            e.uParam = minimalPackDelta(lParam - event_cursor.x, rParam - event_cursor.y);
+
+        event_cursor.window = window;
+        event_cursor.x = lParam;
+        event_cursor.y = rParam;
+        event_cursor.tracking = 1;
+    }
+
+    minimalStampEvent(&e);
+    if (!event_stats.handlerDepth) minimalRecordEvent(&e, NULL, 0);
+    minimalPushEvent(&e);
+}
+
+/* the size only tells recordings how much of the payload to keep */
+static void minimalDispatchExternalEventSized(uint32_t type, const void* data, size_t size)
+{
+    if (event_discard) return;
+
+    MinimalEvent e = { .type = type, .external = data };
+    minimalStampEvent(&e);
+
+    // handlers dispatch their events again on replay, only the input causing them is recorded
+    if (!event_stats.handlerDepth) minimalRecordEvent(&e, data, size);
+
+    minimalPushEvent(&e);
+}
+
+/* in queue mode data has to stay valid until the event is pulled */
+void minimalDispatchExternalEvent(uint32_t type, const void* data)
+{
+    minimalDispatchExternalEventSized(type, data, 0);
+}
+
+uint8_t minimalDispatchExternalEventCopy(uint32_t type, const void* data, size_t size)
+{
+    void* copy = minimalEventArenaAlloc(size);
+    if (!copy)
+    {
+        MINIMAL_WARN("[Event] Event arena is full, dropping event %u", type);
+        return MINIMAL_FAIL;
+    }
+
+    if (size) MINIMAL_MEMCPY(copy, data, size);
+
+    minimalDispatchExternalEventSized(type, copy, size);
+    return MINIMAL_OK;
+}
+
+void minimalResetEventArena()
+{
+    event_arena.offset = 0;
+}
+
+uint8_t minimalEventIsType(const MinimalEvent* e, uint32_t type)  { return e->type == type; }
+uint8_t minimalEventIsExternal(const MinimalEvent* e)        { return e->type > MINIMAL_EVENT_LAST; }
+
+MinimalWindow* minimalEventWindow(const MinimalEvent* e)    { return e->window; }
+uint64_t minimalEventTimestamp(const MinimalEvent* e)       { return e->time; }
+uint32_t minimalEventSequence(const MinimalEvent* e)        { return e->seq; }
+
+const void* minimalExternalEvent(const MinimalEvent* e)
+{
+    return minimalEventIsExternal(e) ? e->external : NULL;
+}
+
+uint8_t minimalEventWindowSize(const MinimalEvent* e, uint32_t* w, uint32_t* h)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_WINDOW_SIZE)) return 0;
+
+    if (w) *w = (uint32_t)e->lParam;
+    if (h) *h = (uint32_t)e->rParam;
+
+    return 1;
+}
+
+uint8_t minimalEventMouseButton(const MinimalEvent* e, MinimalMouseButton button, float* x, float* y)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_BUTTON)) return 0;
+
+    if (button != (MinimalMouseButton)MINIMAL_HIWORD(e->uParam)) return 0;
+
+    if (x) *x = (float)e->lParam;
+    if (y) *y = (float)e->rParam;
+
+    return 1;
+}
+
+uint8_t minimalEventMouseButtonPressed(const MinimalEvent* e, MinimalMouseButton button, float* x, float* y)
+{
+    return minimalEventMouseButton(e, button, x, y) && MINIMAL_LOWORD(e->uParam) == MINIMAL_PRESS;
+}
+
+uint8_t minimalEventMouseButtonReleased(const MinimalEvent* e, MinimalMouseButton button, float* x, float* y)
+{
+    return minimalEventMouseButton(e, button, x, y) && MINIMAL_LOWORD(e->uParam) == MINIMAL_RELEASE;
+}
+
+uint16_t minimalEventMouseButtonAction(const MinimalEvent* e)
+{
+    return MINIMAL_LOWORD(e->uParam);
+}
+
+uint8_t minimalEventMouseMoved(const MinimalEvent* e, float* x, float* y)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_MOVED)) return 0;
+
+    if (x) *x = (float)e->lParam;
+    if (y) *y = (float)e->rParam;
+
+    return 1;
+}
+
+uint8_t minimalEventMouseDelta(const MinimalEvent* e, int32_t* dx, int32_t* dy)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_MOVED)) return 0;
+
+    if (dx) *dx = (int16_t)MINIMAL_LOWORD(e->uParam);
+    if (dy) *dy = (int16_t)MINIMAL_HIWORD(e->uParam);
+
+    return 1;
+}
+
+uint8_t minimalEventMouseRaw(const MinimalEvent* e, float* dx, float* dy)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_RAW)) return 0;
+
+    if (dx) *dx = (float)e->lParam / MINIMAL_MOUSE_RAW_ONE;
+    if (dy) *dy = (float)e->rParam / MINIMAL_MOUSE_RAW_ONE;
+
+    return 1;
+}
+
+uint8_t minimalEventMouseScrolled(const MinimalEvent* e, float* xoffset, float* yoffset)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
+
+    if (xoffset) *xoffset = (float)e->lParam;
+    if (yoffset) *yoffset = (float)e->rParam;
+
+    return 1;
+}
+
+MinimalKeycode minimalEventKey(const MinimalEvent* e)
+{
+    return (e->type == MINIMAL_EVENT_KEY) ? e->uParam : MINIMAL_KEY_UNKNOWN;
+}
+
+MinimalKeycode minimalEventKeyPressed(const MinimalEvent* e)
+{
+    return (e->type == MINIMAL_EVENT_KEY && e->lParam == MINIMAL_PRESS) ? e->uParam : MINIMAL_KEY_UNKNOWN;
+}
+
+MinimalKeycode minimalEventKeyReleased(const MinimalEvent* e)
+{
+    return (e->type == MINIMAL_EVENT_KEY && e->lParam == MINIMAL_RELEASE) ? e->uParam : MINIMAL_KEY_UNKNOWN;
+}
+
+char minimalEventChar(const MinimalEvent* e)
+{
+    return (e->type == MINIMAL_EVENT_CHAR) ? (char)e->uParam : '\0';
+}
+
+
+
+#include <stdio.h>
+
+/*
+ * A recording is a 16 byte file header followed by 40 byte records in native
+ * byte order. Frame records mark the start of a frame and carry its time and
+ * the time since the previous frame, event records are followed by their
+ * payload padded to 8 bytes. Every record starts 8 byte aligned, so the file
+ * is loaded as a whole and read in place. ftell limits it to 2 GB on windows.
+ */
+#define MINIMAL_RECORD_MAGIC        "MINREC\0\0"
+#define MINIMAL_RECORD_VERSION      1
+
+#define MINIMAL_RECORD_FRAME        1
+#define MINIMAL_RECORD_EVENT        2
+
+#define MINIMAL_RECORD_PADDED(size) (((size) + 7) & ~(size_t)7)
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+} MinimalRecordHeader;
+
+typedef struct
+{
+    uint32_t kind;
+    uint32_t type;
+    uint64_t time;
+    uint64_t delta;
+    uint32_t uParam;
+    int32_t lParam;
+    int32_t rParam;
+    uint32_t size;
+} MinimalRecord;
+
+static struct
+{
+    FILE* file;
+    uint32_t frames;
+    uint8_t capturing;
+    uint8_t failed;
+} record;
+
+static struct
+{
+    uint8_t* data;
+    size_t size;
+    size_t cursor;
+} replay;
+
+/* --------------------------| record |---------------------------------- */
+/* a failed write ends the recording, minimalRecordStop reports it */
+static void minimalRecordWrite(const void* data, size_t size)
+{
+    if (!record.file || fwrite(data, 1, size, record.file) == size) return;
+
+    MINIMAL_ERROR("[Record] Failed to write the recording, the rest of it is lost");
+    fclose(record.file);
+    record.file = NULL;
+    record.failed = 1;
+}
+
+uint8_t minimalRecordStart(const char* path)
+{
+    minimalRecordStop();
+
+    record.file = fopen(path, "wb");
+    if (!record.file)
+    {
+        MINIMAL_ERROR("[Record] Failed to open %s", path);
+        return MINIMAL_FAIL;
+    }
+
+    MinimalRecordHeader header = { .version = MINIMAL_RECORD_VERSION };
+    MINIMAL_MEMCPY(header.magic, MINIMAL_RECORD_MAGIC, sizeof(header.magic));
+
+    minimalRecordWrite(&header, sizeof(header));
+    record.frames = 0;
+
+    return record.file ? MINIMAL_OK : MINIMAL_FAIL;
+}
+
+uint8_t minimalRecordStop()
+{
+    uint8_t result = !record.failed;
+    if (record.file && fclose(record.file) != 0)
+    {
+        MINIMAL_ERROR("[Record] Failed to finish the recording");
+        result = MINIMAL_FAIL;
+    }
+
+    record.file = NULL;
+    record.failed = 0;
+    return result;
+}
+
+void minimalRecordFrame(uint64_t time, uint64_t delta)
+{
+    if (!record.file) return;
+
+    MinimalRecord r = { .kind = MINIMAL_RECORD_FRAME, .time = time, .delta = delta };
+    minimalRecordWrite(&r, sizeof(r));
+    record.frames++;
+}
+
+void minimalRecordCapture(uint8_t capture)
+{
+    record.capturing = capture;
+}
+
+void minimalRecordEvent(const MinimalEvent* e, const void* data, size_t size)
+{
+    // only input polled as part of a frame is recorded, replayed events are not recorded again
+    if (!record.file || !record.capturing || !record.frames || replay.data) return;
+
+    // a payload of unknown size can not be kept, replaying the event without it would crash its handlers
+    if (e->type > MINIMAL_EVENT_LAST && data && !size)
+    {
+        MINIMAL_WARN("[Record] Event %u has a payload of unknown size and is not recorded, use minimalDispatchExternalEventCopy", e->type);
+        return;
+    }
+
+    MinimalRecord r = { .kind = MINIMAL_RECORD_EVENT, .type = e->type, .time = e->time };
+    if (e->type > MINIMAL_EVENT_LAST)
+    {
+        r.size = (uint32_t)size;
+    }
+    else
+    {
+        r.uParam = e->uParam;
+        r.lParam = e->lParam;
+        r.rParam = e->rParam;
+    }
+
+    minimalRecordWrite(&r, sizeof(r));
+
+    if (r.size)
+    {
+        static const uint8_t padding[8] = { 0 };
+        minimalRecordWrite(data, r.size);
+        minimalRecordWrite(padding, MINIMAL_RECORD_PADDED(r.size) - r.size);
+    }
+}
+
+/* --------------------------| replay |---------------------------------- */
+uint8_t minimalReplayStart(const char* path)
+{
+    minimalReplayStop();
+
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        MINIMAL_ERROR("[Record] Failed to open %s", path);
+        return MINIMAL_FAIL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    MinimalRecordHeader header = { 0 };
+    if (size < 0)
+    {
+        MINIMAL_ERROR("[Record] Failed to read %s", path);
+        fclose(file);
+        return MINIMAL_FAIL;
+    }
+
+    if (size < (long)sizeof(header) || fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, MINIMAL_RECORD_MAGIC, sizeof(header.magic)) != 0
+        || header.version != MINIMAL_RECORD_VERSION)
+    {
+        MINIMAL_ERROR("[Record] %s is not a recording", path);
+        fclose(file);
+        return MINIMAL_FAIL;
+    }
+
+    replay.size = (size_t)size - sizeof(header);
+    replay.data = MINIMAL_ALLOC(replay.size ? replay.size : 1);
+    if (!replay.data || fread(replay.data, 1, replay.size, file) != replay.size)
+    {
+        MINIMAL_ERROR("[Record] Failed to read %s", path);
+        fclose(file);
+        minimalReplayStop();
+        return MINIMAL_FAIL;
+    }
+
+    fclose(file);
+    replay.cursor = 0;
+
+    return MINIMAL_OK;
+}
+
+void minimalReplayStop()
+{
+    if (replay.data) MINIMAL_FREE(replay.data, replay.size);
+
+    replay.data = NULL;
+    replay.size = 0;
+    replay.cursor = 0;
+}
+
+uint8_t minimalReplaying()
+{
+    return replay.data != NULL;
+}
+
+/* the record at the cursor, NULL at the end or if the rest of the file is truncated */
+static const MinimalRecord* minimalReplayPeek()
+{
+    if (replay.size - replay.cursor < sizeof(MinimalRecord)) return NULL;
+
+    const MinimalRecord* r = (const MinimalRecord*)(replay.data + replay.cursor);
+    if (MINIMAL_RECORD_PADDED(r->size) > replay.size - replay.cursor - sizeof(MinimalRecord)) return NULL;
+
+    return r;
+}
+
+uint8_t minimalReplayFrame(uint64_t* time, uint64_t* delta)
+{
+    const MinimalRecord* r = minimalReplayPeek();
+    if (!r || r->kind != MINIMAL_RECORD_FRAME) return MINIMAL_FAIL;
+
+    replay.cursor += sizeof(MinimalRecord);
+    *time = r->time;
+    *delta = r->delta;
+
+    return MINIMAL_OK;
+}
+
+void minimalReplayEvents(MinimalWindow* window)
+{
+    const MinimalRecord* r;
+    while ((r = minimalReplayPeek()) != NULL && r->kind == MINIMAL_RECORD_EVENT)
+    {
+        replay.cursor += sizeof(MinimalRecord) + MINIMAL_RECORD_PADDED(r->size);
+
+        minimalSetEventTime(r->time);
+
+        // input goes through the same state updates as on the platform that recorded it
+        switch (r->type)
+        {
+        case MINIMAL_EVENT_KEY:
+            if (minimalProcessKey((MinimalKeycode)r->uParam, (uint8_t)r->lParam))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        case MINIMAL_EVENT_MOUSE_BUTTON:
+            if (minimalProcessMouseButton((MinimalMouseButton)(r->uParam >> 16), (uint8_t)(r->uParam & 0xffff)))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        case MINIMAL_EVENT_MOUSE_MOVED:
+            if (minimalProcessMouseMove((float)r->lParam, (float)r->rParam))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        case MINIMAL_EVENT_MOUSE_RAW:
+            if (minimalProcessMouseRaw(r->lParam, r->rParam))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        default:
+            if (r->type > MINIMAL_EVENT_LAST)
+                minimalDispatchExternalEvent(r->type, r->size ? (const void*)(r + 1) : NULL);
+            else
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        }
+    }
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+
+
+#ifdef __linux__
+#include <linux/input.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+#ifndef MINIMAL_GAMEPAD_DEVICE_DIR
+#define MINIMAL_GAMEPAD_DEVICE_DIR  "/dev/input"
+#endif
+
+/* events taken from a device per read, devices are read until they are drained */
+#ifndef MINIMAL_GAMEPAD_READ_SIZE
+#define MINIMAL_GAMEPAD_READ_SIZE   64
+#endif
+
+/* events of one report held back until its SYN_REPORT, larger reports are resynced */
+#define MINIMAL_GAMEPAD_PACKET_SIZE 32
+
+#define MINIMAL_GAMEPAD_AXIS_COUNT  (MINIMAL_GAMEPAD_AXIS_LAST + 1)
+
+typedef struct
+{
+    int fd;
+    char node[32];
+    char name[64];
+
+    // one bit per button, like the mouse buttons of the input state
+    uint32_t buttons;
+    uint32_t prev_buttons;
+
+    // normalized values as reported and with the deadzone applied once per frame
+    float values[MINIMAL_GAMEPAD_AXIS_COUNT];
+    float axes[MINIMAL_GAMEPAD_AXIS_COUNT];
+
+    // range of the evdev axis behind every mapped axis
+    int32_t min[MINIMAL_GAMEPAD_AXIS_COUNT];
+    int32_t max[MINIMAL_GAMEPAD_AXIS_COUNT];
+
+    // the report being read, a report can span reads and frames
+    struct input_event packet[MINIMAL_GAMEPAD_PACKET_SIZE];
+    uint32_t packetCount;
+    uint8_t dropped;
+} MinimalGamepad;
+
+static struct
+{
+    uint8_t initialized;
+    int inotify;
+    float deadzone;
+    MinimalGamepad pads[MINIMAL_GAMEPAD_MAX];
+} gamepads = { .inotify = -1, .deadzone = MINIMAL_GAMEPAD_DEADZONE };
+
+static uint8_t minimalGamepadValid(uint32_t pad)
+{
+    return gamepads.initialized && pad < MINIMAL_GAMEPAD_MAX && gamepads.pads[pad].fd >= 0;
+}
+
+static uint8_t minimalGamepadButtonValid(MinimalGamepadButton button)
+{
+    return button >= 0 && button <= MINIMAL_GAMEPAD_BUTTON_LAST;
+}
+
+/* estimate from the float bits refined by newton steps, saves every user linking libm for sqrtf */
+static float minimalGamepadLength(float x, float y)
+{
+    float sq = x * x + y * y;
+    if (sq <= 0.0f) return 0.0f;
+
+    union { float f; uint32_t u; } bits = { .f = sq };
+    bits.u = (bits.u >> 1) + 0x1fbd1df5;
+
+    float length = bits.f;
+    for (int i = 0; i < 3; ++i)
+        length = 0.5f * (length + sq / length);
+
+    return length;
+}
+
+/* sticks use a radial deadzone so diagonals do not snap to the axes */
+static void minimalGamepadApplyStick(MinimalGamepad* pad, MinimalGamepadAxis x, MinimalGamepadAxis y)
+{
+    float vx = pad->values[x];
+    float vy = pad->values[y];
+    float length = minimalGamepadLength(vx, vy);
+
+    pad->axes[x] = 0.0f;
+    pad->axes[y] = 0.0f;
+    if (length <= gamepads.deadzone) return;
+
+    // rescaled so the output still covers the whole range
+    float scaled = (length - gamepads.deadzone) / (1.0f - gamepads.deadzone);
+    if (scaled > 1.0f) scaled = 1.0f;
+
+    pad->axes[x] = vx * scaled / length;
+    pad->axes[y] = vy * scaled / length;
+}
+
+static void minimalGamepadApplyTrigger(MinimalGamepad* pad, MinimalGamepadAxis axis)
+{
+    float value = pad->values[axis];
+    pad->axes[axis] = value <= gamepads.deadzone ? 0.0f : (value - gamepads.deadzone) / (1.0f - gamepads.deadzone);
+}
+
+static void minimalGamepadApplyDeadzone(MinimalGamepad* pad)
+{
+    minimalGamepadApplyStick(pad, MINIMAL_GAMEPAD_AXIS_LEFT_X, MINIMAL_GAMEPAD_AXIS_LEFT_Y);
+    minimalGamepadApplyStick(pad, MINIMAL_GAMEPAD_AXIS_RIGHT_X, MINIMAL_GAMEPAD_AXIS_RIGHT_Y);
+    minimalGamepadApplyTrigger(pad, MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER);
+    minimalGamepadApplyTrigger(pad, MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER);
+}
+
+/* --------------------------| evdev |----------------------------------- */
+#ifdef __linux__
+
+#define MINIMAL_EVDEV_LONG_BITS         (sizeof(unsigned long) * 8)
+#define MINIMAL_EVDEV_LONGS(count)      (((count) + MINIMAL_EVDEV_LONG_BITS - 1) / MINIMAL_EVDEV_LONG_BITS)
+#define MINIMAL_EVDEV_TEST(bits, i)     (((bits)[(i) / MINIMAL_EVDEV_LONG_BITS] >> ((i) % MINIMAL_EVDEV_LONG_BITS)) & 1)
+
+static uint8_t minimalGamepadIsTrigger(MinimalGamepadAxis axis)
+{
+    return axis == MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER || axis == MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER;
+}
+
+static MinimalGamepadButton minimalEvdevButton(uint16_t code)
+{
+    switch (code)
+    {
+    case BTN_SOUTH:         return MINIMAL_GAMEPAD_BUTTON_A;
+    case BTN_EAST:          return MINIMAL_GAMEPAD_BUTTON_B;
+    case BTN_WEST:          return MINIMAL_GAMEPAD_BUTTON_X;
+    case BTN_NORTH:         return MINIMAL_GAMEPAD_BUTTON_Y;
+    case BTN_TL:            return MINIMAL_GAMEPAD_BUTTON_LEFT_BUMPER;
+    case BTN_TR:            return MINIMAL_GAMEPAD_BUTTON_RIGHT_BUMPER;
+    case BTN_SELECT:        return MINIMAL_GAMEPAD_BUTTON_BACK;
+    case BTN_START:         return MINIMAL_GAMEPAD_BUTTON_START;
+    case BTN_MODE:          return MINIMAL_GAMEPAD_BUTTON_GUIDE;
+    case BTN_THUMBL:        return MINIMAL_GAMEPAD_BUTTON_LEFT_THUMB;
+    case BTN_THUMBR:        return MINIMAL_GAMEPAD_BUTTON_RIGHT_THUMB;
+    case BTN_DPAD_UP:       return MINIMAL_GAMEPAD_BUTTON_DPAD_UP;
+    case BTN_DPAD_RIGHT:    return MINIMAL_GAMEPAD_BUTTON_DPAD_RIGHT;
+    case BTN_DPAD_DOWN:     return MINIMAL_GAMEPAD_BUTTON_DPAD_DOWN;
+    case BTN_DPAD_LEFT:     return MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT;
+    }
+
+    // joysticks have no layout, their buttons fill the standard buttons in order up to the dpad
+    if (code >= BTN_TRIGGER && code < BTN_TRIGGER + MINIMAL_GAMEPAD_BUTTON_DPAD_UP)
+        return (MinimalGamepadButton)(code - BTN_TRIGGER);
+
+    return MINIMAL_GAMEPAD_BUTTON_UNKNOWN;
+}
+
+static MinimalGamepadAxis minimalEvdevAxis(uint16_t code)
+{
+    switch (code)
+    {
+    case ABS_X:     return MINIMAL_GAMEPAD_AXIS_LEFT_X;
+    case ABS_Y:     return MINIMAL_GAMEPAD_AXIS_LEFT_Y;
+    case ABS_RX:    return MINIMAL_GAMEPAD_AXIS_RIGHT_X;
+    case ABS_RY:    return MINIMAL_GAMEPAD_AXIS_RIGHT_Y;
+    case ABS_Z:     return MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER;
+    case ABS_RZ:    return MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER;
+    default:        return -1;
+    }
+}
+
+static void minimalEvdevSetButton(MinimalGamepad* pad, MinimalGamepadButton button, uint8_t down)
+{
+    if (!minimalGamepadButtonValid(button)) return;
+
+    if (down)   pad->buttons |= (uint32_t)1 << button;
+    else        pad->buttons &= ~((uint32_t)1 << button);
+}
+
+static void minimalEvdevProcessKey(MinimalGamepad* pad, uint16_t code, int32_t value)
+{
+    // digital triggers move the trigger axis all the way
+    if (code == BTN_TL2 || code == BTN_TR2)
+    {
+        MinimalGamepadAxis axis = code == BTN_TL2 ? MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER : MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER;
+        if (pad->max[axis] == pad->min[axis]) pad->values[axis] = value ? 1.0f : 0.0f;
+        return;
+    }
+
+    minimalEvdevSetButton(pad, minimalEvdevButton(code), value != 0);
+}
+
+static void minimalEvdevProcessAbs(MinimalGamepad* pad, uint16_t code, int32_t value)
+{
+    // hats are the dpad of most pads, negative values point up and left
+    if (code == ABS_HAT0X)
+    {
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT, value < 0);
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_RIGHT, value > 0);
+        return;
+    }
+
+    if (code == ABS_HAT0Y)
+    {
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_UP, value < 0);
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_DOWN, value > 0);
+        return;
+    }
+
+    MinimalGamepadAxis axis = minimalEvdevAxis(code);
+    if (axis < 0 || pad->max[axis] == pad->min[axis]) return;
+
+    float t = (float)(value - pad->min[axis]) / (float)(pad->max[axis] - pad->min[axis]);
+    pad->values[axis] = minimalGamepadIsTrigger(axis) ? t : t * 2.0f - 1.0f;
+}
+
+/* reads the full device state, on open and after the kernel dropped events */
+static void minimalEvdevSync(MinimalGamepad* pad)
+{
+    unsigned long keys[MINIMAL_EVDEV_LONGS(KEY_CNT)] = { 0 };
+    if (ioctl(pad->fd, EVIOCGKEY(sizeof(keys)), keys) >= 0)
+    {
+        pad->buttons = 0;
+        for (uint16_t code = BTN_MISC; code < BTN_DIGI; ++code)
+            minimalEvdevProcessKey(pad, code, (int32_t)MINIMAL_EVDEV_TEST(keys, code));
+        for (uint16_t code = BTN_DPAD_UP; code <= BTN_DPAD_RIGHT; ++code)
+            minimalEvdevProcessKey(pad, code, (int32_t)MINIMAL_EVDEV_TEST(keys, code));
+    }
+
+    for (uint16_t code = ABS_X; code <= ABS_HAT0Y; ++code)
+    {
+        struct input_absinfo info;
+        if (ioctl(pad->fd, EVIOCGABS(code), &info) >= 0)
+            minimalEvdevProcessAbs(pad, code, info.value);
+    }
+}
+
+static void minimalEvdevClose(MinimalGamepad* pad)
+{
+    if (pad->fd < 0) return;
+
+    MINIMAL_INFO("[Gamepad] Disconnected %s", pad->name);
+
+    close(pad->fd);
+    MINIMAL_MEMSET(pad, 0, sizeof(MinimalGamepad));
+    pad->fd = -1;
+}
+
+static void minimalEvdevOpen(const char* node)
+{
+    if (strncmp(node, "event", 5) != 0) return;
+
+    MinimalGamepad* pad = NULL;
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+    {
+        // udev changes the permissions after creating the node, both report the device
+        if (gamepads.pads[i].fd >= 0 && strcmp(gamepads.pads[i].node, node) == 0) return;
+        if (!pad && gamepads.pads[i].fd < 0) pad = &gamepads.pads[i];
+    }
+
+    if (!pad) return;
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/%s", MINIMAL_GAMEPAD_DEVICE_DIR, node);
+
+    // most devices are not readable without the input group, those are skipped quietly
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return;
+
+    unsigned long keys[MINIMAL_EVDEV_LONGS(KEY_CNT)] = { 0 };
+    unsigned long abs[MINIMAL_EVDEV_LONGS(ABS_CNT)] = { 0 };
+    ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys);
+    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs)), abs);
+
+    // keyboards, mice and motion sensors lack either the buttons or the stick
+    uint8_t buttons = MINIMAL_EVDEV_TEST(keys, BTN_GAMEPAD) || MINIMAL_EVDEV_TEST(keys, BTN_JOYSTICK);
+    if (!buttons || !MINIMAL_EVDEV_TEST(abs, ABS_X))
+    {
+        close(fd);
+        return;
+    }
+
+    MINIMAL_MEMSET(pad, 0, sizeof(MinimalGamepad));
+    pad->fd = fd;
+    snprintf(pad->node, sizeof(pad->node), "%s", node);
+
+    if (ioctl(fd, EVIOCGNAME(sizeof(pad->name)), pad->name) < 0)
+        snprintf(pad->name, sizeof(pad->name), "%s", node);
+
+    for (uint16_t code = ABS_X; code <= ABS_RZ; ++code)
+    {
+        MinimalGamepadAxis axis = minimalEvdevAxis(code);
+        struct input_absinfo info;
+        if (axis < 0 || !MINIMAL_EVDEV_TEST(abs, code) || ioctl(fd, EVIOCGABS(code), &info) < 0) continue;
+
+        pad->min[axis] = info.minimum;
+        pad->max[axis] = info.maximum;
+    }
+
+    minimalEvdevSync(pad);
+    pad->prev_buttons = pad->buttons;
+    minimalGamepadApplyDeadzone(pad);
+
+    MINIMAL_INFO("[Gamepad] Connected %s", pad->name);
+}
+
+static void minimalEvdevRemove(const char* node)
+{
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+    {
+        if (gamepads.pads[i].fd >= 0 && strcmp(gamepads.pads[i].node, node) == 0)
+            minimalEvdevClose(&gamepads.pads[i]);
+    }
+}
+
+static void minimalEvdevProcessEvent(MinimalGamepad* pad, const struct input_event* e)
+{
+    if (e->type == EV_SYN && e->code == SYN_DROPPED)
+    {
+        // the kernel buffer overflowed, everything up to the next report is incomplete
+        pad->dropped = 1;
+        pad->packetCount = 0;
+        return;
+    }
+
+    if (e->type == EV_SYN && e->code == SYN_REPORT)
+    {
+        if (pad->dropped)
+        {
+            minimalEvdevSync(pad);
+            pad->dropped = 0;
+        }
+
+        for (uint32_t i = 0; i < pad->packetCount; ++i)
+        {
+            const struct input_event* p = &pad->packet[i];
+            if (p->type == EV_KEY)      minimalEvdevProcessKey(pad, p->code, p->value);
+            else if (p->type == EV_ABS) minimalEvdevProcessAbs(pad, p->code, p->value);
+        }
+
+        pad->packetCount = 0;
+        return;
+    }
+
+    if (pad->dropped || (e->type != EV_KEY && e->type != EV_ABS)) return;
+
+    if (pad->packetCount == MINIMAL_GAMEPAD_PACKET_SIZE)
+    {
+        pad->dropped = 1;
+        pad->packetCount = 0;
+        return;
+    }
+
+    pad->packet[pad->packetCount++] = *e;
+}
+
+static void minimalEvdevRead(MinimalGamepad* pad)
+{
+    struct input_event events[MINIMAL_GAMEPAD_READ_SIZE];
+
+    // a short read means the device is drained
+    ssize_t size = sizeof(events);
+    while (size == (ssize_t)sizeof(events))
+    {
+        size = read(pad->fd, events, sizeof(events));
+        if (size < 0)
+        {
+            // the node can vanish before inotify reports it
+            if (errno != EAGAIN && errno != EINTR) minimalEvdevClose(pad);
+            return;
+        }
+
+        size_t count = (size_t)size / sizeof(struct input_event);
+        for (size_t i = 0; i < count; ++i)
+            minimalEvdevProcessEvent(pad, &events[i]);
+    }
+}
+
+static void minimalEvdevHotplug()
+{
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    ssize_t size;
+    while ((size = read(gamepads.inotify, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* p = buffer; p < buffer + size; )
+        {
+            const struct inotify_event* e = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + e->len;
+
+            if (!e->len) continue;
+
+            if (e->mask & IN_DELETE)                    minimalEvdevRemove(e->name);
+            else if (e->mask & (IN_CREATE | IN_ATTRIB)) minimalEvdevOpen(e->name);
+        }
+    }
+}
+
+uint8_t minimalGamepadInit()
+{
+    if (gamepads.initialized) return MINIMAL_OK;
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        gamepads.pads[i].fd = -1;
+
+    // without inotify the devices connected now still work
+    gamepads.inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (gamepads.inotify >= 0 && inotify_add_watch(gamepads.inotify, MINIMAL_GAMEPAD_DEVICE_DIR, IN_CREATE | IN_ATTRIB | IN_DELETE) < 0)
+    {
+        close(gamepads.inotify);
+        gamepads.inotify = -1;
+    }
+
+    if (gamepads.inotify < 0)
+        MINIMAL_WARN("[Gamepad] Failed to watch %s, hotplugged devices are not detected", MINIMAL_GAMEPAD_DEVICE_DIR);
+
+    gamepads.initialized = 1;
+
+    DIR* dir = opendir(MINIMAL_GAMEPAD_DEVICE_DIR);
+    if (!dir) return MINIMAL_OK;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL)
+        minimalEvdevOpen(entry->d_name);
+
+    closedir(dir);
+    return MINIMAL_OK;
+}
+
+void minimalGamepadTerminate()
+{
+    if (!gamepads.initialized) return;
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        minimalEvdevClose(&gamepads.pads[i]);
+
+    if (gamepads.inotify >= 0) close(gamepads.inotify);
+    gamepads.inotify = -1;
+    gamepads.initialized = 0;
+}
+
+void minimalUpdateGamepads()
+{
+    if (!gamepads.initialized) return;
+
+    if (gamepads.inotify >= 0) minimalEvdevHotplug();
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+    {
+        MinimalGamepad* pad = &gamepads.pads[i];
+        if (pad->fd < 0) continue;
+
+        pad->prev_buttons = pad->buttons;
+
+        // devices are not read while live input is discarded, buttons keep their state without edges
+        if (minimalEventsDiscarded()) continue;
+
+        minimalEvdevRead(pad);
+
+        if (pad->fd >= 0) minimalGamepadApplyDeadzone(pad);
+    }
+}
+
+#else
+
+uint8_t minimalGamepadInit()
+{
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        gamepads.pads[i].fd = -1;
+
+    gamepads.initialized = 1;
+    return MINIMAL_OK;
+}
+
+void minimalGamepadTerminate()  { gamepads.initialized = 0; }
+void minimalUpdateGamepads()    { }
+
+#endif // __linux__
+
+/* --------------------------| gamepad |--------------------------------- */
+void minimalSetGamepadDeadzone(float deadzone)
+{
+    // a deadzone of one would divide by zero when rescaling
+    if (deadzone < 0.0f)  deadzone = 0.0f;
+    if (deadzone > 0.99f) deadzone = 0.99f;
+
+    gamepads.deadzone = deadzone;
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        minimalGamepadApplyDeadzone(&gamepads.pads[i]);
+}
+
+uint8_t minimalGamepadConnected(uint32_t pad)
+{
+    return minimalGamepadValid(pad);
+}
+
+const char* minimalGamepadName(uint32_t pad)
+{
+    return minimalGamepadValid(pad) ? gamepads.pads[pad].name : NULL;
+}
+
+uint8_t minimalGamepadPressed(uint32_t pad, MinimalGamepadButton button)
+{
+    if (!minimalGamepadValid(pad) || !minimalGamepadButtonValid(button)) return 0;
+
+    const MinimalGamepad* p = &gamepads.pads[pad];
+    return ((p->buttons & ~p->prev_buttons) >> button) & 1;
+}
+
+uint8_t minimalGamepadReleased(uint32_t pad, MinimalGamepadButton button)
+{
+    if (!minimalGamepadValid(pad) || !minimalGamepadButtonValid(button)) return 0;
+
+    const MinimalGamepad* p = &gamepads.pads[pad];
+    return ((p->prev_buttons & ~p->buttons) >> button) & 1;
+}
+
+uint8_t minimalGamepadDown(uint32_t pad, MinimalGamepadButton button)
+{
+    if (!minimalGamepadValid(pad) || !minimalGamepadButtonValid(button)) return 0;
+
+    return (gamepads.pads[pad].buttons >> button) & 1;
+}
+
+float minimalGamepadAxis(uint32_t pad, MinimalGamepadAxis axis)
+{
+    if (!minimalGamepadValid(pad) || axis < 0 || axis > MINIMAL_GAMEPAD_AXIS_LAST) return 0.0f;
+
+    return gamepads.pads[pad].axes[axis];
+}
+
+
+
+#ifdef MINIMAL_PLATFORM_WINDOWS
+
+#ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+#define MINIMAL_WNDCLASSNAME L"MINIMALWNDCLASS"
+
+#if !defined(MINIMAL_NO_CONTEXT) && !defined(MINIMAL_CONTEXT_EGL)
+#define MINIMAL_CONTEXT_WGL
+#endif
+
+static uint64_t _minimalTimerFrequency = 0;
+static uint64_t _minimalTimerOffset = 0;
+
+static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+#ifdef MINIMAL_CONTEXT_WGL
+
+static uint8_t minimalWGLInit();
+static void minimalWGLTerminate();
+static HGLRC minimalCreateRenderContext(HDC dc);
+
+#endif
+
+uint8_t minimalPlatformInit()
+{
+    // register window class
+    WNDCLASSEXW wndClass = {
+        .cbSize         = sizeof(WNDCLASSEXW),
+        .hInstance      = GetModuleHandleW(NULL),
+        .lpfnWndProc    = minimalWindowProc,
+        .style          = CS_HREDRAW | CS_VREDRAW | CS_OWNDC,
+        .lpszClassName  = MINIMAL_WNDCLASSNAME,
+        .lpszMenuName   = NULL,
+        .hIcon          = LoadIconW(NULL, IDI_APPLICATION),
+        .hIconSm        = LoadIconW(NULL, IDI_APPLICATION),
+        .hCursor        = LoadCursorW(NULL, IDC_ARROW)
+    };
+
+    if (!RegisterClassExW(&wndClass))
+    {
+        MINIMAL_ERROR("[Platform] Failed to register WindowClass");
+        return FALSE;
+    }
+
+    // init time
+    if (!QueryPerformanceFrequency((LARGE_INTEGER*)&_minimalTimerFrequency))
+    {
+        MINIMAL_ERROR("[Platform] High-resolution performance counter is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    QueryPerformanceCounter((LARGE_INTEGER*)&_minimalTimerOffset);
+    minimalInitTicks();
+
+#if defined(MINIMAL_CONTEXT_EGL)
+    // init egl
+    if (!minimalEGLInit(0, EGL_DEFAULT_DISPLAY))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+#ifdef MINIMAL_CONTEXT_WGL
+    minimalWGLTerminate();
+#elif defined(MINIMAL_CONTEXT_EGL)
+    minimalEGLTerminate();
+#endif
+
+    // unregister window class
+    if (!UnregisterClassW(MINIMAL_WNDCLASSNAME, GetModuleHandleW(NULL)))
+    {
+        MINIMAL_ERROR("[Platform] Failed to unregister WindowClass");
+        return MINIMAL_FAIL;
+    }
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+typedef struct
+{
+    HBITMAP     bitmap;
+    uint32_t*   pixels;
+} MinimalWin32Framebuffer;
+
+struct MinimalWindow
+{
+    HWND handle;
+
+    HDC         framebufferDC;
+    MinimalWin32Framebuffer framebuffers[MINIMAL_FRAMEBUFFER_COUNT];
+    uint32_t    framebufferWidth;
+    uint32_t    framebufferHeight;
+    uint32_t    framebufferIndex;
+
+    uint32_t width;
+    uint32_t height;
+
+#ifdef MINIMAL_CONTEXT_WGL
+    HDC         deviceContext;
+    HGLRC       renderContext;
+#elif defined(MINIMAL_CONTEXT_EGL)
+    MinimalEGLContext egl;
+#endif
+
+    uint8_t shouldClose;
+    uint8_t pointerLocked;
+    uint8_t cursorTracked;
+
+    uint32_t eventMask;
+};
+
+/* raw mouse input is registered for one window per process, the last one enabling it */
+static MinimalWindow* _minimalRawWindow = NULL;
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->width = w;
+    window->height = h;
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    // create window
+    HINSTANCE instance = GetModuleHandleW(NULL);
+
+    RECT rect = { 0 };
+    DWORD style = WS_OVERLAPPEDWINDOW | WS_VISIBLE;
+    DWORD styleEx = WS_EX_APPWINDOW;
+    AdjustWindowRectEx(&rect, style, 0, styleEx);
+
+    x += rect.left;
+    y += rect.top;
+    w += rect.right - rect.left;
+    h += rect.bottom - rect.top;
+
+    // the window pointer is stored in GWLP_USERDATA on WM_NCCREATE
+    window->handle = CreateWindowExW(styleEx, MINIMAL_WNDCLASSNAME, NULL, style, x, y, w, h, 0, 0, instance, window);
+    if (!window->handle)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create window");
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    minimalSetWindowTitle(window, title);
+
+    window->shouldClose = 0;
+
+#ifndef MINIMAL_NO_CONTEXT
+    if (windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API)
+        return window;
+#endif
+
+#ifdef MINIMAL_CONTEXT_WGL
+
+    window->deviceContext = GetDC(window->handle);
+    window->renderContext = minimalCreateRenderContext(window->deviceContext);
+    if (!window->renderContext)
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    if (!minimalEGLCreateContext(&window->egl, window->handle, window->width, window->height, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    minimalDestroyFramebuffer(window);
+
+    if (_minimalRawWindow == window)
+        minimalSetEventMask(window, window->eventMask & ~MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW));
+
+    if (window->pointerLocked)
+        minimalSetPointerLock(window, 0);
+
+    minimalResetMouseDelta(window);
+
+#ifdef MINIMAL_CONTEXT_WGL
+
+    // destroy render context
+    if (window->renderContext)
+    {
+        if (!wglMakeCurrent(NULL, NULL))
+        {
+            MINIMAL_ERROR("[WGL] Failed to realease render context");
+        }
+
+        if (!wglDeleteContext(window->renderContext))
+        {
+            MINIMAL_ERROR("[WGL] Failed to delete render context");
+        }
+    }
+
+    // destroy device context
+    if (window->deviceContext && !ReleaseDC(window->handle, window->deviceContext))
+    {
+        MINIMAL_ERROR("[Platform] Failed to release device context");
+    }
+
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    minimalEGLDestroyContext(&window->egl);
+
+#endif
+
+    // destroy window
+    if (window->handle && !DestroyWindow(window->handle))
+    {
+        MINIMAL_ERROR("[Platform] Failed to destroy window");
+    }
+
+    free(window);
+}
+
+static void minimalWindowsDispatchMessage(const MSG* msg)
+{
+    // char messages are only generated for windows that want them
+    MinimalWindow* window = (MinimalWindow*)GetWindowLongPtrW(msg->hwnd, GWLP_USERDATA);
+    if (MINIMAL_EVENT_ENABLED(window, MINIMAL_EVENT_CHAR))
+        TranslateMessage(msg);
+
+    DispatchMessageW(msg);
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    MSG msg;
+    while (PeekMessageW(&msg, context->handle, 0, 0, PM_REMOVE))
+        minimalWindowsDispatchMessage(&msg);
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+void minimalPollAllEvents()
+{
+    // a single queue holds the messages of all windows of the thread
+    MSG msg;
+    while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE))
+        minimalWindowsDispatchMessage(&msg);
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    DWORD ms = INFINITE;
+    if (timeout != MINIMAL_WAIT_INFINITE)
+    {
+        // rounded up so short waits do not turn into spins
+        uint64_t value = (timeout + 999999) / 1000000;
+        ms = value >= INFINITE ? INFINITE - 1 : (DWORD)value;
+    }
+
+    // MWMO_INPUTAVAILABLE also returns for input that was seen but not removed by an earlier peek
+    MsgWaitForMultipleObjectsEx(0, NULL, ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+
+    // the wait returns for messages of any window on the thread, leaving them
+    // queued would end every following wait right away
+    minimalPollAllEvents();
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    PostMessageW(window->handle, WM_NULL, 0, 0);
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+
+    uint8_t raw = (mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW)) != 0;
+    if (raw == (_minimalRawWindow == window)) return;
+
+    // generic desktop page, mouse usage
+    RAWINPUTDEVICE device = {
+        .usUsagePage    = 0x01,
+        .usUsage        = 0x02,
+        .dwFlags        = raw ? 0 : RIDEV_REMOVE,
+        .hwndTarget     = raw ? window->handle : NULL
+    };
+
+    if (!RegisterRawInputDevices(&device, 1, sizeof(device)))
+    {
+        MINIMAL_ERROR("[Platform] Failed to register raw mouse input");
+        return;
+    }
+
+    _minimalRawWindow = raw ? window : NULL;
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title)
+{
+    SetWindowTextA(context->handle, title);
+}
+
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window) { ShowWindow(window->handle, SW_SHOWMAXIMIZED); }
+void minimalMinimize(MinimalWindow* window) { ShowWindow(window->handle, SW_MINIMIZE); }
+
+static void minimalWindowsClipCursor(MinimalWindow* window)
+{
+    RECT rect;
+    GetClientRect(window->handle, &rect);
+    MapWindowPoints(window->handle, NULL, (POINT*)&rect, 2);
+    ClipCursor(&rect);
+}
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock)
+{
+    window->pointerLocked = lock;
+
+    if (lock)
+    {
+        minimalWindowsClipCursor(window);
+        SetCursor(NULL);
+    }
+    else
+    {
+        ClipCursor(NULL);
+        SetCursor(LoadCursorW(NULL, IDC_ARROW));
+    }
+}
+
+uint64_t minimalGetTimeNs()
+{
+    uint64_t value;
+    QueryPerformanceCounter((LARGE_INTEGER*)&value);
+    value -= _minimalTimerOffset;
+
+    // split the division so the multiplication can not overflow
+    uint64_t seconds = value / _minimalTimerFrequency;
+    uint64_t remainder = value % _minimalTimerFrequency;
+    return seconds * 1000000000 + remainder * 1000000000 / _minimalTimerFrequency;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    const HDC dc = GetDC(NULL);
+    UINT xdpi = GetDeviceCaps(dc, LOGPIXELSX);
+    UINT ydpi = GetDeviceCaps(dc, LOGPIXELSY);
+    ReleaseDC(NULL, dc);
+
+    if (xscale) *xscale = xdpi / (float)USER_DEFAULT_SCREEN_DPI;
+    if (yscale) *yscale = ydpi / (float)USER_DEFAULT_SCREEN_DPI;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return window->handle;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return GetModuleHandleW(NULL);
+}
+
+
+static uint32_t minimalGetKeyMods()
+{
+    uint32_t mods = 0;
+    if (GetKeyState(VK_SHIFT) & 0x8000)                         mods |= MINIMAL_KEY_MOD_SHIFT;
+    if (GetKeyState(VK_CONTROL) & 0x8000)                       mods |= MINIMAL_KEY_MOD_CONTROL;
+    if (GetKeyState(VK_MENU) & 0x8000)                          mods |= MINIMAL_KEY_MOD_ALT;
+    if ((GetKeyState(VK_LWIN) | GetKeyState(VK_RWIN)) & 0x8000) mods |= MINIMAL_KEY_MOD_COMMAND;
+    if (GetKeyState(VK_CAPITAL) & 1)                            mods |= MINIMAL_KEY_MOD_CAPS_LOCK;
+    if (GetKeyState(VK_NUMLOCK) & 1)                            mods |= MINIMAL_KEY_MOD_NUM_LOCK;
+    return mods;
+}
+
+static uint32_t minimalGetMouseButton(UINT msg, WPARAM wParam)
+{
+    if (msg == WM_LBUTTONDOWN || msg == WM_LBUTTONUP)   return MINIMAL_MOUSE_BUTTON_LEFT;
+    if (msg == WM_RBUTTONDOWN || msg == WM_RBUTTONUP)   return MINIMAL_MOUSE_BUTTON_RIGHT;
+    if (msg == WM_MBUTTONDOWN || msg == WM_MBUTTONUP)   return MINIMAL_MOUSE_BUTTON_MIDDLE;
+    if (GET_XBUTTON_WPARAM(wParam) == XBUTTON1)         return MINIMAL_MOUSE_BUTTON_4;
+    else                                                return MINIMAL_MOUSE_BUTTON_5;
+}
+
+#define MINIMAL_GET_X_LPARAM(lp)    ((int32_t)(int16_t)LOWORD(lp))
+#define MINIMAL_GET_Y_LPARAM(lp)    ((int32_t)(int16_t)HIWORD(lp))
+
+#define MINIMAL_GET_SCROLL(wp)      ((int32_t)((int16_t)HIWORD(wp) / (float)WHEEL_DELTA))
+
+static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    if (msg == WM_NCCREATE)
+    {
+        CREATESTRUCTW* cs = (CREATESTRUCTW*)lParam;
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, (LONG_PTR)cs->lpCreateParams);
+    }
+
+    // windows not created by minimalCreateWindow (e.g. the wgl helper) have no user data
+    MinimalWindow* context = (MinimalWindow*)GetWindowLongPtrW(hwnd, GWLP_USERDATA);
+
+    if (!context) return DefWindowProcW(hwnd, msg, wParam, lParam);
+
+    // the message time is only meaningful for input pulled from the queue
+    uint8_t input = (msg >= WM_KEYFIRST && msg <= WM_KEYLAST) || (msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST) || msg == WM_INPUT;
+    minimalSetEventTime(input ? minimalRebaseEventTime((uint32_t)GetMessageTime()) : 0);
+
+    switch (msg)
+    {
+    case WM_DESTROY:
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0);
+        return 0;
+    case WM_QUIT:
+    case WM_CLOSE:
+        minimalClose(context);
+        return 0;
+    case WM_CHAR:
+    case WM_SYSCHAR:
+    case WM_UNICHAR:
+    {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_CHAR)) return 0;
+
+        uint32_t codepoint = (uint32_t)wParam;
+        uint32_t mods = minimalGetKeyMods();
+
+        if (codepoint > 31)
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_CHAR, codepoint, 0, mods);
+
+        return 0;
+    }
+    case WM_KEYDOWN:
+    case WM_SYSKEYDOWN:
+    case WM_KEYUP:
+    case WM_SYSKEYUP:
+    {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_KEY)) return 0;
+
+        uint8_t action = (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN);
+        uint32_t keycode = (uint16_t)wParam;
+        uint32_t mods = minimalGetKeyMods();
+
+        if (minimalProcessKey(keycode, action))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_KEY, keycode, action, mods);
+
+        return 0;
+    }
+    case WM_LBUTTONDOWN:
+    case WM_RBUTTONDOWN:
+    case WM_MBUTTONDOWN:
+    case WM_XBUTTONDOWN:
+    case WM_LBUTTONUP:
+    case WM_RBUTTONUP:
+    case WM_MBUTTONUP:
+    case WM_XBUTTONUP:
+    {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_BUTTON))
+            return msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP;
+
+        uint32_t action = msg == WM_LBUTTONDOWN
+                        || msg == WM_RBUTTONDOWN
+                        || msg == WM_MBUTTONDOWN
+                        || msg == WM_XBUTTONDOWN;
+
+        uint16_t button = minimalGetMouseButton(msg, wParam);
+        int32_t x = MINIMAL_GET_X_LPARAM(lParam);
+        int32_t y = MINIMAL_GET_Y_LPARAM(lParam);
+
+        if (minimalProcessMouseButton(button, action))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_BUTTON, (button << 16) + action, x, y);
+
+        return msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP;
+    }
+    case WM_MOUSEMOVE:
+    {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_MOVED)) return 0;
+
+        // windows only reports the cursor leaving when asked to after it entered
+        if (!context->cursorTracked)
+        {
+            TRACKMOUSEEVENT track = { .cbSize = sizeof(track), .dwFlags = TME_LEAVE, .hwndTrack = hwnd };
+            context->cursorTracked = TrackMouseEvent(&track) != 0;
+        }
+
+        int32_t x = MINIMAL_GET_X_LPARAM(lParam);
+        int32_t y = MINIMAL_GET_Y_LPARAM(lParam);
+
+        if (minimalProcessMouseMove((float)x, (float)y))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_MOVED, 0, x, y);
+        return 0;
+    }
+    case WM_MOUSELEAVE:
+    {
+        context->cursorTracked = 0;
+        minimalResetMouseDelta(context);
+        return 0;
+    }
+    case WM_INPUT:
+    {
+        RAWINPUT raw;
+        UINT size = sizeof(raw);
+
+        if (MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_RAW)
+            && GetRawInputData((HRAWINPUT)lParam, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) != (UINT)-1
+            && raw.header.dwType == RIM_TYPEMOUSE && !(raw.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE))
+        {
+            int32_t x = (int32_t)raw.data.mouse.lLastX * MINIMAL_MOUSE_RAW_ONE;
+            int32_t y = (int32_t)raw.data.mouse.lLastY * MINIMAL_MOUSE_RAW_ONE;
+
+            if (minimalProcessMouseRaw(x, y))
+                minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_RAW, 0, x, y);
+        }
+
+        // the raw input buffer is released by the default procedure
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_SETCURSOR:
+    {
+        if (context->pointerLocked && LOWORD(lParam) == HTCLIENT)
+        {
+            SetCursor(NULL);
+            return TRUE;
+        }
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_SETFOCUS:
+    case WM_MOVE:
+    {
+        // the clip rectangle is in screen coordinates and does not survive focus changes
+        if (context->pointerLocked && GetFocus() == hwnd)
+            minimalWindowsClipCursor(context);
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_KILLFOCUS:
+    {
+        if (context->pointerLocked) ClipCursor(NULL);
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_MOUSEWHEEL:
+    {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
+
+        int32_t scroll = MINIMAL_GET_SCROLL(wParam);
+
+        minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, scroll);
+        return 0;
+    }
+    case WM_MOUSEHWHEEL:
+    {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
+
+        int32_t scroll = MINIMAL_GET_SCROLL(wParam);
+
+        minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, scroll, 0);
+        return 0;
+    }
+    case WM_SIZE:
+    {
+        /*
+        uint8_t minimized = wParam == SIZE_MINIMIZED;
+        uint8_t maximized = wParam == SIZE_MAXIMIZED || (_current_context->maximized && wParam != SIZE_RESTORED);
+
+        if (_current_context->minimized != minimized)
+        {
+            _current_context->minimized = minimized;
+            minimalDispatchEvent(event_handler, MINIMAL_EVENT_WINDOW_MINIMIZE, minimized, 0, 0);
+        }
+
+        if (_current_context->maximized != maximized)
+        {
+            _current_context->maximized = maximized;
+            minimalDispatchEvent(event_handler, MINIMAL_EVENT_WINDOW_MAXIMIZE, maximized, 0, 0);
+        }
+        */
+
+        int32_t width  = LOWORD(lParam);
+        int32_t height = HIWORD(lParam);
+
+        context->width = (uint32_t)width;
+        context->height = (uint32_t)height;
+
+        if (context->pointerLocked && GetFocus() == hwnd)
+            minimalWindowsClipCursor(context);
+
+        if (MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_WINDOW_SIZE))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_WINDOW_SIZE, 0, width, height);
+        return 0;
+    }
+    default: return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+}
+
+/* --------------------------| framebuffer |----------------------------- */
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    // negative height for a top-down dib
+    BITMAPINFO bmi = { 0 };
+    bmi.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth       = (LONG)w;
+    bmi.bmiHeader.biHeight      = -(LONG)h;
+    bmi.bmiHeader.biPlanes      = 1;
+    bmi.bmiHeader.biBitCount    = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    window->framebufferDC = CreateCompatibleDC(NULL);
+    if (!window->framebufferDC)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create framebuffer device context");
+        return NULL;
+    }
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        MinimalWin32Framebuffer* fb = &window->framebuffers[i];
+        fb->bitmap = CreateDIBSection(window->framebufferDC, &bmi, DIB_RGB_COLORS, (void**)&fb->pixels, NULL, 0);
+        if (!fb->bitmap)
+        {
+            MINIMAL_ERROR("[Platform] Failed to create framebuffer");
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+    }
+
+    window->framebufferWidth = w;
+    window->framebufferHeight = h;
+    window->framebufferIndex = 0;
+
+    return window->framebuffers[0].pixels;
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        if (window->framebuffers[i].bitmap)
+            DeleteObject(window->framebuffers[i].bitmap);
+    }
+    memset(window->framebuffers, 0, sizeof(window->framebuffers));
+
+    if (window->framebufferDC)
+    {
+        DeleteDC(window->framebufferDC);
+        window->framebufferDC = NULL;
+    }
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    MinimalWin32Framebuffer* current = &window->framebuffers[window->framebufferIndex];
+    if (!current->bitmap) return NULL;
+
+    // gdi has no shared memory present, blitting the dib section is the one copy left
+    HDC dc = GetDC(window->handle);
+    HGDIOBJ previous = SelectObject(window->framebufferDC, current->bitmap);
+
+    BitBlt(dc, 0, 0, (int)window->framebufferWidth, (int)window->framebufferHeight, window->framebufferDC, 0, 0, SRCCOPY);
+
+    SelectObject(window->framebufferDC, previous);
+    ReleaseDC(window->handle, dc);
+
+    // make sure gdi is done with the bitmap before it is written again
+    GdiFlush();
+
+    window->framebufferIndex = (window->framebufferIndex + 1) % MINIMAL_FRAMEBUFFER_COUNT;
+    return window->framebuffers[window->framebufferIndex].pixels;
+}
+
+/* --------------------------| wgl |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_WGL
+
+/* Accepted as an attribute name in <*attribList> */
+#define WGL_CONTEXT_MAJOR_VERSION_ARB               0x2091
+#define WGL_CONTEXT_MINOR_VERSION_ARB               0x2092
+#define WGL_CONTEXT_FLAGS_ARB                       0x2094
+#define WGL_CONTEXT_PROFILE_MASK_ARB                0x9126
+
+/* Accepted as bits in the attribute value for WGL_CONTEXT_FLAGS in <*attribList> */
+#define WGL_CONTEXT_DEBUG_BIT_ARB                   0x0001
+#define WGL_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB      0x0002
+
+#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB            0x00000001
+#define WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB   0x00000002
+
+// See https://www.opengl.org/registry/specs/ARB/wgl_pixel_format.txt for all values
+#define WGL_DRAW_TO_WINDOW_ARB                      0x2001
+#define WGL_ACCELERATION_ARB                        0x2003
+#define WGL_SUPPORT_OPENGL_ARB                      0x2010
+#define WGL_DOUBLE_BUFFER_ARB                       0x2011
+#define WGL_PIXEL_TYPE_ARB                          0x2013
+#define WGL_COLOR_BITS_ARB                          0x2014
+#define WGL_DEPTH_BITS_ARB                          0x2022
+#define WGL_STENCIL_BITS_ARB                        0x2023
+
+#define WGL_FULL_ACCELERATION_ARB                   0x2027
+#define WGL_TYPE_RGBA_ARB                           0x202B
+
+
+// WGL extension pointer typedefs
+typedef BOOL(WINAPI* wglSwapIntervalEXT_T)(int);
+typedef BOOL(WINAPI* wglChoosePixelFormatARB_T)(HDC, const int*, const float*, UINT, int*, UINT*);
+typedef HGLRC(WINAPI* wglCreateContextAttribsARB_T)(HDC, HGLRC, const int*);
+
+static wglCreateContextAttribsARB_T _wglCreateContextAttrARB = NULL;
+static wglSwapIntervalEXT_T         _wglSwapIntervalEXT = NULL;
+static wglChoosePixelFormatARB_T    _wglChoosePixelFormatARB = NULL;
+
+static HMODULE glModule = NULL;
+static uint8_t _wglInitialized = 0;
+
+/* loads the wgl extensions through a dummy context, which is deleted again */
+static uint8_t minimalWGLLoadExtensions(HWND helperWnd)
+{
+    MSG msg;
+    while (PeekMessageW(&msg, helperWnd, 0, 0, PM_REMOVE))
+    {
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+
+    HDC dc = GetDC(helperWnd);
+
+    PIXELFORMATDESCRIPTOR pfd = {
+        .nSize = sizeof(pfd),
+        .nVersion = 1,
+        .dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER,
+        .iPixelType = PFD_TYPE_RGBA,
+        .cColorBits = 24,
+    };
+
+    if (!SetPixelFormat(dc, ChoosePixelFormat(dc, &pfd), &pfd))
+    {
+        MINIMAL_ERROR("[WGL] Failed to set pixel format for dummy context");
+        ReleaseDC(helperWnd, dc);
+        return MINIMAL_FAIL;
+    }
+
+    HGLRC rc = wglCreateContext(dc);
+    if (!rc)
+    {
+        MINIMAL_ERROR("[WGL] Failed to create dummy context");
+        ReleaseDC(helperWnd, dc);
+        return MINIMAL_FAIL;
+    }
+
+    HDC   pdc = wglGetCurrentDC();
+    HGLRC prc = wglGetCurrentContext();
+
+    if (!wglMakeCurrent(dc, rc))
+    {
+        MINIMAL_ERROR("[WGL] Failed to make dummy context current");
+        wglMakeCurrent(pdc, prc);
+        wglDeleteContext(rc);
+        ReleaseDC(helperWnd, dc);
+        return MINIMAL_FAIL;
+    }
+
+    _wglCreateContextAttrARB =  (wglCreateContextAttribsARB_T)wglGetProcAddress("wglCreateContextAttribsARB");
+    _wglSwapIntervalEXT =       (wglSwapIntervalEXT_T)wglGetProcAddress("wglSwapIntervalEXT");
+    _wglChoosePixelFormatARB =  (wglChoosePixelFormatARB_T)wglGetProcAddress("wglChoosePixelFormatARB");
+
+    wglMakeCurrent(pdc, prc);
+    wglDeleteContext(rc);
+    ReleaseDC(helperWnd, dc);
+
+    // render contexts are only created through the arb extensions
+    if (!_wglCreateContextAttrARB || !_wglChoosePixelFormatARB)
+    {
+        MINIMAL_ERROR("[WGL] Driver does not support WGL_ARB_create_context and WGL_ARB_pixel_format");
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalWGLInit()
+{
+    // load opengl library
+    glModule = LoadLibraryA("opengl32.dll");
+    if (!glModule)
+    {
+        MINIMAL_ERROR("[WGL] Failed to load opengl32.dll");
+        return MINIMAL_FAIL;
+    }
+
+    // create helper window
+    HINSTANCE instance = GetModuleHandleW(NULL);
+    LPCWSTR className = MINIMAL_WNDCLASSNAME;
+    DWORD exStyle = WS_EX_OVERLAPPEDWINDOW;
     DWORD style = WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
     HWND helperWnd = CreateWindowExW(exStyle, className, NULL, style, 0, 0, 1, 1, 0, 0, instance, 0);
 
-    if (!helperWnd)
+    if (!helperWnd)
+    {
+        MINIMAL_ERROR("[WGL] Failed to create helper window");
+        minimalWGLTerminate();
+        return MINIMAL_FAIL;
+    }
+
+    uint8_t result = minimalWGLLoadExtensions(helperWnd);
+
+    // destroy helper window
+    if (!DestroyWindow(helperWnd))
+        MINIMAL_WARN("[WGL] Failed to destroy helper window");
+
+    // nothing is kept from a failed attempt, the next window tries again
+    if (!result)
+    {
+        minimalWGLTerminate();
+        return MINIMAL_FAIL;
+    }
+
+    _wglInitialized = 1;
+    return MINIMAL_OK;
+}
+
+void minimalWGLTerminate()
+{
+    if (glModule)
+        FreeLibrary(glModule);
+
+    glModule = NULL;
+    _wglInitialized = 0;
+
+    _wglCreateContextAttrARB = NULL;
+    _wglSwapIntervalEXT = NULL;
+    _wglChoosePixelFormatARB = NULL;
+}
+
+HGLRC minimalCreateRenderContext(HDC dc)
+{
+    // the dummy context is only paid for once a window actually needs gl
+    if (!_wglInitialized && !minimalWGLInit())
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize WGL");
+        return NULL;
+    }
+
+    int pfAttribs[] = {
+        WGL_DRAW_TO_WINDOW_ARB,     1,
+        WGL_SUPPORT_OPENGL_ARB,     1,
+        WGL_DOUBLE_BUFFER_ARB,      1,
+        WGL_ACCELERATION_ARB,       WGL_FULL_ACCELERATION_ARB,
+        WGL_PIXEL_TYPE_ARB,         WGL_TYPE_RGBA_ARB,
+        WGL_COLOR_BITS_ARB,         32,
+        WGL_DEPTH_BITS_ARB,         24,
+        WGL_STENCIL_BITS_ARB,       8,
+        0
+    };
+
+    int format;
+    UINT formatCount;
+    _wglChoosePixelFormatARB(dc, pfAttribs, 0, 1, &format, &formatCount);
+    if (!formatCount)
+    {
+        MINIMAL_ERROR("[WGL] Could not find a suitable pixel format");
+        return NULL;
+    }
+
+    PIXELFORMATDESCRIPTOR pfd;
+    if (!DescribePixelFormat(dc, format, sizeof(pfd), &pfd))
+    {
+        MINIMAL_ERROR("[WGL] Failed to retrieve PFD");
+        return NULL;
+    }
+
+    if (!SetPixelFormat(dc, format, &pfd))
+    {
+        MINIMAL_ERROR("[WGL] Failed to set pixel format");
+        return NULL;
+    }
+
+    int glAttribs[] = {
+        WGL_CONTEXT_MAJOR_VERSION_ARB,  windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION],
+        WGL_CONTEXT_MINOR_VERSION_ARB,  windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION],
+        WGL_CONTEXT_PROFILE_MASK_ARB,   WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+#ifdef _DEBUG
+        WGL_CONTEXT_FLAGS_ARB,          WGL_CONTEXT_DEBUG_BIT_ARB,
+#endif // _DEBUG
+        0,
+    };
+
+    HGLRC rc = _wglCreateContextAttrARB(dc, 0, glAttribs);
+    if (!rc)
+    {
+        MINIMAL_ERROR("[WGL] Failed to create render context");
+        return MINIMAL_FAIL;
+    }
+
+    if (!wglMakeCurrent(dc, rc))
+    {
+        MINIMAL_ERROR("[WGL] Failed to make render context current");
+        return MINIMAL_FAIL;
+    }
+
+    return rc;
+}
+
+void* minimalGetGLProcAddress(const char* name)
+{
+    void* p = (void*)wglGetProcAddress(name);
+    if (p) return p;
+
+    return (void*)GetProcAddress(glModule, name);;
+}
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    SwapBuffers(context->deviceContext);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    if (_wglSwapIntervalEXT) _wglSwapIntervalEXT(interval);
+}
+
+#endif // MINIMAL_CONTEXT_WGL
+
+/* --------------------------| egl |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_EGL
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    minimalEGLSwapInterval(interval);
+}
+
+#endif // MINIMAL_CONTEXT_EGL
+
+#endif // MINIMAL_PLATFORM_WINDOWS
+
+
+#ifdef MINIMAL_PLATFORM_X11
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/Xresource.h>
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/XInput2.h>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/eventfd.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+#if !defined(MINIMAL_NO_CONTEXT) && !defined(MINIMAL_CONTEXT_EGL)
+#define MINIMAL_CONTEXT_GLX
+#endif
+
+#ifdef MINIMAL_CONTEXT_GLX
+#include <GL/glx.h>
+#elif defined(MINIMAL_CONTEXT_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_X11_KHR
+#define EGL_PLATFORM_X11_KHR    0x31D5
+#endif
+#endif
+
+static Display* _minimalDisplay = NULL;
+static int      _minimalScreen = 0;
+static Window   _minimalRoot = None;
+
+static Atom _minimalWMProtocols;
+static Atom _minimalWMDeleteWindow;
+static Atom _minimalNetWMName;
+static Atom _minimalNetWMState;
+static Atom _minimalNetWMStateMaxVert;
+static Atom _minimalNetWMStateMaxHorz;
+static Atom _minimalUTF8String;
+
+/* maps native window handles to MinimalWindow */
+static XContext _minimalWindowContext;
+
+static uint64_t _minimalTimerOffset = 0;
+static float    _minimalContentScale = 1.0f;
+
+/* signalled by minimalWakeWindow to interrupt minimalWaitWindowEvents */
+static int      _minimalWakeFd = -1;
+
+/* event type of XShmCompletionEvent, -1 without MIT-SHM */
+static int      _minimalShmCompletion = -1;
+
+/* major opcode of XInput2, -1 without it */
+static int      _minimalXIOpcode = -1;
+
+/* raw motion is selected on the root window and reported to the last window enabling it */
+static MinimalWindow* _minimalRawWindow = NULL;
+
+/* blank cursor shown while the pointer is locked */
+static Cursor   _minimalHiddenCursor = None;
+
+/* X11 keycode to MINIMAL_KEY_* */
+static MinimalKeycode _minimalKeycodes[256];
+
+/* set by minimalX11ErrorHandler, requests failing asynchronously are checked by syncing with it installed */
+static uint8_t  _minimalX11Error = 0;
+
+static int minimalX11ErrorHandler(Display* display, XErrorEvent* event)
+{
+    _minimalX11Error = 1;
+    return 0;
+}
+
+static void minimalX11CreateKeyTable();
+static void minimalX11ProcessEvent(XEvent* event);
+
+typedef struct
+{
+    XImage*         image;
+    XShmSegmentInfo shm;
+    uint8_t         busy;
+} MinimalX11Framebuffer;
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+static uint8_t minimalGLXInit();
+static uint8_t minimalGLXChooseConfig(GLXFBConfig* config);
+static GLXContext minimalCreateRenderContext(Window handle, GLXFBConfig config);
+
+#endif
+
+uint8_t minimalPlatformInit()
+{
+    _minimalDisplay = XOpenDisplay(NULL);
+    if (!_minimalDisplay)
+    {
+        MINIMAL_ERROR("[Platform] Failed to open X display");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalScreen = DefaultScreen(_minimalDisplay);
+    _minimalRoot = RootWindow(_minimalDisplay, _minimalScreen);
+
+    _minimalWMProtocols =       XInternAtom(_minimalDisplay, "WM_PROTOCOLS", False);
+    _minimalWMDeleteWindow =    XInternAtom(_minimalDisplay, "WM_DELETE_WINDOW", False);
+    _minimalNetWMName =         XInternAtom(_minimalDisplay, "_NET_WM_NAME", False);
+    _minimalNetWMState =        XInternAtom(_minimalDisplay, "_NET_WM_STATE", False);
+    _minimalNetWMStateMaxVert = XInternAtom(_minimalDisplay, "_NET_WM_STATE_MAXIMIZED_VERT", False);
+    _minimalNetWMStateMaxHorz = XInternAtom(_minimalDisplay, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
+    _minimalUTF8String =        XInternAtom(_minimalDisplay, "UTF8_STRING", False);
+
+    _minimalWindowContext = XUniqueContext();
+
+    // only report a single press for held keys instead of release/press pairs
+    XkbSetDetectableAutoRepeat(_minimalDisplay, True, NULL);
+
+    minimalX11CreateKeyTable();
+
+    // shared memory images only work with a local server, attaching is checked per framebuffer
+    if (XShmQueryExtension(_minimalDisplay))
+        _minimalShmCompletion = XShmGetEventBase(_minimalDisplay) + ShmCompletion;
+
+    // raw motion comes from XInput 2.0 and is only available with it
+    int opcode, xiEvent, xiError, xiMajor = 2, xiMinor = 0;
+    if (XQueryExtension(_minimalDisplay, "XInputExtension", &opcode, &xiEvent, &xiError)
+        && XIQueryVersion(_minimalDisplay, &xiMajor, &xiMinor) == Success)
+        _minimalXIOpcode = opcode;
+
+    // content scale from the desktop's Xft.dpi setting
+    XrmInitialize();
+    char* resources = XResourceManagerString(_minimalDisplay);
+    if (resources)
+    {
+        XrmDatabase db = XrmGetStringDatabase(resources);
+        if (db)
+        {
+            char* type = NULL;
+            XrmValue value;
+            if (XrmGetResource(db, "Xft.dpi", "Xft.Dpi", &type, &value) && type && strcmp(type, "String") == 0)
+                _minimalContentScale = (float)atof(value.addr) / 96.0f;
+            XrmDestroyDatabase(db);
+        }
+    }
+
+    _minimalWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_minimalWakeFd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create wakeup eventfd");
+        return MINIMAL_FAIL;
+    }
+
+    // init time
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        MINIMAL_ERROR("[Platform] Monotonic clock is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalTimerOffset = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    minimalInitTicks();
+
+#ifdef MINIMAL_CONTEXT_GLX
+    // init glx
+    if (!minimalGLXInit())
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize GLX");
+        return MINIMAL_FAIL;
+    }
+#elif defined(MINIMAL_CONTEXT_EGL)
+    // init egl on top of the xlib display
+    if (!minimalEGLInit(EGL_PLATFORM_X11_KHR, _minimalDisplay))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+#ifdef MINIMAL_CONTEXT_EGL
+    minimalEGLTerminate();
+#endif
+
+    if (_minimalWakeFd >= 0)
+    {
+        close(_minimalWakeFd);
+        _minimalWakeFd = -1;
+    }
+
+    if (_minimalDisplay)
+    {
+        if (_minimalHiddenCursor != None)
+            XFreeCursor(_minimalDisplay, _minimalHiddenCursor);
+        _minimalHiddenCursor = None;
+
+        XCloseDisplay(_minimalDisplay);
+        _minimalDisplay = NULL;
+    }
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+struct MinimalWindow
+{
+    Window      handle;
+    Colormap    colormap;
+
+#ifdef MINIMAL_CONTEXT_GLX
+    GLXContext  renderContext;
+#elif defined(MINIMAL_CONTEXT_EGL)
+    MinimalEGLContext egl;
+#endif
+
+    Visual* visual;
+    int     depth;
+
+    GC      gc;
+    MinimalX11Framebuffer framebuffers[MINIMAL_FRAMEBUFFER_COUNT];
+    uint32_t framebufferIndex;
+    uint8_t  framebufferShm;
+
+    uint32_t width;
+    uint32_t height;
+
+    uint8_t shouldClose;
+
+    /* raw motion is only reported while one of these is set */
+    uint8_t focused;
+    uint8_t pointerLocked;
+
+    uint32_t eventMask;
+};
+
+/* the input the server has to send for the enabled event types */
+static long minimalX11InputMask(uint32_t mask)
+{
+    long input = StructureNotifyMask | FocusChangeMask;
+
+    if (mask & (MINIMAL_EVENT_MASK(MINIMAL_EVENT_KEY) | MINIMAL_EVENT_MASK(MINIMAL_EVENT_CHAR)))
+        input |= KeyPressMask | KeyReleaseMask;
+    if (mask & (MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_BUTTON) | MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_SCROLLED)))
+        input |= ButtonPressMask | ButtonReleaseMask;
+    if (mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_MOVED))
+        input |= PointerMotionMask | LeaveWindowMask;
+
+    return input;
+}
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    Visual* visual = DefaultVisual(_minimalDisplay, _minimalScreen);
+    int depth = DefaultDepth(_minimalDisplay, _minimalScreen);
+
+#ifndef MINIMAL_NO_CONTEXT
+    uint8_t noApi = windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API;
+#endif
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+    GLXFBConfig config = NULL;
+    if (!noApi && !minimalGLXChooseConfig(&config))
+    {
+        free(window);
+        return NULL;
+    }
+
+    XVisualInfo* vi = noApi ? NULL : glXGetVisualFromFBConfig(_minimalDisplay, config);
+    if (!noApi && !vi)
+    {
+        MINIMAL_ERROR("[GLX] Failed to retrieve visual for framebuffer config");
+        free(window);
+        return NULL;
+    }
+
+    if (vi)
+    {
+        visual = vi->visual;
+        depth = vi->depth;
+        XFree(vi);
+    }
+
+#endif
+
+    // create window
+    window->visual = visual;
+    window->depth = depth;
+    window->colormap = XCreateColormap(_minimalDisplay, _minimalRoot, visual, AllocNone);
+
+    XSetWindowAttributes wa = {
+        .colormap       = window->colormap,
+        .border_pixel   = 0,
+        .event_mask     = minimalX11InputMask(window->eventMask)
+    };
+
+    // failures are reported as an async error, the returned id is never zero
+    _minimalX11Error = 0;
+    int (*handler)(Display*, XErrorEvent*) = XSetErrorHandler(minimalX11ErrorHandler);
+
+    window->handle = XCreateWindow(_minimalDisplay, _minimalRoot, x, y, w, h, 0, depth, InputOutput, visual,
+                                   CWBorderPixel | CWColormap | CWEventMask, &wa);
+    XSync(_minimalDisplay, False);
+
+    XSetErrorHandler(handler);
+
+    if (_minimalX11Error)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create window");
+        window->handle = None;
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    XSaveContext(_minimalDisplay, window->handle, _minimalWindowContext, (XPointer)window);
+    XSetWMProtocols(_minimalDisplay, window->handle, &_minimalWMDeleteWindow, 1);
+
+    // window managers ignore the requested position without PPosition
+    XSizeHints* hints = XAllocSizeHints();
+    if (hints)
+    {
+        hints->flags = PPosition;
+        hints->x = x;
+        hints->y = y;
+        XSetWMNormalHints(_minimalDisplay, window->handle, hints);
+        XFree(hints);
+    }
+
+    minimalSetWindowTitle(window, title);
+
+    XMapWindow(_minimalDisplay, window->handle);
+    XFlush(_minimalDisplay);
+
+    window->width = w;
+    window->height = h;
+    window->shouldClose = 0;
+
+#ifndef MINIMAL_NO_CONTEXT
+    if (noApi) return window;
+#endif
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+    window->renderContext = minimalCreateRenderContext(window->handle, config);
+    if (!window->renderContext)
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    if (!minimalEGLCreateContext(&window->egl, (void*)(uintptr_t)window->handle, w, h, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    minimalDestroyFramebuffer(window);
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+    // destroy render context
+    if (window->renderContext)
+    {
+        if (glXGetCurrentContext() == window->renderContext && !glXMakeCurrent(_minimalDisplay, None, NULL))
+        {
+            MINIMAL_ERROR("[GLX] Failed to release render context");
+        }
+
+        glXDestroyContext(_minimalDisplay, window->renderContext);
+    }
+
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    minimalEGLDestroyContext(&window->egl);
+
+#endif
+
+    if (_minimalRawWindow == window)
+        minimalSetEventMask(window, window->eventMask & ~MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW));
+
+    minimalResetMouseDelta(window);
+
+    // destroy window
+    if (window->handle)
+    {
+        XDeleteContext(_minimalDisplay, window->handle, _minimalWindowContext);
+        XDestroyWindow(_minimalDisplay, window->handle);
+    }
+
+    if (window->colormap)
+        XFreeColormap(_minimalDisplay, window->colormap);
+
+    XFlush(_minimalDisplay);
+
+    free(window);
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    // all windows share one connection, events are routed to the window they belong to
+    minimalPollAllEvents();
+}
+
+void minimalPollAllEvents()
+{
+    while (XPending(_minimalDisplay))
+    {
+        XEvent event;
+        XNextEvent(_minimalDisplay, &event);
+        minimalX11ProcessEvent(&event);
+    }
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    int ms = -1;
+    if (timeout != MINIMAL_WAIT_INFINITE)
+    {
+        // rounded up so short waits do not turn into spins
+        uint64_t value = (timeout + 999999) / 1000000;
+        ms = value > INT_MAX ? INT_MAX : (int)value;
+    }
+
+    // events already buffered by xlib would not wake up poll
+    if (!XPending(_minimalDisplay))
+    {
+        struct pollfd fds[2] = {
+            { .fd = ConnectionNumber(_minimalDisplay), .events = POLLIN },
+            { .fd = _minimalWakeFd, .events = POLLIN }
+        };
+
+        if (poll(fds, 2, ms) > 0 && (fds[1].revents & POLLIN))
+        {
+            uint64_t value;
+            while (read(_minimalWakeFd, &value, sizeof(value)) > 0);
+        }
+    }
+
+    minimalPollWindowEvents(context);
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    // only fails if the counter is already full, which wakes the wait as well
+    uint64_t value = 1;
+    ssize_t result = write(_minimalWakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+static void minimalX11SelectRawMotion(uint8_t enable)
+{
+    unsigned char bits[XIMaskLen(XI_LASTEVENT)] = { 0 };
+    if (enable) XISetMask(bits, XI_RawMotion);
+
+    XIEventMask mask = { .deviceid = XIAllMasterDevices, .mask_len = sizeof(bits), .mask = bits };
+    XISelectEvents(_minimalDisplay, _minimalRoot, &mask, 1);
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+    XSelectInput(_minimalDisplay, window->handle, minimalX11InputMask(mask));
+
+    uint8_t raw = (mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW)) != 0;
+    if (raw && _minimalXIOpcode < 0)
+        MINIMAL_WARN("[Platform] Raw mouse motion needs XInput 2.0");
+
+    if (raw)                                _minimalRawWindow = window;
+    else if (_minimalRawWindow == window)   _minimalRawWindow = NULL;
+
+    if (_minimalXIOpcode >= 0)
+        minimalX11SelectRawMotion(_minimalRawWindow != NULL);
+
+    XFlush(_minimalDisplay);
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title)
+{
+    XStoreName(_minimalDisplay, context->handle, title);
+    XChangeProperty(_minimalDisplay, context->handle, _minimalNetWMName, _minimalUTF8String, 8,
+                    PropModeReplace, (const unsigned char*)title, (int)strlen(title));
+}
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window)
+{
+    XEvent event = { 0 };
+    event.xclient.type = ClientMessage;
+    event.xclient.window = window->handle;
+    event.xclient.message_type = _minimalNetWMState;
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = 1; /* _NET_WM_STATE_ADD */
+    event.xclient.data.l[1] = (long)_minimalNetWMStateMaxVert;
+    event.xclient.data.l[2] = (long)_minimalNetWMStateMaxHorz;
+    event.xclient.data.l[3] = 1; /* normal application */
+
+    XSendEvent(_minimalDisplay, _minimalRoot, False, SubstructureNotifyMask | SubstructureRedirectMask, &event);
+    XFlush(_minimalDisplay);
+}
+
+void minimalMinimize(MinimalWindow* window)
+{
+    XIconifyWindow(_minimalDisplay, window->handle, _minimalScreen);
+    XFlush(_minimalDisplay);
+}
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock)
+{
+    if (!lock)
+    {
+        window->pointerLocked = 0;
+        XUngrabPointer(_minimalDisplay, CurrentTime);
+        XUndefineCursor(_minimalDisplay, window->handle);
+        XFlush(_minimalDisplay);
+        return;
+    }
+
+    if (_minimalHiddenCursor == None)
+    {
+        char bits = 0;
+        XColor black = { 0 };
+        Pixmap pixmap = XCreateBitmapFromData(_minimalDisplay, _minimalRoot, &bits, 1, 1);
+        _minimalHiddenCursor = XCreatePixmapCursor(_minimalDisplay, pixmap, pixmap, &black, &black, 0, 0);
+        XFreePixmap(_minimalDisplay, pixmap);
+    }
+
+    XDefineCursor(_minimalDisplay, window->handle, _minimalHiddenCursor);
+
+    // confining the grab to the window keeps the pointer inside it, raw motion continues at the edges
+    int result = XGrabPointer(_minimalDisplay, window->handle, True, ButtonPressMask | ButtonReleaseMask | PointerMotionMask,
+                              GrabModeAsync, GrabModeAsync, window->handle, _minimalHiddenCursor, CurrentTime);
+    if (result != GrabSuccess)
+        MINIMAL_WARN("[Platform] Failed to grab the pointer");
+
+    window->pointerLocked = result == GrabSuccess;
+
+    XFlush(_minimalDisplay);
+}
+
+uint64_t minimalGetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t value = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    return value - _minimalTimerOffset;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    if (xscale) *xscale = _minimalContentScale;
+    if (yscale) *yscale = _minimalContentScale;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return (void*)(uintptr_t)window->handle;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return _minimalDisplay;
+}
+
+/* --------------------------| keyboard |-------------------------------- */
+#define MINIMAL_KEYSYM_INDEX(sym) ((sym) & 0xff)
+
+/* keysyms in the 0xff00 page (function, cursor, keypad and modifier keys) */
+static const MinimalKeycode _minimalKeysymsMisc[256] = {
+    [MINIMAL_KEYSYM_INDEX(XK_BackSpace)]    = MINIMAL_KEY_BACKSPACE,
+    [MINIMAL_KEYSYM_INDEX(XK_Tab)]          = MINIMAL_KEY_TAB,
+    [MINIMAL_KEYSYM_INDEX(XK_Return)]       = MINIMAL_KEY_ENTER,
+    [MINIMAL_KEYSYM_INDEX(XK_Pause)]        = MINIMAL_KEY_PAUSE,
+    [MINIMAL_KEYSYM_INDEX(XK_Scroll_Lock)]  = MINIMAL_KEY_SCROLL,
+    [MINIMAL_KEYSYM_INDEX(XK_Escape)]       = MINIMAL_KEY_ESCAPE,
+    [MINIMAL_KEYSYM_INDEX(XK_Henkan)]       = MINIMAL_KEY_CONVERT,
+    [MINIMAL_KEYSYM_INDEX(XK_Muhenkan)]     = MINIMAL_KEY_NONCONVERT,
+    [MINIMAL_KEYSYM_INDEX(XK_Home)]         = MINIMAL_KEY_HOME,
+    [MINIMAL_KEYSYM_INDEX(XK_Left)]         = MINIMAL_KEY_LEFT,
+    [MINIMAL_KEYSYM_INDEX(XK_Up)]           = MINIMAL_KEY_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_Right)]        = MINIMAL_KEY_RIGHT,
+    [MINIMAL_KEYSYM_INDEX(XK_Down)]         = MINIMAL_KEY_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_Page_Up)]      = MINIMAL_KEY_PAGE_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_Page_Down)]    = MINIMAL_KEY_PAGE_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_End)]          = MINIMAL_KEY_END,
+    [MINIMAL_KEYSYM_INDEX(XK_Select)]       = MINIMAL_KEY_SELECT,
+    [MINIMAL_KEYSYM_INDEX(XK_Print)]        = MINIMAL_KEY_SNAPSHOT,
+    [MINIMAL_KEYSYM_INDEX(XK_Execute)]      = MINIMAL_KEY_EXECUTE,
+    [MINIMAL_KEYSYM_INDEX(XK_Insert)]       = MINIMAL_KEY_INSERT,
+    [MINIMAL_KEYSYM_INDEX(XK_Menu)]         = MINIMAL_KEY_APPS,
+    [MINIMAL_KEYSYM_INDEX(XK_Help)]         = MINIMAL_KEY_HELP,
+    [MINIMAL_KEYSYM_INDEX(XK_Mode_switch)]  = MINIMAL_KEY_MODECHANGE,
+    [MINIMAL_KEYSYM_INDEX(XK_Num_Lock)]     = MINIMAL_KEY_NUMLOCK,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Enter)]     = MINIMAL_KEY_ENTER,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Home)]      = MINIMAL_KEY_HOME,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Left)]      = MINIMAL_KEY_LEFT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Up)]        = MINIMAL_KEY_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Right)]     = MINIMAL_KEY_RIGHT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Down)]      = MINIMAL_KEY_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Page_Up)]   = MINIMAL_KEY_PAGE_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Page_Down)] = MINIMAL_KEY_PAGE_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_End)]       = MINIMAL_KEY_END,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Insert)]    = MINIMAL_KEY_INSERT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Delete)]    = MINIMAL_KEY_DELETE,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Equal)]     = MINIMAL_KEY_NUMPAD_EQUAL,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Multiply)]  = MINIMAL_KEY_MULTIPLY,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Add)]       = MINIMAL_KEY_ADD,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Separator)] = MINIMAL_KEY_SEPARATOR,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Subtract)]  = MINIMAL_KEY_SUBTRACT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Decimal)]   = MINIMAL_KEY_DECIMAL,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Divide)]    = MINIMAL_KEY_DIVIDE,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_0)]         = MINIMAL_KEY_NUMPAD0,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_1)]         = MINIMAL_KEY_NUMPAD1,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_2)]         = MINIMAL_KEY_NUMPAD2,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_3)]         = MINIMAL_KEY_NUMPAD3,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_4)]         = MINIMAL_KEY_NUMPAD4,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_5)]         = MINIMAL_KEY_NUMPAD5,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_6)]         = MINIMAL_KEY_NUMPAD6,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_7)]         = MINIMAL_KEY_NUMPAD7,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_8)]         = MINIMAL_KEY_NUMPAD8,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_9)]         = MINIMAL_KEY_NUMPAD9,
+    [MINIMAL_KEYSYM_INDEX(XK_F1)]           = MINIMAL_KEY_F1,
+    [MINIMAL_KEYSYM_INDEX(XK_F2)]           = MINIMAL_KEY_F2,
+    [MINIMAL_KEYSYM_INDEX(XK_F3)]           = MINIMAL_KEY_F3,
+    [MINIMAL_KEYSYM_INDEX(XK_F4)]           = MINIMAL_KEY_F4,
+    [MINIMAL_KEYSYM_INDEX(XK_F5)]           = MINIMAL_KEY_F5,
+    [MINIMAL_KEYSYM_INDEX(XK_F6)]           = MINIMAL_KEY_F6,
+    [MINIMAL_KEYSYM_INDEX(XK_F7)]           = MINIMAL_KEY_F7,
+    [MINIMAL_KEYSYM_INDEX(XK_F8)]           = MINIMAL_KEY_F8,
+    [MINIMAL_KEYSYM_INDEX(XK_F9)]           = MINIMAL_KEY_F9,
+    [MINIMAL_KEYSYM_INDEX(XK_F10)]          = MINIMAL_KEY_F10,
+    [MINIMAL_KEYSYM_INDEX(XK_F11)]          = MINIMAL_KEY_F11,
+    [MINIMAL_KEYSYM_INDEX(XK_F12)]          = MINIMAL_KEY_F12,
+    [MINIMAL_KEYSYM_INDEX(XK_F13)]          = MINIMAL_KEY_F13,
+    [MINIMAL_KEYSYM_INDEX(XK_F14)]          = MINIMAL_KEY_F14,
+    [MINIMAL_KEYSYM_INDEX(XK_F15)]          = MINIMAL_KEY_F15,
+    [MINIMAL_KEYSYM_INDEX(XK_F16)]          = MINIMAL_KEY_F16,
+    [MINIMAL_KEYSYM_INDEX(XK_F17)]          = MINIMAL_KEY_F17,
+    [MINIMAL_KEYSYM_INDEX(XK_F18)]          = MINIMAL_KEY_F18,
+    [MINIMAL_KEYSYM_INDEX(XK_F19)]          = MINIMAL_KEY_F19,
+    [MINIMAL_KEYSYM_INDEX(XK_F20)]          = MINIMAL_KEY_F20,
+    [MINIMAL_KEYSYM_INDEX(XK_F21)]          = MINIMAL_KEY_F21,
+    [MINIMAL_KEYSYM_INDEX(XK_F22)]          = MINIMAL_KEY_F22,
+    [MINIMAL_KEYSYM_INDEX(XK_F23)]          = MINIMAL_KEY_F23,
+    [MINIMAL_KEYSYM_INDEX(XK_F24)]          = MINIMAL_KEY_F24,
+    [MINIMAL_KEYSYM_INDEX(XK_Shift_L)]      = MINIMAL_KEY_SHIFT,
+    [MINIMAL_KEYSYM_INDEX(XK_Shift_R)]      = MINIMAL_KEY_SHIFT,
+    [MINIMAL_KEYSYM_INDEX(XK_Control_L)]    = MINIMAL_KEY_CONTROL,
+    [MINIMAL_KEYSYM_INDEX(XK_Control_R)]    = MINIMAL_KEY_CONTROL,
+    [MINIMAL_KEYSYM_INDEX(XK_Caps_Lock)]    = MINIMAL_KEY_CAPITAL,
+    [MINIMAL_KEYSYM_INDEX(XK_Alt_L)]        = MINIMAL_KEY_ALT,
+    [MINIMAL_KEYSYM_INDEX(XK_Alt_R)]        = MINIMAL_KEY_ALT,
+    [MINIMAL_KEYSYM_INDEX(XK_Super_L)]      = MINIMAL_KEY_LCOMMAND,
+    [MINIMAL_KEYSYM_INDEX(XK_Super_R)]      = MINIMAL_KEY_RCOMMAND,
+    [MINIMAL_KEYSYM_INDEX(XK_Delete)]       = MINIMAL_KEY_DELETE,
+};
+
+/* printable keysyms in the latin-1 page that have a MINIMAL_KEY_* */
+static const MinimalKeycode _minimalKeysymsLatin1[128] = {
+    [XK_space]      = MINIMAL_KEY_SPACE,
+    [XK_semicolon]  = MINIMAL_KEY_SEMICOLON,
+    [XK_equal]      = MINIMAL_KEY_PLUS,
+    [XK_comma]      = MINIMAL_KEY_COMMA,
+    [XK_minus]      = MINIMAL_KEY_MINUS,
+    [XK_period]     = MINIMAL_KEY_PERIOD,
+    [XK_slash]      = MINIMAL_KEY_SLASH,
+    [XK_grave]      = MINIMAL_KEY_GRAVE,
+};
+
+static MinimalKeycode minimalX11TranslateKeysym(KeySym sym)
+{
+    MinimalKeycode key = 0;
+
+    if (sym >= XK_0 && sym <= XK_9)                 key = (MinimalKeycode)(MINIMAL_KEY_0 + (sym - XK_0));
+    else if (sym >= XK_A && sym <= XK_Z)            key = (MinimalKeycode)(MINIMAL_KEY_A + (sym - XK_A));
+    else if (sym >= XK_a && sym <= XK_z)            key = (MinimalKeycode)(MINIMAL_KEY_A + (sym - XK_a));
+    else if (sym < 0x80)                            key = _minimalKeysymsLatin1[sym];
+    else if ((sym & 0xff00) == 0xff00)              key = _minimalKeysymsMisc[MINIMAL_KEYSYM_INDEX(sym)];
+
+    return key ? key : MINIMAL_KEY_UNKNOWN;
+}
+
+static uint8_t minimalX11IsKeypadKeysym(KeySym sym)
+{
+    return sym >= XK_KP_Space && sym <= XK_KP_Equal;
+}
+
+/*
+ * Translating keysyms on every event would cost a round of lookups per key,
+ * so the table from X11 keycodes to MINIMAL_KEY_* is built once here and
+ * events only index into it.
+ */
+static void minimalX11CreateKeyTable()
+{
+    for (int i = 0; i < 256; ++i)
+        _minimalKeycodes[i] = MINIMAL_KEY_UNKNOWN;
+
+    int min = 0, max = 0, width = 0;
+    XDisplayKeycodes(_minimalDisplay, &min, &max);
+
+    KeySym* keysyms = XGetKeyboardMapping(_minimalDisplay, (KeyCode)min, max - min + 1, &width);
+    if (!keysyms) return;
+
+    for (int code = min; code <= max && code < 256; ++code)
+    {
+        const KeySym* syms = keysyms + (code - min) * width;
+
+        // keypad keys report their navigation keysym first, prefer the numlock level
+        if (width > 1 && minimalX11IsKeypadKeysym(syms[1]))
+            _minimalKeycodes[code] = minimalX11TranslateKeysym(syms[1]);
+        else
+            _minimalKeycodes[code] = minimalX11TranslateKeysym(syms[0]);
+    }
+
+    XFree(keysyms);
+}
+
+static uint32_t minimalX11GetCodepoint(KeySym sym)
+{
+    // latin-1 keysyms match their codepoint
+    if ((sym >= 0x20 && sym <= 0x7e) || (sym >= 0xa0 && sym <= 0xff))
+        return (uint32_t)sym;
+
+    // unicode keysyms
+    if ((sym & 0xff000000) == 0x01000000)
+        return (uint32_t)(sym & 0x00ffffff);
+
+    return 0;
+}
+
+static uint32_t minimalX11GetKeyMods(unsigned int state)
+{
+    uint32_t mods = 0;
+    if (state & ShiftMask)      mods |= MINIMAL_KEY_MOD_SHIFT;
+    if (state & ControlMask)    mods |= MINIMAL_KEY_MOD_CONTROL;
+    if (state & Mod1Mask)       mods |= MINIMAL_KEY_MOD_ALT;
+    if (state & Mod4Mask)       mods |= MINIMAL_KEY_MOD_COMMAND;
+    if (state & LockMask)       mods |= MINIMAL_KEY_MOD_CAPS_LOCK;
+    if (state & Mod2Mask)       mods |= MINIMAL_KEY_MOD_NUM_LOCK;
+    return mods;
+}
+
+static MinimalMouseButton minimalX11GetMouseButton(unsigned int button)
+{
+    if (button == Button1)  return MINIMAL_MOUSE_BUTTON_LEFT;
+    if (button == Button2)  return MINIMAL_MOUSE_BUTTON_MIDDLE;
+    if (button == Button3)  return MINIMAL_MOUSE_BUTTON_RIGHT;
+
+    // buttons 4 to 7 are the scroll wheels, extra buttons start at 8
+    if (button >= 8)        return (MinimalMouseButton)(MINIMAL_MOUSE_BUTTON_4 + (button - 8));
+    return MINIMAL_MOUSE_BUTTON_UNKNOWN;
+}
+
+static void minimalX11ProcessRawMotion(MinimalWindow* context, const XIRawEvent* raw)
+{
+    if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_RAW)) return;
+
+    // raw values are packed, only the valuators set in the mask are present
+    const double* values = raw->raw_values;
+    double dx = 0.0, dy = 0.0;
+    if (raw->valuators.mask_len > 0 && XIMaskIsSet(raw->valuators.mask, 0)) dx = *values++;
+    if (raw->valuators.mask_len > 0 && XIMaskIsSet(raw->valuators.mask, 1)) dy = *values;
+
+    int32_t x = (int32_t)(dx * MINIMAL_MOUSE_RAW_ONE);
+    int32_t y = (int32_t)(dy * MINIMAL_MOUSE_RAW_ONE);
+
+    minimalSetEventTime(minimalRebaseEventTime((uint32_t)raw->time));
+
+    if (minimalProcessMouseRaw(x, y))
+        minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_RAW, 0, x, y);
+}
+
+static void minimalX11ProcessEvent(XEvent* event)
+{
+    // raw motion is reported for the root window, not the one that asked for it
+    if (event->type == GenericEvent)
+    {
+        if (event->xcookie.extension == _minimalXIOpcode && XGetEventData(_minimalDisplay, &event->xcookie))
+        {
+            // the root window sees all motion, drop it while the window is in the background
+            MinimalWindow* raw = _minimalRawWindow;
+            if (event->xcookie.evtype == XI_RawMotion && raw && (raw->focused || raw->pointerLocked))
+                minimalX11ProcessRawMotion(raw, (const XIRawEvent*)event->xcookie.data);
+            XFreeEventData(_minimalDisplay, &event->xcookie);
+        }
+        return;
+    }
+
+    if (event->type == MappingNotify)
+    {
+        if (event->xmapping.request == MappingKeyboard)
+        {
+            XRefreshKeyboardMapping(&event->xmapping);
+            minimalX11CreateKeyTable();
+        }
+        return;
+    }
+
+    MinimalWindow* context = NULL;
+    if (XFindContext(_minimalDisplay, event->xany.window, _minimalWindowContext, (XPointer*)&context) != 0 || !context)
+        return;
+
+    // extension events have no fixed type
+    if (event->type == _minimalShmCompletion)
+    {
+        XShmCompletionEvent* completion = (XShmCompletionEvent*)event;
+        for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+        {
+            if (context->framebuffers[i].image && context->framebuffers[i].shm.shmseg == completion->shmseg)
+                context->framebuffers[i].busy = 0;
+        }
+        return;
+    }
+
+    // only input events carry a server timestamp
+    Time time = 0;
+    switch (event->type)
+    {
+    case KeyPress:
+    case KeyRelease:    time = event->xkey.time; break;
+    case ButtonPress:
+    case ButtonRelease: time = event->xbutton.time; break;
+    case MotionNotify:  time = event->xmotion.time; break;
+    }
+    minimalSetEventTime(time ? minimalRebaseEventTime((uint32_t)time) : 0);
+
+    switch (event->type)
+    {
+    case ClientMessage:
+    {
+        if (event->xclient.message_type == _minimalWMProtocols
+            && (Atom)event->xclient.data.l[0] == _minimalWMDeleteWindow)
+            minimalClose(context);
+        return;
+    }
+    case KeyPress:
+    case KeyRelease:
+    {
+        uint8_t action = event->type == KeyPress;
+        uint8_t keys = MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_KEY);
+        uint8_t chars = action && MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_CHAR);
+        if (!keys && !chars) return;
+
+        MinimalKeycode keycode = _minimalKeycodes[event->xkey.keycode & 0xff];
+        uint32_t mods = minimalX11GetKeyMods(event->xkey.state);
+
+        if (keys && minimalProcessKey(keycode, action))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_KEY, (uint32_t)keycode, action, mods);
+
+        if (chars)
+        {
+            char buffer[16];
+            KeySym sym = NoSymbol;
+            XLookupString(&event->xkey, buffer, sizeof(buffer), &sym, NULL);
+
+            uint32_t codepoint = minimalX11GetCodepoint(sym);
+            if (codepoint > 31)
+                minimalDispatchWindowEvent(context, MINIMAL_EVENT_CHAR, codepoint, 0, mods);
+        }
+        return;
+    }
+    case ButtonPress:
+    case ButtonRelease:
+    {
+        uint32_t action = event->type == ButtonPress;
+        unsigned int xbutton = event->xbutton.button;
+
+        if (xbutton >= 4 && xbutton <= 7)
+        {
+            // scroll wheels only report presses
+            if (!action || !MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_SCROLLED)) return;
+
+            int32_t scroll = (xbutton == 4 || xbutton == 7) ? 1 : -1;
+            if (xbutton <= 5)   minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, scroll);
+            else                minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, scroll, 0);
+            return;
+        }
+
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_BUTTON)) return;
+
+        MinimalMouseButton button = minimalX11GetMouseButton(xbutton);
+        int32_t x = event->xbutton.x;
+        int32_t y = event->xbutton.y;
+
+        if (minimalProcessMouseButton(button, action))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_BUTTON, ((uint32_t)button << 16) + action, x, y);
+        return;
+    }
+    case MotionNotify:
+    {
+        // may still be queued from before the input selection changed
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_MOVED)) return;
+
+        int32_t x = event->xmotion.x;
+        int32_t y = event->xmotion.y;
+
+        if (minimalProcessMouseMove((float)x, (float)y))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_MOVED, 0, x, y);
+        return;
+    }
+    case LeaveNotify:
+    {
+        minimalResetMouseDelta(context);
+        return;
+    }
+    case FocusIn:
+    case FocusOut:
+    {
+        // grabs move the focus temporarily without the window losing it
+        if (event->xfocus.mode == NotifyGrab || event->xfocus.mode == NotifyUngrab)
+            return;
+
+        context->focused = event->type == FocusIn;
+        return;
+    }
+    case ConfigureNotify:
+    {
+        uint32_t width  = (uint32_t)event->xconfigure.width;
+        uint32_t height = (uint32_t)event->xconfigure.height;
+
+        // configure notify is also sent for moves
+        if (width == context->width && height == context->height) return;
+
+        context->width = width;
+        context->height = height;
+
+        if (MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_WINDOW_SIZE))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_WINDOW_SIZE, 0, (int32_t)width, (int32_t)height);
+        return;
+    }
+    default: return;
+    }
+}
+
+/* --------------------------| framebuffer |----------------------------- */
+/* on failure the image is released without touching its data, which never came from malloc */
+static uint8_t minimalX11ReleaseShmImage(MinimalX11Framebuffer* fb)
+{
+    fb->image->data = NULL;
+    XDestroyImage(fb->image);
+    fb->image = NULL;
+
+    return MINIMAL_FAIL;
+}
+
+static uint8_t minimalX11CreateShmImage(MinimalWindow* window, MinimalX11Framebuffer* fb, uint32_t w, uint32_t h)
+{
+    fb->image = XShmCreateImage(_minimalDisplay, window->visual, (unsigned int)window->depth, ZPixmap, NULL, &fb->shm, w, h);
+    if (!fb->image) return MINIMAL_FAIL;
+
+    fb->shm.shmid = shmget(IPC_PRIVATE, (size_t)fb->image->bytes_per_line * fb->image->height, IPC_CREAT | 0600);
+    if (fb->shm.shmid < 0) return minimalX11ReleaseShmImage(fb);
+
+    fb->shm.shmaddr = shmat(fb->shm.shmid, NULL, 0);
+    if (fb->shm.shmaddr == (char*)-1)
+    {
+        shmctl(fb->shm.shmid, IPC_RMID, NULL);
+        fb->shm.shmaddr = NULL;
+        return minimalX11ReleaseShmImage(fb);
+    }
+
+    fb->image->data = fb->shm.shmaddr;
+    fb->shm.readOnly = False;
+
+    // attaching fails on remote displays, which only shows up as an async error
+    _minimalX11Error = 0;
+    int (*handler)(Display*, XErrorEvent*) = XSetErrorHandler(minimalX11ErrorHandler);
+
+    Status attached = XShmAttach(_minimalDisplay, &fb->shm);
+    XSync(_minimalDisplay, False);
+
+    XSetErrorHandler(handler);
+
+    // the segment is freed once both sides detached
+    shmctl(fb->shm.shmid, IPC_RMID, NULL);
+
+    if (!attached || _minimalX11Error)
+    {
+        shmdt(fb->shm.shmaddr);
+        fb->shm.shmaddr = NULL;
+        return minimalX11ReleaseShmImage(fb);
+    }
+
+    return MINIMAL_OK;
+}
+
+static uint8_t minimalX11CreateImage(MinimalWindow* window, MinimalX11Framebuffer* fb, uint32_t w, uint32_t h)
+{
+    char* data = malloc((size_t)w * h * 4);
+    if (!data) return MINIMAL_FAIL;
+
+    fb->image = XCreateImage(_minimalDisplay, window->visual, (unsigned int)window->depth, ZPixmap, 0, data, w, h, 32, 0);
+    if (!fb->image)
+    {
+        free(data);
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+static void minimalX11DestroyFramebuffer(MinimalWindow* window, MinimalX11Framebuffer* fb)
+{
+    if (fb->shm.shmaddr)
+    {
+        XShmDetach(_minimalDisplay, &fb->shm);
+        shmdt(fb->shm.shmaddr);
+    }
+
+    if (fb->image)
+    {
+        // shared memory is not owned by the image
+        if (fb->shm.shmaddr) fb->image->data = NULL;
+        XDestroyImage(fb->image);
+    }
+
+    memset(fb, 0, sizeof(MinimalX11Framebuffer));
+}
+
+static Bool minimalX11IsShmCompletion(Display* display, XEvent* event, XPointer arg)
+{
+    const MinimalX11Framebuffer* fb = (const MinimalX11Framebuffer*)arg;
+    return event->type == _minimalShmCompletion && ((XShmCompletionEvent*)event)->shmseg == fb->shm.shmseg;
+}
+
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    // pixels are written as 32 bit words, which only matches true color visuals
+    if (window->depth != 24 && window->depth != 32)
+    {
+        MINIMAL_ERROR("[Platform] Framebuffer needs a 24 or 32 bit visual (depth is %d)", window->depth);
+        return NULL;
+    }
+
+    window->framebufferShm = _minimalShmCompletion >= 0;
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT && window->framebufferShm; ++i)
+    {
+        if (!minimalX11CreateShmImage(window, &window->framebuffers[i], w, h))
+        {
+            MINIMAL_WARN("[Platform] MIT-SHM is not available, presenting with XPutImage");
+            minimalDestroyFramebuffer(window);
+            window->framebufferShm = 0;
+        }
+    }
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT && !window->framebufferShm; ++i)
+    {
+        if (!minimalX11CreateImage(window, &window->framebuffers[i], w, h))
+        {
+            MINIMAL_ERROR("[Platform] Failed to create framebuffer");
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+    }
+
+    window->gc = XCreateGC(_minimalDisplay, window->handle, 0, NULL);
+    window->framebufferIndex = 0;
+
+    return (uint32_t*)window->framebuffers[0].image->data;
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+        minimalX11DestroyFramebuffer(window, &window->framebuffers[i]);
+
+    if (window->gc)
+    {
+        XFreeGC(_minimalDisplay, window->gc);
+        window->gc = NULL;
+    }
+
+    XSync(_minimalDisplay, False);
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    MinimalX11Framebuffer* current = &window->framebuffers[window->framebufferIndex];
+    if (!current->image) return NULL;
+
+    unsigned int w = (unsigned int)current->image->width;
+    unsigned int h = (unsigned int)current->image->height;
+
+    if (window->framebufferShm)
+    {
+        XShmPutImage(_minimalDisplay, window->handle, window->gc, current->image, 0, 0, 0, 0, w, h, True);
+        current->busy = 1;
+    }
+    else
+    {
+        XPutImage(_minimalDisplay, window->handle, window->gc, current->image, 0, 0, 0, 0, w, h);
+    }
+    XFlush(_minimalDisplay);
+
+    window->framebufferIndex = (window->framebufferIndex + 1) % MINIMAL_FRAMEBUFFER_COUNT;
+    MinimalX11Framebuffer* next = &window->framebuffers[window->framebufferIndex];
+
+    // the server may still be reading the buffer presented before
+    if (next->busy)
+    {
+        XEvent event;
+        XIfEvent(_minimalDisplay, &event, minimalX11IsShmCompletion, (XPointer)next);
+        next->busy = 0;
+    }
+
+    return (uint32_t*)next->image->data;
+}
+
+/* --------------------------| glx |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_GLX
+
+#ifndef GLX_ARB_create_context
+#define GLX_CONTEXT_MAJOR_VERSION_ARB               0x2091
+#define GLX_CONTEXT_MINOR_VERSION_ARB               0x2092
+#define GLX_CONTEXT_FLAGS_ARB                       0x2094
+#define GLX_CONTEXT_PROFILE_MASK_ARB                0x9126
+
+#define GLX_CONTEXT_DEBUG_BIT_ARB                   0x0001
+#define GLX_CONTEXT_CORE_PROFILE_BIT_ARB            0x00000001
+#endif
+
+// GLX extension pointer typedefs
+typedef GLXContext(*glXCreateContextAttribsARB_T)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
+typedef void(*glXSwapIntervalEXT_T)(Display*, GLXDrawable, int);
+typedef int(*glXSwapIntervalMESA_T)(unsigned int);
+
+static glXCreateContextAttribsARB_T _glXCreateContextAttribsARB = NULL;
+static glXSwapIntervalEXT_T         _glXSwapIntervalEXT = NULL;
+static glXSwapIntervalMESA_T        _glXSwapIntervalMESA = NULL;
+
+static uint8_t _minimalGLXError = 0;
+
+static int minimalGLXErrorHandler(Display* display, XErrorEvent* event)
+{
+    _minimalGLXError = 1;
+    return 0;
+}
+
+uint8_t minimalGLXInit()
+{
+    int major = 0, minor = 0;
+    if (!glXQueryVersion(_minimalDisplay, &major, &minor) || (major == 1 && minor < 3))
+    {
+        MINIMAL_ERROR("[GLX] GLX 1.3 is required");
+        return MINIMAL_FAIL;
+    }
+
+    _glXCreateContextAttribsARB =   (glXCreateContextAttribsARB_T)glXGetProcAddressARB((const GLubyte*)"glXCreateContextAttribsARB");
+    _glXSwapIntervalEXT =           (glXSwapIntervalEXT_T)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalEXT");
+    _glXSwapIntervalMESA =          (glXSwapIntervalMESA_T)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalMESA");
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalGLXChooseConfig(GLXFBConfig* config)
+{
+    int fbAttribs[] = {
+        GLX_X_RENDERABLE,   True,
+        GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
+        GLX_RENDER_TYPE,    GLX_RGBA_BIT,
+        GLX_X_VISUAL_TYPE,  GLX_TRUE_COLOR,
+        GLX_DOUBLEBUFFER,   True,
+        GLX_RED_SIZE,       8,
+        GLX_GREEN_SIZE,     8,
+        GLX_BLUE_SIZE,      8,
+        GLX_ALPHA_SIZE,     8,
+        GLX_DEPTH_SIZE,     24,
+        GLX_STENCIL_SIZE,   8,
+        None
+    };
+
+    int count = 0;
+    GLXFBConfig* configs = glXChooseFBConfig(_minimalDisplay, _minimalScreen, fbAttribs, &count);
+    if (!configs || !count)
+    {
+        MINIMAL_ERROR("[GLX] Could not find a suitable framebuffer config");
+        return MINIMAL_FAIL;
+    }
+
+    *config = configs[0];
+    XFree(configs);
+
+    return MINIMAL_OK;
+}
+
+GLXContext minimalCreateRenderContext(Window handle, GLXFBConfig config)
+{
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    // context creation failures are reported as X errors, which terminate by default
+    _minimalGLXError = 0;
+    XSync(_minimalDisplay, False);
+    int (*handler)(Display*, XErrorEvent*) = XSetErrorHandler(minimalGLXErrorHandler);
+
+    GLXContext rc = NULL;
+    if (_glXCreateContextAttribsARB)
+    {
+        int glAttribs[16];
+        int i = 0;
+
+        // without a version hint the driver picks its default
+        if (major > 0)
+        {
+            glAttribs[i++] = GLX_CONTEXT_MAJOR_VERSION_ARB; glAttribs[i++] = major;
+            glAttribs[i++] = GLX_CONTEXT_MINOR_VERSION_ARB; glAttribs[i++] = minor;
+        }
+
+        if (major > 3 || (major == 3 && minor >= 2))
+        {
+            glAttribs[i++] = GLX_CONTEXT_PROFILE_MASK_ARB;  glAttribs[i++] = GLX_CONTEXT_CORE_PROFILE_BIT_ARB;
+        }
+#ifdef _DEBUG
+        glAttribs[i++] = GLX_CONTEXT_FLAGS_ARB;             glAttribs[i++] = GLX_CONTEXT_DEBUG_BIT_ARB;
+#endif // _DEBUG
+        glAttribs[i] = None;
+
+        rc = _glXCreateContextAttribsARB(_minimalDisplay, config, NULL, True, glAttribs);
+    }
+    else
+    {
+        rc = glXCreateNewContext(_minimalDisplay, config, GLX_RGBA_TYPE, NULL, True);
+    }
+
+    XSync(_minimalDisplay, False);
+    XSetErrorHandler(handler);
+
+    if (!rc || _minimalGLXError)
+    {
+        MINIMAL_ERROR("[GLX] Failed to create render context");
+        return NULL;
+    }
+
+    if (!glXMakeCurrent(_minimalDisplay, handle, rc))
+    {
+        MINIMAL_ERROR("[GLX] Failed to make render context current");
+        glXDestroyContext(_minimalDisplay, rc);
+        return NULL;
+    }
+
+    return rc;
+}
+
+void* minimalGetGLProcAddress(const char* name)
+{
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+}
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    glXSwapBuffers(_minimalDisplay, context->handle);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    GLXDrawable drawable = glXGetCurrentDrawable();
+
+    if (_glXSwapIntervalEXT && drawable)    _glXSwapIntervalEXT(_minimalDisplay, drawable, interval);
+    else if (_glXSwapIntervalMESA)          _glXSwapIntervalMESA(interval);
+}
+
+#endif // MINIMAL_CONTEXT_GLX
+
+/* --------------------------| egl |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_EGL
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    minimalEGLSwapInterval(interval);
+}
+
+#endif // MINIMAL_CONTEXT_EGL
+
+#endif // MINIMAL_PLATFORM_X11
+
+
+
+#ifdef MINIMAL_PLATFORM_WAYLAND
+
+#include <wayland-client.h>
+#include <xkbcommon/xkbcommon.h>
+
+/* generated with: wayland-scanner client-header xdg-shell.xml xdg-shell-client-protocol.h */
+#include "xdg-shell-client-protocol.h"
+
+/*
+ raw motion and pointer lock, only used if the compositor supports them but required to build:
+ wayland-scanner client-header relative-pointer-unstable-v1.xml relative-pointer-unstable-v1-client-protocol.h
+ wayland-scanner client-header pointer-constraints-unstable-v1.xml pointer-constraints-unstable-v1-client-protocol.h
+*/
+#include "relative-pointer-unstable-v1-client-protocol.h"
+#include "pointer-constraints-unstable-v1-client-protocol.h"
+
+#include <linux/input-event-codes.h>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef MINIMAL_NO_CONTEXT
+#include <wayland-egl.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_WAYLAND_KHR
+#define EGL_PLATFORM_WAYLAND_KHR    0x31D8
+#endif
+#endif
+
+/* upper bound for waiting on a frame callback, hidden surfaces never get one */
+#ifndef MINIMAL_WAYLAND_FRAME_TIMEOUT
+#define MINIMAL_WAYLAND_FRAME_TIMEOUT   100
+#endif
+
+/* buffers added on top of MINIMAL_FRAMEBUFFER_COUNT while the compositor holds on to all of them */
+#ifndef MINIMAL_WAYLAND_FRAMEBUFFER_MAX
+#define MINIMAL_WAYLAND_FRAMEBUFFER_MAX 4
+#endif
+
+static struct wl_display*       _minimalDisplay = NULL;
+static struct wl_registry*      _minimalRegistry = NULL;
+static struct wl_compositor*    _minimalCompositor = NULL;
+static struct xdg_wm_base*      _minimalWMBase = NULL;
+static struct wl_shm*           _minimalShm = NULL;
+static struct wl_seat*          _minimalSeat = NULL;
+static struct wl_keyboard*      _minimalKeyboard = NULL;
+static struct wl_pointer*       _minimalPointer = NULL;
+
+static struct zwp_relative_pointer_manager_v1*  _minimalRelativePointerManager = NULL;
+static struct zwp_relative_pointer_v1*          _minimalRelativePointer = NULL;
+static struct zwp_pointer_constraints_v1*       _minimalPointerConstraints = NULL;
+
+static struct xkb_context*      _minimalXkbContext = NULL;
+static struct xkb_keymap*       _minimalXkbKeymap = NULL;
+static struct xkb_state*        _minimalXkbState = NULL;
+
+/* windows that currently receive keyboard and pointer input */
+static MinimalWindow*           _minimalKeyboardFocus = NULL;
+static MinimalWindow*           _minimalPointerFocus = NULL;
+
+static uint32_t _minimalKeyMods = 0;
+static uint32_t _minimalPointerSerial = 0;
+static float    _minimalCursorX = 0.0f;
+static float    _minimalCursorY = 0.0f;
+
+/* scroll below one notch, carried over to the next axis event */
+static double   _minimalScrollX = 0.0;
+static double   _minimalScrollY = 0.0;
+
+static uint8_t  _minimalSwapInterval = 1;
+
+static uint64_t _minimalTimerOffset = 0;
+
+/* signalled by minimalWakeWindow to interrupt minimalWaitWindowEvents */
+static int      _minimalWakeFd = -1;
+
+static uint64_t minimalWaylandTimeMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* --------------------------| registry |-------------------------------- */
+static void minimalWMBasePing(void* data, struct xdg_wm_base* base, uint32_t serial)
+{
+    xdg_wm_base_pong(base, serial);
+}
+
+static const struct xdg_wm_base_listener _minimalWMBaseListener = {
+    .ping = minimalWMBasePing
+};
+
+static const struct wl_seat_listener _minimalSeatListener;
+
+static void minimalRegistryGlobal(void* data, struct wl_registry* registry, uint32_t name, const char* interface, uint32_t version)
+{
+    if (strcmp(interface, wl_compositor_interface.name) == 0)
+    {
+        _minimalCompositor = wl_registry_bind(registry, name, &wl_compositor_interface, 1);
+    }
+    else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
+    {
+        _minimalWMBase = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(_minimalWMBase, &_minimalWMBaseListener, NULL);
+    }
+    else if (strcmp(interface, wl_shm_interface.name) == 0)
+    {
+        _minimalShm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+    }
+    else if (strcmp(interface, wl_seat_interface.name) == 0 && !_minimalSeat)
+    {
+        _minimalSeat = wl_registry_bind(registry, name, &wl_seat_interface, version < 5 ? version : 5);
+        wl_seat_add_listener(_minimalSeat, &_minimalSeatListener, NULL);
+    }
+    else if (strcmp(interface, zwp_relative_pointer_manager_v1_interface.name) == 0)
+    {
+        _minimalRelativePointerManager = wl_registry_bind(registry, name, &zwp_relative_pointer_manager_v1_interface, 1);
+    }
+    else if (strcmp(interface, zwp_pointer_constraints_v1_interface.name) == 0)
+    {
+        _minimalPointerConstraints = wl_registry_bind(registry, name, &zwp_pointer_constraints_v1_interface, 1);
+    }
+}
+
+static void minimalRegistryGlobalRemove(void* data, struct wl_registry* registry, uint32_t name) { }
+
+static const struct wl_registry_listener _minimalRegistryListener = {
+    .global         = minimalRegistryGlobal,
+    .global_remove  = minimalRegistryGlobalRemove
+};
+
+uint8_t minimalPlatformInit()
+{
+    _minimalDisplay = wl_display_connect(NULL);
+    if (!_minimalDisplay)
+    {
+        MINIMAL_ERROR("[Platform] Failed to connect to Wayland display");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalXkbContext = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    if (!_minimalXkbContext)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create xkb context");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalRegistry = wl_display_get_registry(_minimalDisplay);
+    wl_registry_add_listener(_minimalRegistry, &_minimalRegistryListener, NULL);
+
+    // first roundtrip binds the globals, second one the seat capabilities
+    wl_display_roundtrip(_minimalDisplay);
+    wl_display_roundtrip(_minimalDisplay);
+
+    if (!_minimalCompositor || !_minimalWMBase)
+    {
+        MINIMAL_ERROR("[Platform] Compositor does not support xdg-shell");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_minimalWakeFd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create wakeup eventfd");
+        return MINIMAL_FAIL;
+    }
+
+    // init time
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        MINIMAL_ERROR("[Platform] Monotonic clock is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalTimerOffset = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    minimalInitTicks();
+
+#ifndef MINIMAL_NO_CONTEXT
+    // init egl
+    if (!minimalEGLInit(EGL_PLATFORM_WAYLAND_KHR, _minimalDisplay))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLTerminate();
+#endif
+
+    if (_minimalXkbState)   xkb_state_unref(_minimalXkbState);
+    if (_minimalXkbKeymap)  xkb_keymap_unref(_minimalXkbKeymap);
+    if (_minimalXkbContext) xkb_context_unref(_minimalXkbContext);
+
+    if (_minimalRelativePointer)        zwp_relative_pointer_v1_destroy(_minimalRelativePointer);
+    if (_minimalRelativePointerManager) zwp_relative_pointer_manager_v1_destroy(_minimalRelativePointerManager);
+    if (_minimalPointerConstraints)     zwp_pointer_constraints_v1_destroy(_minimalPointerConstraints);
+
+    if (_minimalKeyboard)   wl_keyboard_destroy(_minimalKeyboard);
+    if (_minimalPointer)    wl_pointer_destroy(_minimalPointer);
+    if (_minimalSeat)       wl_seat_destroy(_minimalSeat);
+    if (_minimalShm)        wl_shm_destroy(_minimalShm);
+    if (_minimalWMBase)     xdg_wm_base_destroy(_minimalWMBase);
+    if (_minimalCompositor) wl_compositor_destroy(_minimalCompositor);
+    if (_minimalRegistry)   wl_registry_destroy(_minimalRegistry);
+
+    if (_minimalWakeFd >= 0)
+    {
+        close(_minimalWakeFd);
+        _minimalWakeFd = -1;
+    }
+
+    if (_minimalDisplay)
+    {
+        wl_display_disconnect(_minimalDisplay);
+        _minimalDisplay = NULL;
+    }
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+typedef struct
+{
+    struct wl_buffer*   buffer;
+    uint32_t*           pixels;
+    size_t              size;
+    uint8_t             busy;
+} MinimalWaylandFramebuffer;
+
+struct MinimalWindow
+{
+    struct wl_surface*      surface;
+    struct xdg_surface*     xdgSurface;
+    struct xdg_toplevel*    xdgToplevel;
+
+    /* pending wl_surface.frame request of the last presented frame */
+    struct wl_callback*     frameCallback;
+
+#ifndef MINIMAL_NO_CONTEXT
+    struct wl_egl_window*   eglWindow;
+    MinimalEGLContext       egl;
+#endif
+
+    /* buffer releases are dispatched on their own queue, never together with input */
+    struct wl_event_queue*  framebufferQueue;
+    MinimalWaylandFramebuffer framebuffers[MINIMAL_WAYLAND_FRAMEBUFFER_MAX];
+    uint32_t    framebufferCount;
+    uint32_t    framebufferIndex;
+    uint32_t    framebufferWidth;
+    uint32_t    framebufferHeight;
+
+    uint32_t width;
+    uint32_t height;
+
+    uint8_t shouldClose;
+
+    uint32_t eventMask;
+
+    struct zwp_locked_pointer_v1* lockedPointer;
+};
+
+/* --------------------------| xdg shell |------------------------------- */
+static void minimalXdgSurfaceConfigure(void* data, struct xdg_surface* surface, uint32_t serial)
+{
+    xdg_surface_ack_configure(surface, serial);
+}
+
+static const struct xdg_surface_listener _minimalXdgSurfaceListener = {
+    .configure = minimalXdgSurfaceConfigure
+};
+
+static void minimalXdgToplevelConfigure(void* data, struct xdg_toplevel* toplevel, int32_t width, int32_t height, struct wl_array* states)
+{
+    MinimalWindow* window = data;
+
+    // zero means the client decides
+    if (width <= 0 || height <= 0) return;
+    if ((uint32_t)width == window->width && (uint32_t)height == window->height) return;
+
+    window->width = (uint32_t)width;
+    window->height = (uint32_t)height;
+
+#ifndef MINIMAL_NO_CONTEXT
+    if (window->eglWindow)
+        wl_egl_window_resize(window->eglWindow, width, height, 0, 0);
+#endif
+
+    if (MINIMAL_EVENT_ENABLED(window, MINIMAL_EVENT_WINDOW_SIZE))
+        minimalDispatchWindowEvent(window, MINIMAL_EVENT_WINDOW_SIZE, 0, width, height);
+}
+
+static void minimalXdgToplevelClose(void* data, struct xdg_toplevel* toplevel)
+{
+    minimalClose(data);
+}
+
+static const struct xdg_toplevel_listener _minimalXdgToplevelListener = {
+    .configure  = minimalXdgToplevelConfigure,
+    .close      = minimalXdgToplevelClose
+};
+
+static void minimalFrameDone(void* data, struct wl_callback* callback, uint32_t time)
+{
+    MinimalWindow* window = data;
+
+    wl_callback_destroy(callback);
+    if (window->frameCallback == callback)
+        window->frameCallback = NULL;
+}
+
+static const struct wl_callback_listener _minimalFrameListener = {
+    .done = minimalFrameDone
+};
+
+/* has to be called before the commit that presents the frame */
+static void minimalWaylandRequestFrame(MinimalWindow* window)
+{
+    if (!_minimalSwapInterval) return;
+
+    if (window->frameCallback) wl_callback_destroy(window->frameCallback);
+
+    window->frameCallback = wl_surface_frame(window->surface);
+    wl_callback_add_listener(window->frameCallback, &_minimalFrameListener, window);
+}
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->width = w;
+    window->height = h;
+    window->shouldClose = 0;
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    // create window, wayland does not let clients position toplevels
+    window->surface = wl_compositor_create_surface(_minimalCompositor);
+    if (!window->surface)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create surface");
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    wl_surface_set_user_data(window->surface, window);
+
+    window->xdgSurface = xdg_wm_base_get_xdg_surface(_minimalWMBase, window->surface);
+    xdg_surface_add_listener(window->xdgSurface, &_minimalXdgSurfaceListener, window);
+
+    window->xdgToplevel = xdg_surface_get_toplevel(window->xdgSurface);
+    xdg_toplevel_add_listener(window->xdgToplevel, &_minimalXdgToplevelListener, window);
+
+    minimalSetWindowTitle(window, title);
+
+    // the surface has to be configured before the first buffer is attached
+    wl_surface_commit(window->surface);
+    wl_display_roundtrip(_minimalDisplay);
+
+#ifndef MINIMAL_NO_CONTEXT
+
+    if (windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API)
+        return window;
+
+    window->eglWindow = wl_egl_window_create(window->surface, (int)window->width, (int)window->height);
+    if (!window->eglWindow)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create EGL window");
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    if (!minimalEGLCreateContext(&window->egl, window->eglWindow, window->width, window->height, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    // pacing is done with frame callbacks, eglSwapBuffers must never block
+    minimalEGLSwapInterval(0);
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    if (_minimalKeyboardFocus == window) _minimalKeyboardFocus = NULL;
+    if (_minimalPointerFocus == window)  _minimalPointerFocus = NULL;
+
+    minimalResetMouseDelta(window);
+
+    minimalDestroyFramebuffer(window);
+
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLDestroyContext(&window->egl);
+
+    if (window->eglWindow) wl_egl_window_destroy(window->eglWindow);
+#endif
+
+    if (window->lockedPointer)  zwp_locked_pointer_v1_destroy(window->lockedPointer);
+    if (window->frameCallback)  wl_callback_destroy(window->frameCallback);
+    if (window->xdgToplevel)    xdg_toplevel_destroy(window->xdgToplevel);
+    if (window->xdgSurface)     xdg_surface_destroy(window->xdgSurface);
+    if (window->surface)        wl_surface_destroy(window->surface);
+
+    wl_display_flush(_minimalDisplay);
+
+    free(window);
+}
+
+/*
+ * Reads and dispatches events, blocking up to timeout milliseconds unless
+ * queued events were dispatched already. Writing to wakeFd ends the wait
+ * early, a negative fd is ignored by poll.
+ */
+static void minimalWaylandDispatch(int timeout, int wakeFd)
+{
+    while (wl_display_prepare_read(_minimalDisplay) != 0)
+    {
+        if (wl_display_dispatch_pending(_minimalDisplay) > 0)
+            timeout = 0;
+    }
+
+    wl_display_flush(_minimalDisplay);
+
+    struct pollfd fds[2] = {
+        { .fd = wl_display_get_fd(_minimalDisplay), .events = POLLIN },
+        { .fd = wakeFd, .events = POLLIN }
+    };
+
+    if (poll(fds, 2, timeout) > 0 && (fds[0].revents & POLLIN))
+        wl_display_read_events(_minimalDisplay);
+    else
+        wl_display_cancel_read(_minimalDisplay);
+
+    if (fds[1].revents & POLLIN)
+    {
+        uint64_t value;
+        while (read(wakeFd, &value, sizeof(value)) > 0);
+    }
+
+    wl_display_dispatch_pending(_minimalDisplay);
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    // all windows share one connection, listeners route events to their own window
+    minimalWaylandDispatch(0, -1);
+
+    // hold the next frame back until the compositor is ready to show it
+    uint64_t start = minimalWaylandTimeMs();
+    while (context->frameCallback && !context->shouldClose)
+    {
+        uint64_t elapsed = minimalWaylandTimeMs() - start;
+        if (elapsed >= MINIMAL_WAYLAND_FRAME_TIMEOUT) break;
+
+        minimalWaylandDispatch((int)(MINIMAL_WAYLAND_FRAME_TIMEOUT - elapsed), -1);
+    }
+
+    minimalFlushEvents();
+}
+
+void minimalPollAllEvents()
+{
+    minimalWaylandDispatch(0, -1);
+    minimalFlushEvents();
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    int ms = -1;
+    if (timeout != MINIMAL_WAIT_INFINITE)
+    {
+        // rounded up so short waits do not turn into spins
+        uint64_t value = (timeout + 999999) / 1000000;
+        ms = value > INT_MAX ? INT_MAX : (int)value;
+    }
+
+    minimalWaylandDispatch(ms, _minimalWakeFd);
+    minimalFlushEvents();
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    // only fails if the counter is already full, which wakes the wait as well
+    uint64_t value = 1;
+    ssize_t result = write(_minimalWakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+
+    if ((mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW)) && !_minimalRelativePointerManager)
+        MINIMAL_WARN("[Platform] Raw mouse motion needs zwp_relative_pointer_manager_v1");
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title)
+{
+    xdg_toplevel_set_title(context->xdgToplevel, title);
+}
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window) { xdg_toplevel_set_maximized(window->xdgToplevel); }
+void minimalMinimize(MinimalWindow* window) { xdg_toplevel_set_minimized(window->xdgToplevel); }
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock)
+{
+    if (!lock)
+    {
+        // there is no cursor theme to restore, the compositor picks the cursor once the pointer leaves
+        if (window->lockedPointer) zwp_locked_pointer_v1_destroy(window->lockedPointer);
+        window->lockedPointer = NULL;
+        return;
+    }
+
+    if (window->lockedPointer || !_minimalPointer) return;
+
+    if (!_minimalPointerConstraints)
+    {
+        MINIMAL_WARN("[Platform] Pointer lock needs zwp_pointer_constraints_v1");
+        return;
+    }
+
+    // stays active until it is destroyed, the compositor lifts it while the window is unfocused
+    window->lockedPointer = zwp_pointer_constraints_v1_lock_pointer(_minimalPointerConstraints, window->surface, _minimalPointer,
+                                                                    NULL, ZWP_POINTER_CONSTRAINTS_V1_LIFETIME_PERSISTENT);
+
+    if (_minimalPointerFocus == window)
+        wl_pointer_set_cursor(_minimalPointer, _minimalPointerSerial, NULL, 0, 0);
+}
+
+uint64_t minimalGetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t value = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    return value - _minimalTimerOffset;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    if (xscale) *xscale = 1.0f;
+    if (yscale) *yscale = 1.0f;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return window->surface;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return _minimalDisplay;
+}
+
+/* --------------------------| keyboard |-------------------------------- */
+/* linux evdev scancodes to MINIMAL_KEY_* */
+static const MinimalKeycode _minimalEvdevKeys[256] = {
+    [KEY_ESC]           = MINIMAL_KEY_ESCAPE,
+    [KEY_1]             = MINIMAL_KEY_1,
+    [KEY_2]             = MINIMAL_KEY_2,
+    [KEY_3]             = MINIMAL_KEY_3,
+    [KEY_4]             = MINIMAL_KEY_4,
+    [KEY_5]             = MINIMAL_KEY_5,
+    [KEY_6]             = MINIMAL_KEY_6,
+    [KEY_7]             = MINIMAL_KEY_7,
+    [KEY_8]             = MINIMAL_KEY_8,
+    [KEY_9]             = MINIMAL_KEY_9,
+    [KEY_0]             = MINIMAL_KEY_0,
+    [KEY_MINUS]         = MINIMAL_KEY_MINUS,
+    [KEY_EQUAL]         = MINIMAL_KEY_PLUS,
+    [KEY_BACKSPACE]     = MINIMAL_KEY_BACKSPACE,
+    [KEY_TAB]           = MINIMAL_KEY_TAB,
+    [KEY_Q]             = MINIMAL_KEY_Q,
+    [KEY_W]             = MINIMAL_KEY_W,
+    [KEY_E]             = MINIMAL_KEY_E,
+    [KEY_R]             = MINIMAL_KEY_R,
+    [KEY_T]             = MINIMAL_KEY_T,
+    [KEY_Y]             = MINIMAL_KEY_Y,
+    [KEY_U]             = MINIMAL_KEY_U,
+    [KEY_I]             = MINIMAL_KEY_I,
+    [KEY_O]             = MINIMAL_KEY_O,
+    [KEY_P]             = MINIMAL_KEY_P,
+    [KEY_ENTER]         = MINIMAL_KEY_ENTER,
+    [KEY_LEFTCTRL]      = MINIMAL_KEY_CONTROL,
+    [KEY_A]             = MINIMAL_KEY_A,
+    [KEY_S]             = MINIMAL_KEY_S,
+    [KEY_D]             = MINIMAL_KEY_D,
+    [KEY_F]             = MINIMAL_KEY_F,
+    [KEY_G]             = MINIMAL_KEY_G,
+    [KEY_H]             = MINIMAL_KEY_H,
+    [KEY_J]             = MINIMAL_KEY_J,
+    [KEY_K]             = MINIMAL_KEY_K,
+    [KEY_L]             = MINIMAL_KEY_L,
+    [KEY_SEMICOLON]     = MINIMAL_KEY_SEMICOLON,
+    [KEY_GRAVE]         = MINIMAL_KEY_GRAVE,
+    [KEY_LEFTSHIFT]     = MINIMAL_KEY_SHIFT,
+    [KEY_Z]             = MINIMAL_KEY_Z,
+    [KEY_X]             = MINIMAL_KEY_X,
+    [KEY_C]             = MINIMAL_KEY_C,
+    [KEY_V]             = MINIMAL_KEY_V,
+    [KEY_B]             = MINIMAL_KEY_B,
+    [KEY_N]             = MINIMAL_KEY_N,
+    [KEY_M]             = MINIMAL_KEY_M,
+    [KEY_COMMA]         = MINIMAL_KEY_COMMA,
+    [KEY_DOT]           = MINIMAL_KEY_PERIOD,
+    [KEY_SLASH]         = MINIMAL_KEY_SLASH,
+    [KEY_RIGHTSHIFT]    = MINIMAL_KEY_SHIFT,
+    [KEY_KPASTERISK]    = MINIMAL_KEY_MULTIPLY,
+    [KEY_LEFTALT]       = MINIMAL_KEY_ALT,
+    [KEY_SPACE]         = MINIMAL_KEY_SPACE,
+    [KEY_CAPSLOCK]      = MINIMAL_KEY_CAPITAL,
+    [KEY_F1]            = MINIMAL_KEY_F1,
+    [KEY_F2]            = MINIMAL_KEY_F2,
+    [KEY_F3]            = MINIMAL_KEY_F3,
+    [KEY_F4]            = MINIMAL_KEY_F4,
+    [KEY_F5]            = MINIMAL_KEY_F5,
+    [KEY_F6]            = MINIMAL_KEY_F6,
+    [KEY_F7]            = MINIMAL_KEY_F7,
+    [KEY_F8]            = MINIMAL_KEY_F8,
+    [KEY_F9]            = MINIMAL_KEY_F9,
+    [KEY_F10]           = MINIMAL_KEY_F10,
+    [KEY_NUMLOCK]       = MINIMAL_KEY_NUMLOCK,
+    [KEY_SCROLLLOCK]    = MINIMAL_KEY_SCROLL,
+    [KEY_KP7]           = MINIMAL_KEY_NUMPAD7,
+    [KEY_KP8]           = MINIMAL_KEY_NUMPAD8,
+    [KEY_KP9]           = MINIMAL_KEY_NUMPAD9,
+    [KEY_KPMINUS]       = MINIMAL_KEY_SUBTRACT,
+    [KEY_KP4]           = MINIMAL_KEY_NUMPAD4,
+    [KEY_KP5]           = MINIMAL_KEY_NUMPAD5,
+    [KEY_KP6]           = MINIMAL_KEY_NUMPAD6,
+    [KEY_KPPLUS]        = MINIMAL_KEY_ADD,
+    [KEY_KP1]           = MINIMAL_KEY_NUMPAD1,
+    [KEY_KP2]           = MINIMAL_KEY_NUMPAD2,
+    [KEY_KP3]           = MINIMAL_KEY_NUMPAD3,
+    [KEY_KP0]           = MINIMAL_KEY_NUMPAD0,
+    [KEY_KPDOT]         = MINIMAL_KEY_DECIMAL,
+    [KEY_F11]           = MINIMAL_KEY_F11,
+    [KEY_F12]           = MINIMAL_KEY_F12,
+    [KEY_HENKAN]        = MINIMAL_KEY_CONVERT,
+    [KEY_MUHENKAN]      = MINIMAL_KEY_NONCONVERT,
+    [KEY_KPENTER]       = MINIMAL_KEY_ENTER,
+    [KEY_RIGHTCTRL]     = MINIMAL_KEY_CONTROL,
+    [KEY_KPSLASH]       = MINIMAL_KEY_DIVIDE,
+    [KEY_SYSRQ]         = MINIMAL_KEY_SNAPSHOT,
+    [KEY_RIGHTALT]      = MINIMAL_KEY_ALT,
+    [KEY_HOME]          = MINIMAL_KEY_HOME,
+    [KEY_UP]            = MINIMAL_KEY_UP,
+    [KEY_PAGEUP]        = MINIMAL_KEY_PAGE_UP,
+    [KEY_LEFT]          = MINIMAL_KEY_LEFT,
+    [KEY_RIGHT]         = MINIMAL_KEY_RIGHT,
+    [KEY_END]           = MINIMAL_KEY_END,
+    [KEY_DOWN]          = MINIMAL_KEY_DOWN,
+    [KEY_PAGEDOWN]      = MINIMAL_KEY_PAGE_DOWN,
+    [KEY_INSERT]        = MINIMAL_KEY_INSERT,
+    [KEY_DELETE]        = MINIMAL_KEY_DELETE,
+    [KEY_KPEQUAL]       = MINIMAL_KEY_NUMPAD_EQUAL,
+    [KEY_PAUSE]         = MINIMAL_KEY_PAUSE,
+    [KEY_KPCOMMA]       = MINIMAL_KEY_SEPARATOR,
+    [KEY_LEFTMETA]      = MINIMAL_KEY_LCOMMAND,
+    [KEY_RIGHTMETA]     = MINIMAL_KEY_RCOMMAND,
+    [KEY_COMPOSE]       = MINIMAL_KEY_APPS,
+    [KEY_HELP]          = MINIMAL_KEY_HELP,
+    [KEY_SLEEP]         = MINIMAL_KEY_SLEEP,
+    [KEY_F13]           = MINIMAL_KEY_F13,
+    [KEY_F14]           = MINIMAL_KEY_F14,
+    [KEY_F15]           = MINIMAL_KEY_F15,
+    [KEY_F16]           = MINIMAL_KEY_F16,
+    [KEY_F17]           = MINIMAL_KEY_F17,
+    [KEY_F18]           = MINIMAL_KEY_F18,
+    [KEY_F19]           = MINIMAL_KEY_F19,
+    [KEY_F20]           = MINIMAL_KEY_F20,
+    [KEY_F21]           = MINIMAL_KEY_F21,
+    [KEY_F22]           = MINIMAL_KEY_F22,
+    [KEY_F23]           = MINIMAL_KEY_F23,
+    [KEY_F24]           = MINIMAL_KEY_F24,
+};
+
+static void minimalKeyboardKeymap(void* data, struct wl_keyboard* keyboard, uint32_t format, int32_t fd, uint32_t size)
+{
+    if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1)
+    {
+        close(fd);
+        return;
+    }
+
+    char* source = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (source == MAP_FAILED)
+    {
+        MINIMAL_ERROR("[Platform] Failed to map keymap");
+        return;
+    }
+
+    struct xkb_keymap* keymap = xkb_keymap_new_from_string(_minimalXkbContext, source, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    munmap(source, size);
+
+    if (!keymap)
+    {
+        MINIMAL_ERROR("[Platform] Failed to compile keymap");
+        return;
+    }
+
+    if (_minimalXkbState)   xkb_state_unref(_minimalXkbState);
+    if (_minimalXkbKeymap)  xkb_keymap_unref(_minimalXkbKeymap);
+
+    _minimalXkbKeymap = keymap;
+    _minimalXkbState = xkb_state_new(keymap);
+}
+
+static void minimalKeyboardEnter(void* data, struct wl_keyboard* keyboard, uint32_t serial, struct wl_surface* surface, struct wl_array* keys)
+{
+    // the surface is null if the client destroyed it in the meantime
+    _minimalKeyboardFocus = surface ? wl_surface_get_user_data(surface) : NULL;
+}
+
+static void minimalKeyboardLeave(void* data, struct wl_keyboard* keyboard, uint32_t serial, struct wl_surface* surface)
+{
+    _minimalKeyboardFocus = NULL;
+}
+
+static void minimalKeyboardKey(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t time, uint32_t key, uint32_t state)
+{
+    uint8_t action = state == WL_KEYBOARD_KEY_STATE_PRESSED;
+    uint8_t keys = MINIMAL_EVENT_ENABLED(_minimalKeyboardFocus, MINIMAL_EVENT_KEY);
+    uint8_t chars = action && MINIMAL_EVENT_ENABLED(_minimalKeyboardFocus, MINIMAL_EVENT_CHAR);
+    if (!keys && !chars) return;
+
+    MinimalKeycode keycode = key < 256 ? _minimalEvdevKeys[key] : 0;
+
+    minimalSetEventTime(minimalRebaseEventTime(time));
+
+    if (keys && minimalProcessKey(keycode, action))
+        minimalDispatchWindowEvent(_minimalKeyboardFocus, MINIMAL_EVENT_KEY, (uint32_t)keycode, action, _minimalKeyMods);
+
+    if (chars && _minimalXkbState)
+    {
+        // xkb keycodes are offset by 8 from evdev scancodes
+        uint32_t codepoint = xkb_state_key_get_utf32(_minimalXkbState, key + 8);
+        if (codepoint > 31)
+            minimalDispatchWindowEvent(_minimalKeyboardFocus, MINIMAL_EVENT_CHAR, codepoint, 0, _minimalKeyMods);
+    }
+
+    minimalSetEventTime(0);
+}
+
+static void minimalKeyboardModifiers(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t depressed, uint32_t latched, uint32_t locked, uint32_t group)
+{
+    if (!_minimalXkbState) return;
+
+    xkb_state_update_mask(_minimalXkbState, depressed, latched, locked, 0, 0, group);
+
+    uint32_t mods = 0;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_SHIFT, XKB_STATE_MODS_EFFECTIVE) > 0)  mods |= MINIMAL_KEY_MOD_SHIFT;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_CTRL, XKB_STATE_MODS_EFFECTIVE) > 0)   mods |= MINIMAL_KEY_MOD_CONTROL;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_ALT, XKB_STATE_MODS_EFFECTIVE) > 0)    mods |= MINIMAL_KEY_MOD_ALT;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_LOGO, XKB_STATE_MODS_EFFECTIVE) > 0)   mods |= MINIMAL_KEY_MOD_COMMAND;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_CAPS, XKB_STATE_MODS_EFFECTIVE) > 0)   mods |= MINIMAL_KEY_MOD_CAPS_LOCK;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_NUM, XKB_STATE_MODS_EFFECTIVE) > 0)    mods |= MINIMAL_KEY_MOD_NUM_LOCK;
+    _minimalKeyMods = mods;
+}
+
+static void minimalKeyboardRepeatInfo(void* data, struct wl_keyboard* keyboard, int32_t rate, int32_t delay) { }
+
+static const struct wl_keyboard_listener _minimalKeyboardListener = {
+    .keymap         = minimalKeyboardKeymap,
+    .enter          = minimalKeyboardEnter,
+    .leave          = minimalKeyboardLeave,
+    .key            = minimalKeyboardKey,
+    .modifiers      = minimalKeyboardModifiers,
+    .repeat_info    = minimalKeyboardRepeatInfo
+};
+
+/* --------------------------| pointer |--------------------------------- */
+static MinimalMouseButton minimalWaylandGetMouseButton(uint32_t button)
+{
+    switch (button)
+    {
+    case BTN_LEFT:      return MINIMAL_MOUSE_BUTTON_LEFT;
+    case BTN_RIGHT:     return MINIMAL_MOUSE_BUTTON_RIGHT;
+    case BTN_MIDDLE:    return MINIMAL_MOUSE_BUTTON_MIDDLE;
+    case BTN_SIDE:      return MINIMAL_MOUSE_BUTTON_4;
+    case BTN_EXTRA:     return MINIMAL_MOUSE_BUTTON_5;
+    case BTN_FORWARD:   return MINIMAL_MOUSE_BUTTON_6;
+    case BTN_BACK:      return MINIMAL_MOUSE_BUTTON_7;
+    case BTN_TASK:      return MINIMAL_MOUSE_BUTTON_8;
+    default:            return MINIMAL_MOUSE_BUTTON_UNKNOWN;
+    }
+}
+
+static void minimalPointerMotion(void* data, struct wl_pointer* pointer, uint32_t time, wl_fixed_t sx, wl_fixed_t sy)
+{
+    if (!MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_MOVED)) return;
+
+    _minimalCursorX = (float)wl_fixed_to_double(sx);
+    _minimalCursorY = (float)wl_fixed_to_double(sy);
+
+    // enter events have no timestamp and pass zero
+    minimalSetEventTime(time ? minimalRebaseEventTime(time) : 0);
+
+    if (minimalProcessMouseMove(_minimalCursorX, _minimalCursorY))
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_MOVED, 0, (int32_t)_minimalCursorX, (int32_t)_minimalCursorY);
+
+    minimalSetEventTime(0);
+}
+
+static void minimalPointerEnter(void* data, struct wl_pointer* pointer, uint32_t serial, struct wl_surface* surface, wl_fixed_t sx, wl_fixed_t sy)
+{
+    _minimalPointerFocus = surface ? wl_surface_get_user_data(surface) : NULL;
+    _minimalPointerSerial = serial;
+
+    // the cursor of a surface is set with the serial of its enter event
+    if (_minimalPointerFocus && _minimalPointerFocus->lockedPointer)
+        wl_pointer_set_cursor(pointer, serial, NULL, 0, 0);
+
+    minimalPointerMotion(data, pointer, 0, sx, sy);
+}
+
+static void minimalPointerLeave(void* data, struct wl_pointer* pointer, uint32_t serial, struct wl_surface* surface)
+{
+    if (_minimalPointerFocus) minimalResetMouseDelta(_minimalPointerFocus);
+
+    _minimalPointerFocus = NULL;
+    _minimalScrollX = 0.0;
+    _minimalScrollY = 0.0;
+}
+
+static void minimalPointerButton(void* data, struct wl_pointer* pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state)
+{
+    if (!MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_BUTTON)) return;
+
+    uint32_t action = state == WL_POINTER_BUTTON_STATE_PRESSED;
+    MinimalMouseButton mb = minimalWaylandGetMouseButton(button);
+    int32_t x = (int32_t)_minimalCursorX;
+    int32_t y = (int32_t)_minimalCursorY;
+
+    minimalSetEventTime(minimalRebaseEventTime(time));
+
+    if (minimalProcessMouseButton(mb, action))
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_BUTTON, ((uint32_t)mb << 16) + action, x, y);
+
+    minimalSetEventTime(0);
+}
+
+static void minimalPointerAxis(void* data, struct wl_pointer* pointer, uint32_t time, uint32_t axis, wl_fixed_t value)
+{
+    if (!MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_SCROLLED)) return;
+
+    // one wheel notch is reported as 10, positive values scroll down and right
+    double* remainder = axis == WL_POINTER_AXIS_VERTICAL_SCROLL ? &_minimalScrollY : &_minimalScrollX;
+    *remainder += wl_fixed_to_double(value) / 10.0;
+
+    // touchpads report fractions of a notch, whole notches are sent and the rest is kept
+    int32_t notches = (int32_t)*remainder;
+    *remainder -= notches;
+    if (!notches) return;
+
+    minimalSetEventTime(minimalRebaseEventTime(time));
+
+    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, -notches);
+    else
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_SCROLLED, 0, notches, 0);
+
+    minimalSetEventTime(0);
+}
+
+static void minimalPointerFrame(void* data, struct wl_pointer* pointer) { }
+static void minimalPointerAxisSource(void* data, struct wl_pointer* pointer, uint32_t source) { }
+static void minimalPointerAxisStop(void* data, struct wl_pointer* pointer, uint32_t time, uint32_t axis) { }
+static void minimalPointerAxisDiscrete(void* data, struct wl_pointer* pointer, uint32_t axis, int32_t discrete) { }
+
+static const struct wl_pointer_listener _minimalPointerListener = {
+    .enter          = minimalPointerEnter,
+    .leave          = minimalPointerLeave,
+    .motion         = minimalPointerMotion,
+    .button         = minimalPointerButton,
+    .axis           = minimalPointerAxis,
+    .frame          = minimalPointerFrame,
+    .axis_source    = minimalPointerAxisSource,
+    .axis_stop      = minimalPointerAxisStop,
+    .axis_discrete  = minimalPointerAxisDiscrete
+};
+
+static void minimalRelativePointerMotion(void* data, struct zwp_relative_pointer_v1* pointer, uint32_t utimeHi, uint32_t utimeLo,
+                                         wl_fixed_t dx, wl_fixed_t dy, wl_fixed_t dxUnaccel, wl_fixed_t dyUnaccel)
+{
+    if (!_minimalPointerFocus || !MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_RAW)) return;
+
+    // microseconds on the clock of the other input events, which report milliseconds
+    uint64_t utime = ((uint64_t)utimeHi << 32) | utimeLo;
+    minimalSetEventTime(minimalRebaseEventTime((uint32_t)(utime / 1000)));
+
+    // wl_fixed_t is 24.8 fixed point already
+    if (minimalProcessMouseRaw(dxUnaccel, dyUnaccel))
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_RAW, 0, dxUnaccel, dyUnaccel);
+
+    minimalSetEventTime(0);
+}
+
+static const struct zwp_relative_pointer_v1_listener _minimalRelativePointerListener = {
+    .relative_motion = minimalRelativePointerMotion
+};
+
+/* --------------------------| seat |------------------------------------ */
+static void minimalSeatCapabilities(void* data, struct wl_seat* seat, uint32_t caps)
+{
+    if ((caps & WL_SEAT_CAPABILITY_KEYBOARD) && !_minimalKeyboard)
+    {
+        _minimalKeyboard = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(_minimalKeyboard, &_minimalKeyboardListener, NULL);
+    }
+    else if (!(caps & WL_SEAT_CAPABILITY_KEYBOARD) && _minimalKeyboard)
+    {
+        wl_keyboard_destroy(_minimalKeyboard);
+        _minimalKeyboard = NULL;
+    }
+
+    if ((caps & WL_SEAT_CAPABILITY_POINTER) && !_minimalPointer)
+    {
+        _minimalPointer = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(_minimalPointer, &_minimalPointerListener, NULL);
+
+        // the manager is bound by the first roundtrip, capabilities arrive with the second
+        if (_minimalRelativePointerManager)
+        {
+            _minimalRelativePointer = zwp_relative_pointer_manager_v1_get_relative_pointer(_minimalRelativePointerManager, _minimalPointer);
+            zwp_relative_pointer_v1_add_listener(_minimalRelativePointer, &_minimalRelativePointerListener, NULL);
+        }
+    }
+    else if (!(caps & WL_SEAT_CAPABILITY_POINTER) && _minimalPointer)
+    {
+        if (_minimalRelativePointer) zwp_relative_pointer_v1_destroy(_minimalRelativePointer);
+        _minimalRelativePointer = NULL;
+
+        wl_pointer_destroy(_minimalPointer);
+        _minimalPointer = NULL;
+    }
+}
+
+static void minimalSeatName(void* data, struct wl_seat* seat, const char* name) { }
+
+static const struct wl_seat_listener _minimalSeatListener = {
+    .capabilities   = minimalSeatCapabilities,
+    .name           = minimalSeatName
+};
+
+/* --------------------------| framebuffer |----------------------------- */
+static void minimalBufferRelease(void* data, struct wl_buffer* buffer)
+{
+    MinimalWaylandFramebuffer* fb = data;
+    fb->busy = 0;
+}
+
+static const struct wl_buffer_listener _minimalBufferListener = {
+    .release = minimalBufferRelease
+};
+
+/* anonymous shared memory file, unlinked right away */
+static int minimalWaylandCreateShmFile(size_t size)
+{
+    static uint32_t counter = 0;
+
+    char name[64];
+    snprintf(name, sizeof(name), "/minimal-%d-%u", (int)getpid(), counter++);
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) return -1;
+
+    shm_unlink(name);
+
+    if (ftruncate(fd, (off_t)size) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static uint8_t minimalWaylandCreateBuffer(MinimalWindow* window, MinimalWaylandFramebuffer* fb)
+{
+    int32_t stride = (int32_t)window->framebufferWidth * 4;
+    size_t size = (size_t)stride * window->framebufferHeight;
+
+    int fd = minimalWaylandCreateShmFile(size);
+    if (fd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create shared memory file");
+        return MINIMAL_FAIL;
+    }
+
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED)
+    {
+        MINIMAL_ERROR("[Platform] Failed to map shared memory");
+        close(fd);
+        return MINIMAL_FAIL;
+    }
+
+    struct wl_shm_pool* pool = wl_shm_create_pool(_minimalShm, fd, (int32_t)size);
+    fb->buffer = wl_shm_pool_create_buffer(pool, 0, (int32_t)window->framebufferWidth, (int32_t)window->framebufferHeight, stride, WL_SHM_FORMAT_XRGB8888);
+    fb->pixels = memory;
+    fb->size = size;
+    fb->busy = 0;
+
+    wl_proxy_set_queue((struct wl_proxy*)fb->buffer, window->framebufferQueue);
+    wl_buffer_add_listener(fb->buffer, &_minimalBufferListener, fb);
+
+    wl_shm_pool_destroy(pool);
+    close(fd);
+
+    return MINIMAL_OK;
+}
+
+/* reads events into their queues and dispatches only the ones of queue */
+static void minimalWaylandDispatchQueue(struct wl_event_queue* queue, int timeout)
+{
+    while (wl_display_prepare_read_queue(_minimalDisplay, queue) != 0)
+    {
+        if (wl_display_dispatch_queue_pending(_minimalDisplay, queue) > 0)
+            timeout = 0;
+    }
+
+    wl_display_flush(_minimalDisplay);
+
+    struct pollfd fd = { .fd = wl_display_get_fd(_minimalDisplay), .events = POLLIN };
+    if (poll(&fd, 1, timeout) > 0 && (fd.revents & POLLIN))
+        wl_display_read_events(_minimalDisplay);
+    else
+        wl_display_cancel_read(_minimalDisplay);
+
+    wl_display_dispatch_queue_pending(_minimalDisplay, queue);
+}
+
+static MinimalWaylandFramebuffer* minimalWaylandFreeFramebuffer(MinimalWindow* window)
+{
+    for (uint32_t i = 1; i <= window->framebufferCount; ++i)
+    {
+        uint32_t index = (window->framebufferIndex + i) % window->framebufferCount;
+        if (!window->framebuffers[index].busy)
+        {
+            window->framebufferIndex = index;
+            return &window->framebuffers[index];
+        }
+    }
+    return NULL;
+}
+
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    if (!_minimalShm)
+    {
+        MINIMAL_ERROR("[Platform] Compositor does not support wl_shm");
+        return NULL;
+    }
+
+    window->framebufferQueue = wl_display_create_queue(_minimalDisplay);
+    window->framebufferWidth = w;
+    window->framebufferHeight = h;
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        if (!minimalWaylandCreateBuffer(window, &window->framebuffers[i]))
+        {
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+        window->framebufferCount++;
+    }
+
+    window->framebufferIndex = 0;
+    return window->framebuffers[0].pixels;
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (uint32_t i = 0; i < window->framebufferCount; ++i)
+    {
+        wl_buffer_destroy(window->framebuffers[i].buffer);
+        munmap(window->framebuffers[i].pixels, window->framebuffers[i].size);
+    }
+    memset(window->framebuffers, 0, sizeof(window->framebuffers));
+    window->framebufferCount = 0;
+    window->framebufferIndex = 0;
+
+    if (window->framebufferQueue)
+        wl_event_queue_destroy(window->framebufferQueue);
+
+    window->framebufferQueue = NULL;
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    if (!window->framebufferCount) return NULL;
+
+    MinimalWaylandFramebuffer* current = &window->framebuffers[window->framebufferIndex];
+
+    minimalWaylandRequestFrame(window);
+
+    wl_surface_attach(window->surface, current->buffer, 0, 0);
+    wl_surface_damage(window->surface, 0, 0, INT32_MAX, INT32_MAX);
+    wl_surface_commit(window->surface);
+    current->busy = 1;
+
+    // pick up releases without blocking, input stays queued for the next poll
+    minimalWaylandDispatchQueue(window->framebufferQueue, 0);
+    MinimalWaylandFramebuffer* next = minimalWaylandFreeFramebuffer(window);
+
+    // the compositor still reads from every buffer, draw into a new one instead
+    if (!next && window->framebufferCount < MINIMAL_WAYLAND_FRAMEBUFFER_MAX)
+    {
+        next = &window->framebuffers[window->framebufferCount];
+        if (!minimalWaylandCreateBuffer(window, next)) return NULL;
+
+        window->framebufferIndex = window->framebufferCount++;
+    }
+
+    // a busy buffer is never handed out, wait for the compositor to release one
+    while (!next && !window->shouldClose)
+    {
+        if (wl_display_get_error(_minimalDisplay)) return NULL;
+
+        minimalWaylandDispatchQueue(window->framebufferQueue, MINIMAL_WAYLAND_FRAME_TIMEOUT);
+        next = minimalWaylandFreeFramebuffer(window);
+    }
+
+    return next ? next->pixels : NULL;
+}
+
+/* --------------------------| egl |------------------------------------- */
+#ifndef MINIMAL_NO_CONTEXT
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    // request the next frame before the swap commits the surface
+    minimalWaylandRequestFrame(context);
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    _minimalSwapInterval = interval;
+}
+
+#endif // !MINIMAL_NO_CONTEXT
+
+#endif // MINIMAL_PLATFORM_WAYLAND
+
+
+
+#ifdef MINIMAL_PLATFORM_HEADLESS
+
+#include <sys/eventfd.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef MINIMAL_NO_CONTEXT
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA   0x31DD
+#endif
+#endif
+
+static uint64_t _minimalTimerOffset = 0;
+
+/* signalled by minimalWakeWindow to interrupt minimalWaitWindowEvents */
+static int      _minimalWakeFd = -1;
+
+uint8_t minimalPlatformInit()
+{
+    // init time
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        MINIMAL_ERROR("[Platform] Monotonic clock is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalTimerOffset = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    minimalInitTicks();
+
+    _minimalWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_minimalWakeFd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create wakeup eventfd");
+        return MINIMAL_FAIL;
+    }
+
+#ifndef MINIMAL_NO_CONTEXT
+    // init egl without any windowing system
+    if (!minimalEGLInit(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+    if (_minimalWakeFd >= 0)
+    {
+        close(_minimalWakeFd);
+        _minimalWakeFd = -1;
+    }
+
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLTerminate();
+#endif
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+#ifndef MINIMAL_HEADLESS_QUEUE_SIZE
+#define MINIMAL_HEADLESS_QUEUE_SIZE 256
+#endif
+
+typedef struct
+{
+    uint32_t type;
+    uint32_t uParam;
+    int32_t lParam;
+    int32_t rParam;
+} MinimalInjectedEvent;
+
+struct MinimalWindow
+{
+#ifndef MINIMAL_NO_CONTEXT
+    MinimalEGLContext egl;
+#endif
+
+    uint32_t width;
+    uint32_t height;
+
+    uint8_t shouldClose;
+    uint32_t eventMask;
+
+    uint32_t* framebuffers[MINIMAL_FRAMEBUFFER_COUNT];
+    uint32_t framebufferIndex;
+
+    MinimalInjectedEvent queue[MINIMAL_HEADLESS_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t count;
+
+    MinimalWindow* next;
+};
+
+/* all open windows, there is no native handle to look them up by */
+static MinimalWindow* _minimalWindows = NULL;
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->width = w;
+    window->height = h;
+    window->shouldClose = 0;
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    window->next = _minimalWindows;
+    _minimalWindows = window;
+
+#ifndef MINIMAL_NO_CONTEXT
+
+    if (windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API)
+        return window;
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    // offscreen surface sized like the requested window
+    if (!minimalEGLCreateContext(&window->egl, NULL, w, h, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    for (MinimalWindow** it = &_minimalWindows; *it; it = &(*it)->next)
+    {
+        if (*it == window)
+        {
+            *it = window->next;
+            break;
+        }
+    }
+
+    minimalDestroyFramebuffer(window);
+    minimalResetMouseDelta(window);
+
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLDestroyContext(&window->egl);
+#endif
+
+    free(window);
+}
+
+uint8_t minimalInjectEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
+{
+    if (window->count >= MINIMAL_HEADLESS_QUEUE_SIZE)
+    {
+        MINIMAL_WARN("[Platform] Injected event queue is full");
+        return MINIMAL_FAIL;
+    }
+
+    uint32_t index = (window->head + window->count) % MINIMAL_HEADLESS_QUEUE_SIZE;
+    window->queue[index] = (MinimalInjectedEvent){ .type = type, .uParam = uParam, .lParam = lParam, .rParam = rParam };
+    window->count++;
+
+    return MINIMAL_OK;
+}
+
+static void minimalHeadlessProcessEvent(MinimalWindow* context, const MinimalInjectedEvent* e)
+{
+    // the size is tracked even while its event is disabled
+    if (e->type == MINIMAL_EVENT_WINDOW_SIZE)
+    {
+        context->width = (uint32_t)e->lParam;
+        context->height = (uint32_t)e->rParam;
+    }
+
+    if (e->type <= MINIMAL_EVENT_LAST && !MINIMAL_EVENT_ENABLED(context, e->type)) return;
+
+    switch (e->type)
+    {
+    case MINIMAL_EVENT_KEY:
+        if (minimalProcessKey((MinimalKeycode)e->uParam, (uint8_t)e->lParam))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    case MINIMAL_EVENT_MOUSE_BUTTON:
+    {
+        MinimalMouseButton button = (MinimalMouseButton)(e->uParam >> 16);
+        uint8_t action = (uint8_t)(e->uParam & 0xffff);
+
+        if (minimalProcessMouseButton(button, action))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    }
+    case MINIMAL_EVENT_MOUSE_MOVED:
+        if (minimalProcessMouseMove((float)e->lParam, (float)e->rParam))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    case MINIMAL_EVENT_MOUSE_RAW:
+        if (minimalProcessMouseRaw(e->lParam, e->rParam))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    default:
+        minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    }
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    while (context->count)
+    {
+        MinimalInjectedEvent e = context->queue[context->head];
+        context->head = (context->head + 1) % MINIMAL_HEADLESS_QUEUE_SIZE;
+        context->count--;
+
+        minimalHeadlessProcessEvent(context, &e);
+    }
+
+    minimalFlushEvents();
+}
+
+void minimalPollAllEvents()
+{
+    for (MinimalWindow* window = _minimalWindows; window; window = window->next)
+        minimalPollWindowEvents(window);
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    // injected events are the only input, without them there is only the wakeup to wait for
+    if (!context->count)
+    {
+        int ms = -1;
+        if (timeout != MINIMAL_WAIT_INFINITE)
+        {
+            // rounded up so short waits do not turn into spins
+            uint64_t value = (timeout + 999999) / 1000000;
+            ms = value > INT_MAX ? INT_MAX : (int)value;
+        }
+
+        struct pollfd fd = { .fd = _minimalWakeFd, .events = POLLIN };
+        if (poll(&fd, 1, ms) > 0)
+        {
+            uint64_t value;
+            while (read(_minimalWakeFd, &value, sizeof(value)) > 0);
+        }
+    }
+
+    minimalPollWindowEvents(context);
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    // only fails if the counter is already full, which wakes the wait as well
+    uint64_t value = 1;
+    ssize_t result = write(_minimalWakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title) { }
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window) { }
+void minimalMinimize(MinimalWindow* window) { }
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock) { }
+
+uint64_t minimalGetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t value = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    return value - _minimalTimerOffset;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    if (xscale) *xscale = 1.0f;
+    if (yscale) *yscale = 1.0f;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return NULL;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return NULL;
+}
+
+/* --------------------------| framebuffer |----------------------------- */
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
     {
-        MINIMAL_ERROR("[WGL] Failed to create helper window");
-        return MINIMAL_FAIL;
+        window->framebuffers[i] = calloc((size_t)w * h, sizeof(uint32_t));
+        if (!window->framebuffers[i])
+        {
+            MINIMAL_ERROR("[Platform] Failed to allocate framebuffer");
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
     }
 
-    MSG msg;
-    while (PeekMessageW(&msg, helperWnd, 0, 0, PM_REMOVE))
+    window->framebufferIndex = 0;
+    return window->framebuffers[0];
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
     {
-        TranslateMessage(&msg);
-        DispatchMessageW(&msg);
+        free(window->framebuffers[i]);
+        window->framebuffers[i] = NULL;
     }
+}
 
-    HDC dc = GetDC(helperWnd);
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    // nothing reads the buffers, presenting only flips them
+    window->framebufferIndex = (window->framebufferIndex + 1) % MINIMAL_FRAMEBUFFER_COUNT;
+    return window->framebuffers[window->framebufferIndex];
+}
 
-    PIXELFORMATDESCRIPTOR pfd = {
-        .nSize = sizeof(pfd),
-        .nVersion = 1,
-        .dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER,
-        .iPixelType = PFD_TYPE_RGBA,
-        .cColorBits = 24,
-    };
+/* --------------------------| egl |------------------------------------- */
+#ifndef MINIMAL_NO_CONTEXT
 
-    if (!SetPixelFormat(dc, ChoosePixelFormat(dc, &pfd), &pfd))
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    // there is nothing to present, swapping a pbuffer has no effect
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    minimalEGLSwapInterval(interval);
+}
+
+#endif // !MINIMAL_NO_CONTEXT
+
+#endif // MINIMAL_PLATFORM_HEADLESS
+
+
+
+#ifdef MINIMAL_CONTEXT_EGL
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       (void*)LoadLibraryA(name)
+    #define MINIMAL_FREE_MODULE(module)     FreeLibrary((HMODULE)(module))
+    #define MINIMAL_MODULE_SYMBOL(m, name)  (void*)GetProcAddress((HMODULE)(m), name)
+#else
+    #include <dlfcn.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       dlopen(name, RTLD_LAZY | RTLD_LOCAL)
+    #define MINIMAL_FREE_MODULE(module)     dlclose(module)
+    #define MINIMAL_MODULE_SYMBOL(m, name)  dlsym(m, name)
+#endif
+
+#ifndef EGL_NO_CONFIG_KHR
+#define EGL_NO_CONFIG_KHR               ((EGLConfig)0)
+#endif
+
+typedef EGLDisplay(EGLAPIENTRY* eglGetPlatformDisplayEXT_T)(EGLenum, void*, const EGLint*);
+
+/* libraries exporting the core symbols of the bound client api */
+#ifdef _WIN32
+static const char* _minimalGLModules[]      = { "opengl32.dll", NULL };
+static const char* _minimalGLESModules[]    = { "libGLESv2.dll", NULL };
+#else
+static const char* _minimalGLModules[]      = { "libOpenGL.so.0", "libGL.so.1", NULL };
+static const char* _minimalGLESModules[]    = { "libGLESv2.so.2", NULL };
+#endif
+
+static EGLDisplay _minimalEGLDisplay = EGL_NO_DISPLAY;
+static EGLenum    _minimalEGLApi = EGL_OPENGL_API;
+static void*      _minimalEGLModule = NULL;
+
+static uint8_t _minimalEGLSurfaceless = 0;
+static uint8_t _minimalEGLNoConfig = 0;
+
+static uint8_t minimalEGLHasExtension(const char* extensions, const char* name)
+{
+    if (!extensions) return 0;
+
+    size_t len = strlen(name);
+    const char* start = extensions;
+    while ((start = strstr(start, name)) != NULL)
     {
-        MINIMAL_ERROR("[WGL] Failed to set pixel format for dummy context");
-        return MINIMAL_FAIL;
+        const char* end = start + len;
+        if ((start == extensions || start[-1] == ' ') && (*end == ' ' || *end == '\0'))
+            return 1;
+        start = end;
     }
+    return 0;
+}
 
-    HGLRC rc = wglCreateContext(dc);
-    if (!rc)
+uint8_t minimalEGLInit(uint32_t platform, void* nativeDisplay)
+{
+    // client extensions are queried without a display
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (platform && minimalEGLHasExtension(clientExtensions, "EGL_EXT_platform_base"))
     {
-        MINIMAL_ERROR("[WGL] Failed to create dummy context");
-        return MINIMAL_FAIL;
+        eglGetPlatformDisplayEXT_T getPlatformDisplay = (eglGetPlatformDisplayEXT_T)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+            _minimalEGLDisplay = getPlatformDisplay(platform, nativeDisplay, NULL);
     }
 
-    HDC   pdc = wglGetCurrentDC();
-    HGLRC prc = wglGetCurrentContext();
+    if (_minimalEGLDisplay == EGL_NO_DISPLAY)
+        _minimalEGLDisplay = eglGetDisplay((EGLNativeDisplayType)nativeDisplay);
 
-    if (!wglMakeCurrent(dc, rc))
+    if (_minimalEGLDisplay == EGL_NO_DISPLAY)
     {
-        MINIMAL_ERROR("[WGL] Failed to make dummy context current");
-        wglMakeCurrent(pdc, prc);
-        wglDeleteContext(rc);
+        MINIMAL_ERROR("[EGL] Failed to get display");
         return MINIMAL_FAIL;
     }
 
-    _wglCreateContextAttrARB =  (wglCreateContextAttribsARB_T)wglGetProcAddress("wglCreateContextAttribsARB");
-    _wglSwapIntervalEXT =       (wglSwapIntervalEXT_T)wglGetProcAddress("wglSwapIntervalEXT");
-    _wglChoosePixelFormatARB =  (wglChoosePixelFormatARB_T)wglGetProcAddress("wglChoosePixelFormatARB");
-
-    wglMakeCurrent(pdc, prc);
-    wglDeleteContext(rc);
-
-    // destroy helper window
-    if (!DestroyWindow(helperWnd))
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(_minimalEGLDisplay, &major, &minor))
     {
-        MINIMAL_ERROR("[WGL] Failed to destroy helper window");
+        MINIMAL_ERROR("[EGL] Failed to initialize display (0x%04x)", eglGetError());
+        _minimalEGLDisplay = EGL_NO_DISPLAY;
         return MINIMAL_FAIL;
     }
 
+    // prefer desktop opengl, drivers like angle only provide gles
+    _minimalEGLApi = EGL_OPENGL_API;
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        _minimalEGLApi = EGL_OPENGL_ES_API;
+        if (!eglBindAPI(EGL_OPENGL_ES_API))
+        {
+            MINIMAL_ERROR("[EGL] Neither OpenGL nor OpenGL ES is supported");
+            minimalEGLTerminate();
+            return MINIMAL_FAIL;
+        }
+    }
+
+    const char** modules = _minimalEGLApi == EGL_OPENGL_API ? _minimalGLModules : _minimalGLESModules;
+    for (int i = 0; modules[i] && !_minimalEGLModule; ++i)
+        _minimalEGLModule = MINIMAL_LOAD_MODULE(modules[i]);
+
+    if (!_minimalEGLModule)
+        MINIMAL_WARN("[EGL] Failed to load client library, resolving symbols through eglGetProcAddress");
+
+    const char* extensions = eglQueryString(_minimalEGLDisplay, EGL_EXTENSIONS);
+    _minimalEGLSurfaceless = minimalEGLHasExtension(extensions, "EGL_KHR_surfaceless_context");
+    _minimalEGLNoConfig = minimalEGLHasExtension(extensions, "EGL_KHR_no_config_context")
+                       || minimalEGLHasExtension(extensions, "EGL_MESA_configless_context");
+
     return MINIMAL_OK;
 }
 
-void minimalWGLTerminate()
+void minimalEGLTerminate()
 {
-    if (glModule)
-        FreeLibrary(glModule);
+    if (_minimalEGLDisplay != EGL_NO_DISPLAY)
+    {
+        eglTerminate(_minimalEGLDisplay);
+        _minimalEGLDisplay = EGL_NO_DISPLAY;
+    }
+
+    if (_minimalEGLModule)
+    {
+        MINIMAL_FREE_MODULE(_minimalEGLModule);
+        _minimalEGLModule = NULL;
+    }
 }
 
-HGLRC minimalCreateRenderContext(HDC dc)
+static uint8_t minimalEGLChooseConfig(EGLint surfaceType, EGLConfig* config)
 {
-    int pfAttribs[] = {
-        WGL_DRAW_TO_WINDOW_ARB,     1,
-        WGL_SUPPORT_OPENGL_ARB,     1,
-        WGL_DOUBLE_BUFFER_ARB,      1,
-        WGL_ACCELERATION_ARB,       WGL_FULL_ACCELERATION_ARB,
-        WGL_PIXEL_TYPE_ARB,         WGL_TYPE_RGBA_ARB,
-        WGL_COLOR_BITS_ARB,         32,
-        WGL_DEPTH_BITS_ARB,         24,
-        WGL_STENCIL_BITS_ARB,       8,
-        0
+    EGLint cfgAttribs[] = {
+        EGL_SURFACE_TYPE,       surfaceType,
+        EGL_RENDERABLE_TYPE,    _minimalEGLApi == EGL_OPENGL_API ? EGL_OPENGL_BIT : EGL_OPENGL_ES3_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_NONE
     };
 
-    int format;
-    UINT formatCount;
-    _wglChoosePixelFormatARB(dc, pfAttribs, 0, 1, &format, &formatCount);
-    if (!formatCount)
+    EGLint count = 0;
+    return eglChooseConfig(_minimalEGLDisplay, cfgAttribs, config, 1, &count) && count;
+}
+
+/*
+ * Without a native window the context renders into a pbuffer of the given size.
+ * A size of zero, or a driver without pbuffer configs, creates a surfaceless
+ * context instead, which skips config selection when EGL_KHR_no_config_context
+ * is available. Surfaceless contexts have no default framebuffer.
+ */
+uint8_t minimalEGLCreateContext(MinimalEGLContext* egl, void* nativeWindow, uint32_t w, uint32_t h, int32_t major, int32_t minor)
+{
+    egl->surface = EGL_NO_SURFACE;
+    egl->context = EGL_NO_CONTEXT;
+
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    EGLint surfaceType = nativeWindow ? EGL_WINDOW_BIT : EGL_PBUFFER_BIT;
+
+    if (!nativeWindow && (!w || !h))
+        surfaceType = 0;
+
+    if (surfaceType && !minimalEGLChooseConfig(surfaceType, &config))
     {
-        MINIMAL_ERROR("[WGL] Could not find a suitable pixel format");
-        return NULL;
+        if (nativeWindow || !_minimalEGLSurfaceless)
+        {
+            MINIMAL_ERROR("[EGL] Could not find a suitable config");
+            return MINIMAL_FAIL;
+        }
+        surfaceType = 0;
     }
 
-    PIXELFORMATDESCRIPTOR pfd;
-    if (!DescribePixelFormat(dc, format, sizeof(pfd), &pfd))
+    if (!surfaceType && !_minimalEGLSurfaceless)
     {
-        MINIMAL_ERROR("[WGL] Failed to retrieve PFD");
-        return NULL;
+        MINIMAL_ERROR("[EGL] Surfaceless contexts are not supported");
+        return MINIMAL_FAIL;
     }
 
-    if (!SetPixelFormat(dc, format, &pfd))
+    if (!surfaceType && !_minimalEGLNoConfig && !minimalEGLChooseConfig(0, &config))
     {
-        MINIMAL_ERROR("[WGL] Failed to set pixel format");
-        return NULL;
+        MINIMAL_ERROR("[EGL] Could not find a suitable config");
+        return MINIMAL_FAIL;
     }
 
-    int glAttribs[] = {
-        WGL_CONTEXT_MAJOR_VERSION_ARB,  windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION],
-        WGL_CONTEXT_MINOR_VERSION_ARB,  windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION],
-        WGL_CONTEXT_PROFILE_MASK_ARB,   WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+    EGLint glAttribs[16];
+    int i = 0;
+
+    // without a version hint the driver picks its default
+    if (major > 0)
+    {
+        glAttribs[i++] = EGL_CONTEXT_MAJOR_VERSION; glAttribs[i++] = major;
+        glAttribs[i++] = EGL_CONTEXT_MINOR_VERSION; glAttribs[i++] = minor;
+    }
+
+    if (_minimalEGLApi == EGL_OPENGL_API && (major > 3 || (major == 3 && minor >= 2)))
+    {
+        glAttribs[i++] = EGL_CONTEXT_OPENGL_PROFILE_MASK;   glAttribs[i++] = EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT;
+    }
 #ifdef _DEBUG
-        WGL_CONTEXT_FLAGS_ARB,          WGL_CONTEXT_DEBUG_BIT_ARB,
+    glAttribs[i++] = EGL_CONTEXT_OPENGL_DEBUG;              glAttribs[i++] = EGL_TRUE;
 #endif // _DEBUG
-        0,
-    };
+    glAttribs[i] = EGL_NONE;
 
-    HGLRC rc = _wglCreateContextAttrARB(dc, 0, glAttribs);
-    if (!rc)
+    egl->context = eglCreateContext(_minimalEGLDisplay, config, EGL_NO_CONTEXT, glAttribs);
+    if (egl->context == EGL_NO_CONTEXT)
     {
-        MINIMAL_ERROR("[WGL] Failed to create render context");
+        MINIMAL_ERROR("[EGL] Failed to create render context (0x%04x)", eglGetError());
         return MINIMAL_FAIL;
     }
 
-    if (!wglMakeCurrent(dc, rc))
+    if (surfaceType == EGL_WINDOW_BIT)
     {
-        MINIMAL_ERROR("[WGL] Failed to make render context current");
+        egl->surface = eglCreateWindowSurface(_minimalEGLDisplay, config, (EGLNativeWindowType)(uintptr_t)nativeWindow, NULL);
+    }
+    else if (surfaceType == EGL_PBUFFER_BIT)
+    {
+        EGLint pbAttribs[] = { EGL_WIDTH, (EGLint)w, EGL_HEIGHT, (EGLint)h, EGL_NONE };
+        egl->surface = eglCreatePbufferSurface(_minimalEGLDisplay, config, pbAttribs);
+    }
+
+    if (surfaceType && egl->surface == EGL_NO_SURFACE)
+    {
+        MINIMAL_ERROR("[EGL] Failed to create surface (0x%04x)", eglGetError());
+        minimalEGLDestroyContext(egl);
         return MINIMAL_FAIL;
     }
 
-    return rc;
+    if (!eglMakeCurrent(_minimalEGLDisplay, egl->surface, egl->surface, egl->context))
+    {
+        MINIMAL_ERROR("[EGL] Failed to make render context current (0x%04x)", eglGetError());
+        minimalEGLDestroyContext(egl);
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+void minimalEGLDestroyContext(MinimalEGLContext* egl)
+{
+    if (egl->context != EGL_NO_CONTEXT && eglGetCurrentContext() == egl->context)
+        eglMakeCurrent(_minimalEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    if (egl->surface != EGL_NO_SURFACE)
+        eglDestroySurface(_minimalEGLDisplay, egl->surface);
+
+    if (egl->context != EGL_NO_CONTEXT)
+        eglDestroyContext(_minimalEGLDisplay, egl->context);
+
+    egl->surface = EGL_NO_SURFACE;
+    egl->context = EGL_NO_CONTEXT;
+}
+
+void minimalEGLSwapBuffers(MinimalEGLContext* egl)
+{
+    if (egl->surface != EGL_NO_SURFACE)
+        eglSwapBuffers(_minimalEGLDisplay, egl->surface);
+}
+
+void minimalEGLSwapInterval(int32_t interval)
+{
+    eglSwapInterval(_minimalEGLDisplay, interval);
 }
 
 void* minimalGetGLProcAddress(const char* name)
 {
-    void* p = (void*)wglGetProcAddress(name);
-    if (p) return p;
+    // core symbols come straight from the client library
+    if (_minimalEGLModule)
+    {
+        void* p = MINIMAL_MODULE_SYMBOL(_minimalEGLModule, name);
+        if (p) return p;
+    }
 
-    return (void*)GetProcAddress(glModule, name);;
+    return (void*)eglGetProcAddress(name);
 }
 
-void minimalSwapBuffers(MinimalWindow* context)
+#endif // MINIMAL_CONTEXT_EGL
+
+
+
+#ifndef MINIMAL_LOAD_MODULE
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       (void*)LoadLibraryA(name)
+    #define MINIMAL_FREE_MODULE(module)     FreeLibrary((HMODULE)(module))
+    #define MINIMAL_MODULE_SYMBOL(m, name)  (void*)GetProcAddress((HMODULE)(m), name)
+#else
+    #include <dlfcn.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       dlopen(name, RTLD_LAZY | RTLD_LOCAL)
+    #define MINIMAL_FREE_MODULE(module)     dlclose(module)
+    #define MINIMAL_MODULE_SYMBOL(m, name)  dlsym(m, name)
+#endif
+#endif
+
+#ifdef _WIN32
+    #define MINIMAL_VKAPI __stdcall
+#else
+    #define MINIMAL_VKAPI
+#endif
+
+/* the subset of vulkan.h needed for surface creation, so vulkan headers stay optional */
+#ifndef VK_VERSION_1_0
+typedef struct VkInstance_T* VkInstance;
+typedef uint64_t VkSurfaceKHR;
+typedef int32_t VkResult;
+typedef struct VkAllocationCallbacks VkAllocationCallbacks;
+
+#define VK_SUCCESS                          0
+#define VK_ERROR_INITIALIZATION_FAILED      -3
+#define VK_ERROR_EXTENSION_NOT_PRESENT      -7
+#endif
+
+typedef void (MINIMAL_VKAPI* MinimalVkVoidFunction)(void);
+typedef MinimalVkVoidFunction(MINIMAL_VKAPI* MinimalVkGetInstanceProcAddr)(VkInstance, const char*);
+
+/* every surface create function has the same signature, only the create info differs */
+typedef VkResult(MINIMAL_VKAPI* MinimalVkCreateSurface)(VkInstance, const void*, const VkAllocationCallbacks*, VkSurfaceKHR*);
+
+typedef struct
 {
-    SwapBuffers(context->deviceContext);
+    int32_t     sType;
+    const void* pNext;
+    uint32_t    flags;
+    void*       display;
+    void*       window;
+} MinimalVkSurfaceCreateInfo;
+
+#if defined(MINIMAL_PLATFORM_WINDOWS)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_KHR_win32_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateWin32SurfaceKHR"
+    #define MINIMAL_VK_SURFACE_STYPE        1000009000
+#elif defined(MINIMAL_PLATFORM_X11)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_KHR_xlib_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateXlibSurfaceKHR"
+    #define MINIMAL_VK_SURFACE_STYPE        1000004000
+#elif defined(MINIMAL_PLATFORM_WAYLAND)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_KHR_wayland_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateWaylandSurfaceKHR"
+    #define MINIMAL_VK_SURFACE_STYPE        1000006000
+#elif defined(MINIMAL_PLATFORM_HEADLESS)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_EXT_headless_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateHeadlessSurfaceEXT"
+    #define MINIMAL_VK_SURFACE_STYPE        1000256000
+#endif
+
+#ifdef MINIMAL_VK_SURFACE_EXTENSION
+
+#ifdef _WIN32
+static const char* _minimalVulkanModules[] = { "vulkan-1.dll", NULL };
+#else
+static const char* _minimalVulkanModules[] = { "libvulkan.so.1", "libvulkan.so", NULL };
+#endif
+
+static const char* _minimalVulkanExtensions[] = { "VK_KHR_surface", MINIMAL_VK_SURFACE_EXTENSION };
+
+static void* _minimalVulkanModule = NULL;
+static MinimalVkGetInstanceProcAddr _minimalVkGetInstanceProcAddr = NULL;
+
+/* the loader is looked up once and kept for the lifetime of the process */
+static uint8_t minimalLoadVulkan()
+{
+    if (_minimalVkGetInstanceProcAddr) return MINIMAL_OK;
+
+    for (int i = 0; _minimalVulkanModules[i] && !_minimalVulkanModule; ++i)
+        _minimalVulkanModule = MINIMAL_LOAD_MODULE(_minimalVulkanModules[i]);
+
+    if (!_minimalVulkanModule)
+    {
+        MINIMAL_ERROR("[Vulkan] Failed to load the vulkan loader");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalVkGetInstanceProcAddr = (MinimalVkGetInstanceProcAddr)MINIMAL_MODULE_SYMBOL(_minimalVulkanModule, "vkGetInstanceProcAddr");
+    if (!_minimalVkGetInstanceProcAddr)
+    {
+        MINIMAL_ERROR("[Vulkan] Loader does not export vkGetInstanceProcAddr");
+        MINIMAL_FREE_MODULE(_minimalVulkanModule);
+        _minimalVulkanModule = NULL;
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
 }
 
-void minimalSwapInterval(uint8_t interval)
+const char** minimalGetRequiredVulkanInstanceExtensions(uint32_t* count)
 {
-    if (_wglSwapIntervalEXT) _wglSwapIntervalEXT(interval);
+    if (count) *count = 0;
+    if (!minimalLoadVulkan()) return NULL;
+
+    if (count) *count = sizeof(_minimalVulkanExtensions) / sizeof(_minimalVulkanExtensions[0]);
+    return _minimalVulkanExtensions;
 }
 
-#endif // !MINIMAL_NO_CONTEXT
+VkResult minimalCreateVulkanSurface(VkInstance instance, const MinimalWindow* window, const VkAllocationCallbacks* allocator, VkSurfaceKHR* surface)
+{
+    *surface = 0;
+    if (!minimalLoadVulkan()) return VK_ERROR_INITIALIZATION_FAILED;
+
+    MinimalVkCreateSurface createSurface = (MinimalVkCreateSurface)_minimalVkGetInstanceProcAddr(instance, MINIMAL_VK_SURFACE_CREATE);
+    if (!createSurface)
+    {
+        MINIMAL_ERROR("[Vulkan] Instance was created without " MINIMAL_VK_SURFACE_EXTENSION);
+        return VK_ERROR_EXTENSION_NOT_PRESENT;
+    }
+
+    // display and window share the layout of the platform create infos, headless ignores them
+    MinimalVkSurfaceCreateInfo info = {
+        .sType      = MINIMAL_VK_SURFACE_STYPE,
+        .pNext      = NULL,
+        .flags      = 0,
+        .display    = minimalGetNativeDisplayHandle(),
+        .window     = minimalGetNativeWindowHandle(window)
+    };
+
+    VkResult result = createSurface(instance, &info, allocator, surface);
+    if (result != VK_SUCCESS)
+    {
+        MINIMAL_ERROR("[Vulkan] Failed to create surface (%d)", (int)result);
+    }
+
+    return result;
+}
+
+#endif // MINIMAL_VK_SURFACE_EXTENSION
 
-#endif // MINIMAL_PLATFORM_WINDOWS
 
 #endif /* !MINIMAL_IMPLEMENTATION */
 
@@ -21,9 +21,12 @@ def createSingleheader(name: str, dir: str, header: str, sources: list[str]) ->
         out.write(f"#ifdef {define}\n")
 
         # source files
+        # everything up to the include of the header is left out, the header covers it
         for file in sources:
             with open(f"./{dir}/{file}") as f:
-                out.writelines(f.readlines()[1:])
+                lines = f.readlines()
+                start = next(i for i, line in enumerate(lines) if line.startswith(f'#include "{header}"'))
+                out.writelines(lines[start + 1:])
                 out.write("\n\n")
 
         out.write(f"#endif /* !{define} */\n\n")
@@ -41,7 +44,14 @@ if __name__ == '__main__':
         "minimal.c",
         "input.c",
         "event.c",
-        "platform_windows.c"
+        "record.c",
+        "gamepad.c",
+        "platform_windows.c",
+        "platform_x11.c",
+        "platform_wayland.c",
+        "platform_headless.c",
+        "context_egl.c",
+        "vulkan.c"
     ]
 
     createSingleheader("minimal", "src", header, sources)
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "minimal.h"
+
+#ifdef MINIMAL_CONTEXT_EGL
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       (void*)LoadLibraryA(name)
+    #define MINIMAL_FREE_MODULE(module)     FreeLibrary((HMODULE)(module))
+    #define MINIMAL_MODULE_SYMBOL(m, name)  (void*)GetProcAddress((HMODULE)(m), name)
+#else
+    #include <dlfcn.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       dlopen(name, RTLD_LAZY | RTLD_LOCAL)
+    #define MINIMAL_FREE_MODULE(module)     dlclose(module)
+    #define MINIMAL_MODULE_SYMBOL(m, name)  dlsym(m, name)
+#endif
+
+#ifndef EGL_NO_CONFIG_KHR
+#define EGL_NO_CONFIG_KHR               ((EGLConfig)0)
+#endif
+
+typedef EGLDisplay(EGLAPIENTRY* eglGetPlatformDisplayEXT_T)(EGLenum, void*, const EGLint*);
+
+/* libraries exporting the core symbols of the bound client api */
+#ifdef _WIN32
+static const char* _minimalGLModules[]      = { "opengl32.dll", NULL };
+static const char* _minimalGLESModules[]    = { "libGLESv2.dll", NULL };
+#else
+static const char* _minimalGLModules[]      = { "libOpenGL.so.0", "libGL.so.1", NULL };
+static const char* _minimalGLESModules[]    = { "libGLESv2.so.2", NULL };
+#endif
+
+static EGLDisplay _minimalEGLDisplay = EGL_NO_DISPLAY;
+static EGLenum    _minimalEGLApi = EGL_OPENGL_API;
+static void*      _minimalEGLModule = NULL;
+
+static uint8_t _minimalEGLSurfaceless = 0;
+static uint8_t _minimalEGLNoConfig = 0;
+
+static uint8_t minimalEGLHasExtension(const char* extensions, const char* name)
+{
+    if (!extensions) return 0;
+
+    size_t len = strlen(name);
+    const char* start = extensions;
+    while ((start = strstr(start, name)) != NULL)
+    {
+        const char* end = start + len;
+        if ((start == extensions || start[-1] == ' ') && (*end == ' ' || *end == '\0'))
+            return 1;
+        start = end;
+    }
+    return 0;
+}
+
+uint8_t minimalEGLInit(uint32_t platform, void* nativeDisplay)
+{
+    // client extensions are queried without a display
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (platform && minimalEGLHasExtension(clientExtensions, "EGL_EXT_platform_base"))
+    {
+        eglGetPlatformDisplayEXT_T getPlatformDisplay = (eglGetPlatformDisplayEXT_T)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+            _minimalEGLDisplay = getPlatformDisplay(platform, nativeDisplay, NULL);
+    }
+
+    if (_minimalEGLDisplay == EGL_NO_DISPLAY)
+        _minimalEGLDisplay = eglGetDisplay((EGLNativeDisplayType)nativeDisplay);
+
+    if (_minimalEGLDisplay == EGL_NO_DISPLAY)
+    {
+        MINIMAL_ERROR("[EGL] Failed to get display");
+        return MINIMAL_FAIL;
+    }
+
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(_minimalEGLDisplay, &major, &minor))
+    {
+        MINIMAL_ERROR("[EGL] Failed to initialize display (0x%04x)", eglGetError());
+        _minimalEGLDisplay = EGL_NO_DISPLAY;
+        return MINIMAL_FAIL;
+    }
+
+    // prefer desktop opengl, drivers like angle only provide gles
+    _minimalEGLApi = EGL_OPENGL_API;
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        _minimalEGLApi = EGL_OPENGL_ES_API;
+        if (!eglBindAPI(EGL_OPENGL_ES_API))
+        {
+            MINIMAL_ERROR("[EGL] Neither OpenGL nor OpenGL ES is supported");
+            minimalEGLTerminate();
+            return MINIMAL_FAIL;
+        }
+    }
+
+    const char** modules = _minimalEGLApi == EGL_OPENGL_API ? _minimalGLModules : _minimalGLESModules;
+    for (int i = 0; modules[i] && !_minimalEGLModule; ++i)
+        _minimalEGLModule = MINIMAL_LOAD_MODULE(modules[i]);
+
+    if (!_minimalEGLModule)
+        MINIMAL_WARN("[EGL] Failed to load client library, resolving symbols through eglGetProcAddress");
+
+    const char* extensions = eglQueryString(_minimalEGLDisplay, EGL_EXTENSIONS);
+    _minimalEGLSurfaceless = minimalEGLHasExtension(extensions, "EGL_KHR_surfaceless_context");
+    _minimalEGLNoConfig = minimalEGLHasExtension(extensions, "EGL_KHR_no_config_context")
+                       || minimalEGLHasExtension(extensions, "EGL_MESA_configless_context");
+
+    return MINIMAL_OK;
+}
+
+void minimalEGLTerminate()
+{
+    if (_minimalEGLDisplay != EGL_NO_DISPLAY)
+    {
+        eglTerminate(_minimalEGLDisplay);
+        _minimalEGLDisplay = EGL_NO_DISPLAY;
+    }
+
+    if (_minimalEGLModule)
+    {
+        MINIMAL_FREE_MODULE(_minimalEGLModule);
+        _minimalEGLModule = NULL;
+    }
+}
+
+static uint8_t minimalEGLChooseConfig(EGLint surfaceType, EGLConfig* config)
+{
+    EGLint cfgAttribs[] = {
+        EGL_SURFACE_TYPE,       surfaceType,
+        EGL_RENDERABLE_TYPE,    _minimalEGLApi == EGL_OPENGL_API ? EGL_OPENGL_BIT : EGL_OPENGL_ES3_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_NONE
+    };
+
+    EGLint count = 0;
+    return eglChooseConfig(_minimalEGLDisplay, cfgAttribs, config, 1, &count) && count;
+}
+
+/*
+ * Without a native window the context renders into a pbuffer of the given size.
+ * A size of zero, or a driver without pbuffer configs, creates a surfaceless
+ * context instead, which skips config selection when EGL_KHR_no_config_context
+ * is available. Surfaceless contexts have no default framebuffer.
+ */
+uint8_t minimalEGLCreateContext(MinimalEGLContext* egl, void* nativeWindow, uint32_t w, uint32_t h, int32_t major, int32_t minor)
+{
+    egl->surface = EGL_NO_SURFACE;
+    egl->context = EGL_NO_CONTEXT;
+
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    EGLint surfaceType = nativeWindow ? EGL_WINDOW_BIT : EGL_PBUFFER_BIT;
+
+    if (!nativeWindow && (!w || !h))
+        surfaceType = 0;
+
+    if (surfaceType && !minimalEGLChooseConfig(surfaceType, &config))
+    {
+        if (nativeWindow || !_minimalEGLSurfaceless)
+        {
+            MINIMAL_ERROR("[EGL] Could not find a suitable config");
+            return MINIMAL_FAIL;
+        }
+        surfaceType = 0;
+    }
+
+    if (!surfaceType && !_minimalEGLSurfaceless)
+    {
+        MINIMAL_ERROR("[EGL] Surfaceless contexts are not supported");
+        return MINIMAL_FAIL;
+    }
+
+    if (!surfaceType && !_minimalEGLNoConfig && !minimalEGLChooseConfig(0, &config))
+    {
+        MINIMAL_ERROR("[EGL] Could not find a suitable config");
+        return MINIMAL_FAIL;
+    }
+
+    EGLint glAttribs[16];
+    int i = 0;
+
+    // without a version hint the driver picks its default
+    if (major > 0)
+    {
+        glAttribs[i++] = EGL_CONTEXT_MAJOR_VERSION; glAttribs[i++] = major;
+        glAttribs[i++] = EGL_CONTEXT_MINOR_VERSION; glAttribs[i++] = minor;
+    }
+
+    if (_minimalEGLApi == EGL_OPENGL_API && (major > 3 || (major == 3 && minor >= 2)))
+    {
+        glAttribs[i++] = EGL_CONTEXT_OPENGL_PROFILE_MASK;   glAttribs[i++] = EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT;
+    }
+#ifdef _DEBUG
+    glAttribs[i++] = EGL_CONTEXT_OPENGL_DEBUG;              glAttribs[i++] = EGL_TRUE;
+#endif // _DEBUG
+    glAttribs[i] = EGL_NONE;
+
+    egl->context = eglCreateContext(_minimalEGLDisplay, config, EGL_NO_CONTEXT, glAttribs);
+    if (egl->context == EGL_NO_CONTEXT)
+    {
+        MINIMAL_ERROR("[EGL] Failed to create render context (0x%04x)", eglGetError());
+        return MINIMAL_FAIL;
+    }
+
+    if (surfaceType == EGL_WINDOW_BIT)
+    {
+        egl->surface = eglCreateWindowSurface(_minimalEGLDisplay, config, (EGLNativeWindowType)(uintptr_t)nativeWindow, NULL);
+    }
+    else if (surfaceType == EGL_PBUFFER_BIT)
+    {
+        EGLint pbAttribs[] = { EGL_WIDTH, (EGLint)w, EGL_HEIGHT, (EGLint)h, EGL_NONE };
+        egl->surface = eglCreatePbufferSurface(_minimalEGLDisplay, config, pbAttribs);
+    }
+
+    if (surfaceType && egl->surface == EGL_NO_SURFACE)
+    {
+        MINIMAL_ERROR("[EGL] Failed to create surface (0x%04x)", eglGetError());
+        minimalEGLDestroyContext(egl);
+        return MINIMAL_FAIL;
+    }
+
+    if (!eglMakeCurrent(_minimalEGLDisplay, egl->surface, egl->surface, egl->context))
+    {
+        MINIMAL_ERROR("[EGL] Failed to make render context current (0x%04x)", eglGetError());
+        minimalEGLDestroyContext(egl);
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+void minimalEGLDestroyContext(MinimalEGLContext* egl)
+{
+    if (egl->context != EGL_NO_CONTEXT && eglGetCurrentContext() == egl->context)
+        eglMakeCurrent(_minimalEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    if (egl->surface != EGL_NO_SURFACE)
+        eglDestroySurface(_minimalEGLDisplay, egl->surface);
+
+    if (egl->context != EGL_NO_CONTEXT)
+        eglDestroyContext(_minimalEGLDisplay, egl->context);
+
+    egl->surface = EGL_NO_SURFACE;
+    egl->context = EGL_NO_CONTEXT;
+}
+
+void minimalEGLSwapBuffers(MinimalEGLContext* egl)
+{
+    if (egl->surface != EGL_NO_SURFACE)
+        eglSwapBuffers(_minimalEGLDisplay, egl->surface);
+}
+
+void minimalEGLSwapInterval(int32_t interval)
+{
+    eglSwapInterval(_minimalEGLDisplay, interval);
+}
+
+void* minimalGetGLProcAddress(const char* name)
+{
+    // core symbols come straight from the client library
+    if (_minimalEGLModule)
+    {
+        void* p = MINIMAL_MODULE_SYMBOL(_minimalEGLModule, name);
+        if (p) return p;
+    }
+
+    return (void*)eglGetProcAddress(name);
+}
+
+#endif // MINIMAL_CONTEXT_EGL
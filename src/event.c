@@ -3,20 +3,35 @@
 #define MINIMAL_LOWORD(dw) ((uint16_t)(dw))
 #define MINIMAL_HIWORD(dw) ((uint16_t)(((uint32_t)(dw)) >> 16))
 
-struct MinimalEvent
-{
-    uint32_t type;
-    union
-    {
-        struct
-        {
-            uint32_t uParam;
-            int32_t lParam;
-            int32_t rParam;
-        };
-        const void* external;
-    };
-};
+#if (MINIMAL_EVENT_QUEUE_SIZE & (MINIMAL_EVENT_QUEUE_SIZE - 1)) != 0
+#error "MINIMAL_EVENT_QUEUE_SIZE must be a power of two"
+#endif
+
+#if (MINIMAL_POST_QUEUE_SIZE & (MINIMAL_POST_QUEUE_SIZE - 1)) != 0
+#error "MINIMAL_POST_QUEUE_SIZE must be a power of two"
+#endif
+
+#if MINIMAL_EVENT_LAST >= 32
+#error "builtin event types have to fit into the event mask"
+#endif
+
+#if (MINIMAL_EVENT_ARENA_SIZE % 8) != 0
+#error "MINIMAL_EVENT_ARENA_SIZE must be a multiple of 8"
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+#define MINIMAL_ATOMIC_LOAD(p)              ((uint32_t)_InterlockedOr((volatile long*)(p), 0))
+#define MINIMAL_ATOMIC_STORE(p, v)          _InterlockedExchange((volatile long*)(p), (long)(v))
+#define MINIMAL_ATOMIC_CAS(p, expected, v)  (_InterlockedCompareExchange((volatile long*)(p), (long)(v), (long)(expected)) == (long)(expected))
+#define MINIMAL_ATOMIC_INCREMENT(p)         _InterlockedIncrement((volatile long*)(p))
+#else
+#define MINIMAL_ATOMIC_LOAD(p)              __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define MINIMAL_ATOMIC_STORE(p, v)          __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define MINIMAL_ATOMIC_CAS(p, expected, v)  __atomic_compare_exchange_n(p, &(uint32_t){ expected }, v, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define MINIMAL_ATOMIC_INCREMENT(p)         __atomic_fetch_add(p, 1, __ATOMIC_RELAXED)
+#endif
 
 static struct
 {
@@ -24,27 +39,707 @@ static struct
     MinimalEventCB callback;
 } event_handler;
 
+/* times are kept in ticks and converted when read */
+static struct
+{
+    MinimalEventStats counters;
+    uint64_t pollTicks;
+    uint64_t handlerTicks;
+    uint32_t handlerDepth;
+} event_stats;
+
+/* events of one poll collected for the batch handler, sorted by arrival */
+static struct
+{
+    void* context;
+    MinimalEventBatchCB callback;
+    MinimalEvent events[MINIMAL_EVENT_QUEUE_SIZE];
+    uint32_t count;
+    uint32_t delivering;
+} event_batch;
+
+/* external events share the slot past the last builtin type, their subscribers are told apart by type */
+#define MINIMAL_EVENT_SLOT(type)    ((type) > MINIMAL_EVENT_LAST ? MINIMAL_EVENT_LAST + 1 : (type))
+#define MINIMAL_EVENT_SLOT_COUNT    (MINIMAL_EVENT_LAST + 2)
+
+typedef struct
+{
+    uint32_t type;
+    void* context;
+    MinimalEventCB callback;
+    int32_t priority;
+} MinimalEventSubscriber;
+
+/*
+ * Each slot is kept sorted by descending priority. While events are delivered
+ * the slots are not reordered: removed subscribers only lose their callback and
+ * new ones wait in pending. Both are applied once the outermost delivery returns
+ * so running loops keep their position.
+ */
+static struct
+{
+    MinimalEventSubscriber entries[MINIMAL_EVENT_SLOT_COUNT][MINIMAL_EVENT_MAX_SUBSCRIBERS];
+    uint32_t count[MINIMAL_EVENT_SLOT_COUNT];
+    MinimalEventSubscriber pending[MINIMAL_EVENT_MAX_SUBSCRIBERS];
+    uint32_t pendingCount;
+    uint32_t delivering;
+    uint8_t removed;
+} event_subscribers;
+
+/* single producer (the platform pump) and single consumer (the app) on one thread */
+static struct
+{
+    MinimalEvent events[MINIMAL_EVENT_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+    MinimalEventMode mode;
+} event_queue;
+
+/*
+ * Bounded multi producer, single consumer queue for events posted from other
+ * threads. Each cell carries a sequence number telling producers and the
+ * consumer whose turn it is. Sequences are stored relative to the cell index,
+ * which makes the zeroed static storage a valid empty queue.
+ */
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t type;
+    uint32_t size;
+    uint64_t data[MINIMAL_POST_EVENT_SIZE / sizeof(uint64_t)];
+} MinimalPostedEvent;
+
+static struct
+{
+    MinimalPostedEvent cells[MINIMAL_POST_QUEUE_SIZE];
+    uint32_t enqueue;
+    uint32_t dequeue;
+    uint32_t dropped;
+} post_queue;
+
+static void minimalDispatchExternalEventSized(uint32_t type, const void* data, size_t size);
+
+#define MINIMAL_POST_LAP(pos)   ((pos) & ~(uint32_t)(MINIMAL_POST_QUEUE_SIZE - 1))
+
+/* bump allocator for copied payloads, reset as a whole once per frame */
+static struct
+{
+    uint64_t memory[MINIMAL_EVENT_ARENA_SIZE / sizeof(uint64_t)];
+    size_t offset;
+} event_arena;
+
+/* NULL if the arena is full, every allocation stays 8 byte aligned */
+static void* minimalEventArenaAlloc(size_t size)
+{
+    size_t aligned = (size + 7) & ~(size_t)7;
+    if (aligned > MINIMAL_EVENT_ARENA_SIZE - event_arena.offset) return NULL;
+
+    void* memory = (uint8_t*)event_arena.memory + event_arena.offset;
+    event_arena.offset += aligned;
+    return memory;
+}
+
+static struct
+{
+    uint64_t time;
+    uint32_t seq;
+
+    // os clock extended past its 32 bit wrap and its estimated offset to ours
+    int64_t source;
+    uint32_t last;
+    int64_t offset;
+    uint8_t synced;
+} event_clock;
+
+/* merged motion and resize events, in callback mode the last one is held back until the next flush */
+static struct
+{
+    uint8_t enabled;
+    uint8_t hasPending;
+    MinimalEvent pending;
+} event_coalesce;
+
+/* set while live input is drained without effect */
+static uint8_t event_discard;
+
+/* last motion event, deltas are only measured between moves in the same window */
+static struct
+{
+    MinimalWindow* window;
+    int32_t x, y;
+    uint8_t tracking;
+} event_cursor;
+
 void minimalSetEventHandler(void* context, MinimalEventCB callback)
 {
     event_handler.context = context;
     event_handler.callback = callback;
 }
 
+/* behind all subscribers with the same or a higher priority */
+static void minimalInsertSubscriber(MinimalEventSubscriber subscriber)
+{
+    uint32_t slot = MINIMAL_EVENT_SLOT(subscriber.type);
+    MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+    uint32_t index = event_subscribers.count[slot];
+    while (index > 0 && entries[index - 1].priority < subscriber.priority)
+    {
+        entries[index] = entries[index - 1];
+        index--;
+    }
+
+    entries[index] = subscriber;
+    event_subscribers.count[slot]++;
+}
+
+uint8_t minimalSubscribeEvent(uint32_t type, int32_t priority, void* context, MinimalEventCB callback)
+{
+    uint32_t slot = MINIMAL_EVENT_SLOT(type);
+    const MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+    // removed and pending subscribers are only counted once the slot is compacted
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < event_subscribers.count[slot]; ++i)
+    {
+        if (entries[i].callback) count++;
+    }
+
+    for (uint32_t i = 0; i < event_subscribers.pendingCount; ++i)
+    {
+        if (MINIMAL_EVENT_SLOT(event_subscribers.pending[i].type) == slot) count++;
+    }
+
+    if (count >= MINIMAL_EVENT_MAX_SUBSCRIBERS)
+    {
+        MINIMAL_ERROR("[Event] Too many subscribers for event type %u", type);
+        return MINIMAL_FAIL;
+    }
+
+    MinimalEventSubscriber subscriber = { .type = type, .context = context, .callback = callback, .priority = priority };
+    if (!event_subscribers.delivering)
+    {
+        minimalInsertSubscriber(subscriber);
+        return MINIMAL_OK;
+    }
+
+    // the running delivery does not see it, it is added once delivery returns
+    if (event_subscribers.pendingCount >= MINIMAL_EVENT_MAX_SUBSCRIBERS)
+    {
+        MINIMAL_ERROR("[Event] Too many subscribers added during delivery");
+        return MINIMAL_FAIL;
+    }
+
+    event_subscribers.pending[event_subscribers.pendingCount++] = subscriber;
+    return MINIMAL_OK;
+}
+
+void minimalUnsubscribeEvent(uint32_t type, void* context, MinimalEventCB callback)
+{
+    uint32_t slot = MINIMAL_EVENT_SLOT(type);
+    MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+    for (uint32_t i = 0; i < event_subscribers.count[slot]; ++i)
+    {
+        if (entries[i].type == type && entries[i].context == context && entries[i].callback == callback)
+        {
+            if (event_subscribers.delivering)
+            {
+                entries[i].callback = NULL;
+                event_subscribers.removed = 1;
+                return;
+            }
+
+            event_subscribers.count[slot]--;
+            MINIMAL_MEMMOVE(&entries[i], &entries[i + 1], (event_subscribers.count[slot] - i) * sizeof(MinimalEventSubscriber));
+            return;
+        }
+    }
+
+    // pending subscribers are not iterated by any delivery
+    MinimalEventSubscriber* pending = event_subscribers.pending;
+    for (uint32_t i = 0; i < event_subscribers.pendingCount; ++i)
+    {
+        if (pending[i].type == type && pending[i].context == context && pending[i].callback == callback)
+        {
+            event_subscribers.pendingCount--;
+            MINIMAL_MEMMOVE(&pending[i], &pending[i + 1], (event_subscribers.pendingCount - i) * sizeof(MinimalEventSubscriber));
+            return;
+        }
+    }
+}
+
+/* drops the subscribers removed and adds the ones subscribed during delivery */
+static void minimalCompactSubscribers()
+{
+    for (uint32_t slot = 0; slot < MINIMAL_EVENT_SLOT_COUNT; ++slot)
+    {
+        MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < event_subscribers.count[slot]; ++i)
+        {
+            if (entries[i].callback) entries[count++] = entries[i];
+        }
+        event_subscribers.count[slot] = count;
+    }
+
+    for (uint32_t i = 0; i < event_subscribers.pendingCount; ++i)
+        minimalInsertSubscriber(event_subscribers.pending[i]);
+
+    event_subscribers.pendingCount = 0;
+    event_subscribers.removed = 0;
+}
+
+void minimalSetEventBatchHandler(void* context, MinimalEventBatchCB callback)
+{
+    minimalFlushEvents();
+    event_batch.context = context;
+    event_batch.callback = callback;
+}
+
+void minimalSetEventMode(MinimalEventMode mode)
+{
+    minimalFlushEvents();
+    event_queue.mode = mode;
+}
+
+void minimalSetEventCoalescing(uint8_t enable)
+{
+    minimalFlushEvents();
+    event_coalesce.enabled = enable;
+}
+
+static int16_t minimalClampDelta(int32_t value)
+{
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return (int16_t)value;
+}
+
+static uint32_t minimalPackDelta(int32_t dx, int32_t dy)
+{
+    return (uint16_t)minimalClampDelta(dx) | ((uint32_t)(uint16_t)minimalClampDelta(dy) << 16);
+}
+
+/* folds e into dst if both are motion or resize events of the same window */
+static uint8_t minimalCoalesceEvent(MinimalEvent* dst, const MinimalEvent* e)
+{
+    if (dst->type != e->type || dst->window != e->window) return 0;
+
+    if (e->type == MINIMAL_EVENT_MOUSE_MOVED)
+    {
+        int32_t dx = (int16_t)MINIMAL_LOWORD(dst->uParam) + (int16_t)MINIMAL_LOWORD(e->uParam);
+        int32_t dy = (int16_t)MINIMAL_HIWORD(dst->uParam) + (int16_t)MINIMAL_HIWORD(e->uParam);
+        dst->uParam = minimalPackDelta(dx, dy);
+    }
+    else if (e->type == MINIMAL_EVENT_WINDOW_SIZE)
+    {
+        dst->uParam = e->uParam;
+    }
+    else if (e->type != MINIMAL_EVENT_MOUSE_RAW)
+    {
+        return 0;
+    }
+
+    event_stats.counters.coalesced++;
+
+    // the merged event describes the newest state, raw motion has no state and adds up instead
+    dst->seq = e->seq;
+    dst->time = e->time;
+    if (e->type == MINIMAL_EVENT_MOUSE_RAW)
+    {
+        dst->lParam += e->lParam;
+        dst->rParam += e->rParam;
+    }
+    else
+    {
+        dst->lParam = e->lParam;
+        dst->rParam = e->rParam;
+    }
+    return 1;
+}
+
+uint8_t minimalPostExternalEvent(uint32_t type, const void* data, size_t size)
+{
+    if (type <= MINIMAL_EVENT_LAST || size > MINIMAL_POST_EVENT_SIZE)
+    {
+        MINIMAL_ERROR("[Event] Posted events need an external type and at most %d bytes", MINIMAL_POST_EVENT_SIZE);
+        return MINIMAL_FAIL;
+    }
+
+    MinimalPostedEvent* cell;
+    uint32_t pos = MINIMAL_ATOMIC_LOAD(&post_queue.enqueue);
+    for (;;)
+    {
+        cell = &post_queue.cells[pos & (MINIMAL_POST_QUEUE_SIZE - 1)];
+        int32_t diff = (int32_t)(MINIMAL_ATOMIC_LOAD(&cell->sequence) - MINIMAL_POST_LAP(pos));
+
+        if (diff == 0)
+        {
+            // the cell is free, claim it unless another producer was faster
+            if (MINIMAL_ATOMIC_CAS(&post_queue.enqueue, pos, pos + 1)) break;
+            pos = MINIMAL_ATOMIC_LOAD(&post_queue.enqueue);
+        }
+        else if (diff < 0)
+        {
+            // the consumer has not released the cell of the previous lap
+            MINIMAL_ATOMIC_INCREMENT(&post_queue.dropped);
+            return MINIMAL_FAIL;
+        }
+        else
+        {
+            pos = MINIMAL_ATOMIC_LOAD(&post_queue.enqueue);
+        }
+    }
+
+    cell->type = type;
+    cell->size = (uint32_t)size;
+    if (size) MINIMAL_MEMCPY(cell->data, data, size);
+
+    MINIMAL_ATOMIC_STORE(&cell->sequence, MINIMAL_POST_LAP(pos) + 1);
+    return MINIMAL_OK;
+}
+
+void minimalDispatchPostedEvents()
+{
+    for (;;)
+    {
+        uint32_t pos = post_queue.dequeue;
+        MinimalPostedEvent* cell = &post_queue.cells[pos & (MINIMAL_POST_QUEUE_SIZE - 1)];
+        if (MINIMAL_ATOMIC_LOAD(&cell->sequence) != MINIMAL_POST_LAP(pos) + 1) break;
+
+        // the payload moves to the frame arena so the cell is free for producers right away
+        uint32_t type = cell->type;
+        uint32_t size = cell->size;
+        void* data = minimalEventArenaAlloc(size);
+
+        // events not fitting into the arena stay queued until the next frame
+        if (!data) break;
+
+        if (size) MINIMAL_MEMCPY(data, cell->data, size);
+
+        post_queue.dequeue++;
+        MINIMAL_ATOMIC_STORE(&cell->sequence, MINIMAL_POST_LAP(pos) + MINIMAL_POST_QUEUE_SIZE);
+
+        minimalDispatchExternalEventSized(type, data, size);
+    }
+
+    minimalFlushEvents();
+}
+
+uint32_t minimalGetDroppedPostedEventCount()
+{
+    return MINIMAL_ATOMIC_LOAD(&post_queue.dropped);
+}
+
+/* handlers dispatching events themselves are only timed once */
+static uint64_t minimalHandlerEnter()
+{
+    return event_stats.handlerDepth++ ? 0 : minimalGetTicks();
+}
+
+static void minimalHandlerLeave(uint64_t start)
+{
+    if (--event_stats.handlerDepth == 0)
+        event_stats.handlerTicks += minimalGetTicks() - start;
+}
+
+static void minimalDeliverEvent(const MinimalEvent* e)
+{
+    uint32_t slot = MINIMAL_EVENT_SLOT(e->type);
+    const MinimalEventSubscriber* entries = event_subscribers.entries[slot];
+
+    uint64_t start = minimalHandlerEnter();
+    event_subscribers.delivering++;
+
+    // a nonzero return consumes the event
+    uint8_t consumed = 0;
+    for (uint32_t i = 0; i < event_subscribers.count[slot] && !consumed; ++i)
+    {
+        if (entries[i].type == e->type && entries[i].callback)
+            consumed = entries[i].callback(entries[i].context, e);
+    }
+
+    if (!consumed && event_handler.callback) event_handler.callback(event_handler.context, e);
+
+    if (--event_subscribers.delivering == 0 && (event_subscribers.removed || event_subscribers.pendingCount))
+        minimalCompactSubscribers();
+
+    minimalHandlerLeave(start);
+}
+
+static void minimalDeliverPending()
+{
+    if (!event_coalesce.hasPending) return;
+
+    event_coalesce.hasPending = 0;
+    minimalDeliverEvent(&event_coalesce.pending);
+}
+
+static void minimalDeliverBatch()
+{
+    if (!event_batch.count || event_batch.delivering) return;
+
+    // events dispatched by the batch handler itself are appended behind the span it reads
+    uint32_t count = event_batch.count;
+    event_batch.delivering = count;
+
+    uint64_t start = minimalHandlerEnter();
+    event_batch.callback(event_batch.context, event_batch.events, count);
+    minimalHandlerLeave(start);
+
+    event_batch.delivering = 0;
+
+    event_batch.count -= count;
+    MINIMAL_MEMMOVE(event_batch.events, event_batch.events + count, event_batch.count * sizeof(MinimalEvent));
+}
+
+static void minimalBatchEvent(const MinimalEvent* e)
+{
+    if (event_coalesce.enabled && event_batch.count > event_batch.delivering
+        && minimalCoalesceEvent(&event_batch.events[event_batch.count - 1], e))
+        return;
+
+    if (event_batch.count == MINIMAL_EVENT_QUEUE_SIZE)
+    {
+        // a full batch goes out early, unless it is being read right now
+        if (event_batch.delivering)
+        {
+            event_queue.dropped++;
+            event_stats.counters.dropped++;
+            return;
+        }
+        minimalDeliverBatch();
+    }
+
+    event_batch.events[event_batch.count++] = *e;
+
+    if (event_batch.count > event_stats.counters.highWater)
+        event_stats.counters.highWater = event_batch.count;
+}
+
+void minimalFlushEvents()
+{
+    minimalDeliverPending();
+
+    if (event_batch.callback) minimalDeliverBatch();
+}
+
+static void minimalPushEvent(const MinimalEvent* e)
+{
+    if (event_queue.mode == MINIMAL_EVENT_MODE_CALLBACK && event_batch.callback)
+    {
+        minimalBatchEvent(e);
+        return;
+    }
+
+    if (event_queue.mode == MINIMAL_EVENT_MODE_CALLBACK)
+    {
+        if (!event_coalesce.enabled)
+        {
+            minimalDeliverEvent(e);
+            return;
+        }
+
+        if (event_coalesce.hasPending && minimalCoalesceEvent(&event_coalesce.pending, e))
+            return;
+
+        // anything else delivers the held event first to keep the order intact
+        minimalDeliverPending();
+
+        if (e->type == MINIMAL_EVENT_MOUSE_MOVED || e->type == MINIMAL_EVENT_MOUSE_RAW || e->type == MINIMAL_EVENT_WINDOW_SIZE)
+        {
+            event_coalesce.pending = *e;
+            event_coalesce.hasPending = 1;
+            return;
+        }
+
+        minimalDeliverEvent(e);
+        return;
+    }
+
+    // only events not pulled yet can absorb newer ones
+    if (event_coalesce.enabled && event_queue.tail != event_queue.head)
+    {
+        MinimalEvent* last = &event_queue.events[(event_queue.tail - 1) & (MINIMAL_EVENT_QUEUE_SIZE - 1)];
+        if (minimalCoalesceEvent(last, e)) return;
+    }
+
+    // head and tail run freely, their difference is the fill level
+    if (event_queue.tail - event_queue.head >= MINIMAL_EVENT_QUEUE_SIZE)
+    {
+        event_queue.dropped++;
+        event_stats.counters.dropped++;
+        return;
+    }
+
+    event_queue.events[event_queue.tail++ & (MINIMAL_EVENT_QUEUE_SIZE - 1)] = *e;
+
+    if (event_queue.tail - event_queue.head > event_stats.counters.highWater)
+        event_stats.counters.highWater = event_queue.tail - event_queue.head;
+}
+
+void minimalDiscardEvents(uint8_t discard)
+{
+    event_discard = discard;
+}
+
+uint8_t minimalEventsDiscarded()
+{
+    return event_discard;
+}
+
+void minimalResetMouseDelta(MinimalWindow* window)
+{
+    if (event_cursor.window == window) event_cursor.tracking = 0;
+}
+
+uint8_t minimalPollEvent(MinimalEvent* e)
+{
+    if (event_queue.head == event_queue.tail) return 0;
+
+    *e = event_queue.events[event_queue.head++ & (MINIMAL_EVENT_QUEUE_SIZE - 1)];
+    return 1;
+}
+
+uint32_t minimalGetDroppedEventCount()
+{
+    return event_queue.dropped;
+}
+
+void minimalAddEventPollTime(uint64_t ticks)
+{
+    event_stats.pollTicks += ticks;
+}
+
+void minimalGetEventStats(MinimalEventStats* stats)
+{
+    *stats = event_stats.counters;
+    stats->pollTime = minimalTicksToNs(event_stats.pollTicks);
+    stats->handlerTime = minimalTicksToNs(event_stats.handlerTicks);
+}
+
+void minimalResetEventStats()
+{
+    MINIMAL_MEMSET(&event_stats.counters, 0, sizeof(event_stats.counters));
+    event_stats.pollTicks = 0;
+    event_stats.handlerTicks = 0;
+}
+
+void minimalSetEventTime(uint64_t ns)
+{
+    event_clock.time = ns;
+}
+
+uint64_t minimalRebaseEventTime(uint32_t ms)
+{
+    uint64_t now = minimalGetTimeNs();
+
+    event_clock.source = event_clock.synced ? event_clock.source + (int32_t)(ms - event_clock.last) : ms;
+    event_clock.last = ms;
+
+    // input is never seen before it happens, so the smallest distance between both clocks is the best guess for their offset
+    int64_t source = event_clock.source * 1000000;
+    int64_t offset = (int64_t)now - source;
+    if (!event_clock.synced || offset < event_clock.offset)
+        event_clock.offset = offset;
+    event_clock.synced = 1;
+
+    // input from before our clock started is clamped to its start
+    int64_t time = source + event_clock.offset;
+    return time > 0 ? (uint64_t)time : 0;
+}
+
+uint64_t minimalGetEventTime()
+{
+    return event_clock.time ? event_clock.time : minimalGetTimeNs();
+}
+
+static void minimalStampEvent(MinimalEvent* e)
+{
+    e->time = minimalGetEventTime();
+    e->seq = ++event_clock.seq;
+
+    event_stats.counters.dispatched[MINIMAL_EVENT_SLOT(e->type)]++;
+}
+
 void minimalDispatchEvent(uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
 {
-    MinimalEvent e = { .type = type, .uParam = uParam, .lParam = lParam, .rParam = rParam };
-    if (event_handler.callback) event_handler.callback(event_handler.context, &e);
+    minimalDispatchWindowEvent(NULL, type, uParam, lParam, rParam);
 }
 
-void minimalDispatchExternalEvent(uint32_t type, const void* data)
+void minimalDispatchWindowEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
+{
+    if (event_discard) return;
+
+    MinimalEvent e = { .type = type, .window = window, .uParam = uParam, .lParam = lParam, .rParam = rParam };
+
+    // motion events carry the distance to the previous position, the first one in a window has none
+    if (type == MINIMAL_EVENT_MOUSE_MOVED)
+    {
+        if (event_cursor.tracking && event_cursor.window == window)
+            e.uParam = minimalPackDelta(lParam - event_cursor.x, rParam - event_cursor.y);
+
+        event_cursor.window = window;
+        event_cursor.x = lParam;
+        event_cursor.y = rParam;
+        event_cursor.tracking = 1;
+    }
+
+    minimalStampEvent(&e);
+    if (!event_stats.handlerDepth) minimalRecordEvent(&e, NULL, 0);
+    minimalPushEvent(&e);
+}
+
+/* the size only tells recordings how much of the payload to keep */
+static void minimalDispatchExternalEventSized(uint32_t type, const void* data, size_t size)
 {
+    if (event_discard) return;
+
     MinimalEvent e = { .type = type, .external = data };
-    if (event_handler.callback) event_handler.callback(event_handler.context, &e);
+    minimalStampEvent(&e);
+
+    // handlers dispatch their events again on replay, only the input causing them is recorded
+    if (!event_stats.handlerDepth) minimalRecordEvent(&e, data, size);
+
+    minimalPushEvent(&e);
+}
+
+/* in queue mode data has to stay valid until the event is pulled */
+void minimalDispatchExternalEvent(uint32_t type, const void* data)
+{
+    minimalDispatchExternalEventSized(type, data, 0);
+}
+
+uint8_t minimalDispatchExternalEventCopy(uint32_t type, const void* data, size_t size)
+{
+    void* copy = minimalEventArenaAlloc(size);
+    if (!copy)
+    {
+        MINIMAL_WARN("[Event] Event arena is full, dropping event %u", type);
+        return MINIMAL_FAIL;
+    }
+
+    if (size) MINIMAL_MEMCPY(copy, data, size);
+
+    minimalDispatchExternalEventSized(type, copy, size);
+    return MINIMAL_OK;
+}
+
+void minimalResetEventArena()
+{
+    event_arena.offset = 0;
 }
 
 uint8_t minimalEventIsType(const MinimalEvent* e, uint32_t type)  { return e->type == type; }
 uint8_t minimalEventIsExternal(const MinimalEvent* e)        { return e->type > MINIMAL_EVENT_LAST; }
 
+MinimalWindow* minimalEventWindow(const MinimalEvent* e)    { return e->window; }
+uint64_t minimalEventTimestamp(const MinimalEvent* e)       { return e->time; }
+uint32_t minimalEventSequence(const MinimalEvent* e)        { return e->seq; }
+
 const void* minimalExternalEvent(const MinimalEvent* e)
 {
     return minimalEventIsExternal(e) ? e->external : NULL;
@@ -97,6 +792,26 @@ uint8_t minimalEventMouseMoved(const MinimalEvent* e, float* x, float* y)
     return 1;
 }
 
+uint8_t minimalEventMouseDelta(const MinimalEvent* e, int32_t* dx, int32_t* dy)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_MOVED)) return 0;
+
+    if (dx) *dx = (int16_t)MINIMAL_LOWORD(e->uParam);
+    if (dy) *dy = (int16_t)MINIMAL_HIWORD(e->uParam);
+
+    return 1;
+}
+
+uint8_t minimalEventMouseRaw(const MinimalEvent* e, float* dx, float* dy)
+{
+    if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_RAW)) return 0;
+
+    if (dx) *dx = (float)e->lParam / MINIMAL_MOUSE_RAW_ONE;
+    if (dy) *dy = (float)e->rParam / MINIMAL_MOUSE_RAW_ONE;
+
+    return 1;
+}
+
 uint8_t minimalEventMouseScrolled(const MinimalEvent* e, float* xoffset, float* yoffset)
 {
     if (!minimalEventIsType(e, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
@@ -0,0 +1,536 @@
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "minimal.h"
+
+#ifdef __linux__
+#include <linux/input.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+#ifndef MINIMAL_GAMEPAD_DEVICE_DIR
+#define MINIMAL_GAMEPAD_DEVICE_DIR  "/dev/input"
+#endif
+
+/* events taken from a device per read, devices are read until they are drained */
+#ifndef MINIMAL_GAMEPAD_READ_SIZE
+#define MINIMAL_GAMEPAD_READ_SIZE   64
+#endif
+
+/* events of one report held back until its SYN_REPORT, larger reports are resynced */
+#define MINIMAL_GAMEPAD_PACKET_SIZE 32
+
+#define MINIMAL_GAMEPAD_AXIS_COUNT  (MINIMAL_GAMEPAD_AXIS_LAST + 1)
+
+typedef struct
+{
+    int fd;
+    char node[32];
+    char name[64];
+
+    // one bit per button, like the mouse buttons of the input state
+    uint32_t buttons;
+    uint32_t prev_buttons;
+
+    // normalized values as reported and with the deadzone applied once per frame
+    float values[MINIMAL_GAMEPAD_AXIS_COUNT];
+    float axes[MINIMAL_GAMEPAD_AXIS_COUNT];
+
+    // range of the evdev axis behind every mapped axis
+    int32_t min[MINIMAL_GAMEPAD_AXIS_COUNT];
+    int32_t max[MINIMAL_GAMEPAD_AXIS_COUNT];
+
+    // the report being read, a report can span reads and frames
+    struct input_event packet[MINIMAL_GAMEPAD_PACKET_SIZE];
+    uint32_t packetCount;
+    uint8_t dropped;
+} MinimalGamepad;
+
+static struct
+{
+    uint8_t initialized;
+    int inotify;
+    float deadzone;
+    MinimalGamepad pads[MINIMAL_GAMEPAD_MAX];
+} gamepads = { .inotify = -1, .deadzone = MINIMAL_GAMEPAD_DEADZONE };
+
+static uint8_t minimalGamepadValid(uint32_t pad)
+{
+    return gamepads.initialized && pad < MINIMAL_GAMEPAD_MAX && gamepads.pads[pad].fd >= 0;
+}
+
+static uint8_t minimalGamepadButtonValid(MinimalGamepadButton button)
+{
+    return button >= 0 && button <= MINIMAL_GAMEPAD_BUTTON_LAST;
+}
+
+/* estimate from the float bits refined by newton steps, saves every user linking libm for sqrtf */
+static float minimalGamepadLength(float x, float y)
+{
+    float sq = x * x + y * y;
+    if (sq <= 0.0f) return 0.0f;
+
+    union { float f; uint32_t u; } bits = { .f = sq };
+    bits.u = (bits.u >> 1) + 0x1fbd1df5;
+
+    float length = bits.f;
+    for (int i = 0; i < 3; ++i)
+        length = 0.5f * (length + sq / length);
+
+    return length;
+}
+
+/* sticks use a radial deadzone so diagonals do not snap to the axes */
+static void minimalGamepadApplyStick(MinimalGamepad* pad, MinimalGamepadAxis x, MinimalGamepadAxis y)
+{
+    float vx = pad->values[x];
+    float vy = pad->values[y];
+    float length = minimalGamepadLength(vx, vy);
+
+    pad->axes[x] = 0.0f;
+    pad->axes[y] = 0.0f;
+    if (length <= gamepads.deadzone) return;
+
+    // rescaled so the output still covers the whole range
+    float scaled = (length - gamepads.deadzone) / (1.0f - gamepads.deadzone);
+    if (scaled > 1.0f) scaled = 1.0f;
+
+    pad->axes[x] = vx * scaled / length;
+    pad->axes[y] = vy * scaled / length;
+}
+
+static void minimalGamepadApplyTrigger(MinimalGamepad* pad, MinimalGamepadAxis axis)
+{
+    float value = pad->values[axis];
+    pad->axes[axis] = value <= gamepads.deadzone ? 0.0f : (value - gamepads.deadzone) / (1.0f - gamepads.deadzone);
+}
+
+static void minimalGamepadApplyDeadzone(MinimalGamepad* pad)
+{
+    minimalGamepadApplyStick(pad, MINIMAL_GAMEPAD_AXIS_LEFT_X, MINIMAL_GAMEPAD_AXIS_LEFT_Y);
+    minimalGamepadApplyStick(pad, MINIMAL_GAMEPAD_AXIS_RIGHT_X, MINIMAL_GAMEPAD_AXIS_RIGHT_Y);
+    minimalGamepadApplyTrigger(pad, MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER);
+    minimalGamepadApplyTrigger(pad, MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER);
+}
+
+/* --------------------------| evdev |----------------------------------- */
+#ifdef __linux__
+
+#define MINIMAL_EVDEV_LONG_BITS         (sizeof(unsigned long) * 8)
+#define MINIMAL_EVDEV_LONGS(count)      (((count) + MINIMAL_EVDEV_LONG_BITS - 1) / MINIMAL_EVDEV_LONG_BITS)
+#define MINIMAL_EVDEV_TEST(bits, i)     (((bits)[(i) / MINIMAL_EVDEV_LONG_BITS] >> ((i) % MINIMAL_EVDEV_LONG_BITS)) & 1)
+
+static uint8_t minimalGamepadIsTrigger(MinimalGamepadAxis axis)
+{
+    return axis == MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER || axis == MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER;
+}
+
+static MinimalGamepadButton minimalEvdevButton(uint16_t code)
+{
+    switch (code)
+    {
+    case BTN_SOUTH:         return MINIMAL_GAMEPAD_BUTTON_A;
+    case BTN_EAST:          return MINIMAL_GAMEPAD_BUTTON_B;
+    case BTN_WEST:          return MINIMAL_GAMEPAD_BUTTON_X;
+    case BTN_NORTH:         return MINIMAL_GAMEPAD_BUTTON_Y;
+    case BTN_TL:            return MINIMAL_GAMEPAD_BUTTON_LEFT_BUMPER;
+    case BTN_TR:            return MINIMAL_GAMEPAD_BUTTON_RIGHT_BUMPER;
+    case BTN_SELECT:        return MINIMAL_GAMEPAD_BUTTON_BACK;
+    case BTN_START:         return MINIMAL_GAMEPAD_BUTTON_START;
+    case BTN_MODE:          return MINIMAL_GAMEPAD_BUTTON_GUIDE;
+    case BTN_THUMBL:        return MINIMAL_GAMEPAD_BUTTON_LEFT_THUMB;
+    case BTN_THUMBR:        return MINIMAL_GAMEPAD_BUTTON_RIGHT_THUMB;
+    case BTN_DPAD_UP:       return MINIMAL_GAMEPAD_BUTTON_DPAD_UP;
+    case BTN_DPAD_RIGHT:    return MINIMAL_GAMEPAD_BUTTON_DPAD_RIGHT;
+    case BTN_DPAD_DOWN:     return MINIMAL_GAMEPAD_BUTTON_DPAD_DOWN;
+    case BTN_DPAD_LEFT:     return MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT;
+    }
+
+    // joysticks have no layout, their buttons fill the standard buttons in order up to the dpad
+    if (code >= BTN_TRIGGER && code < BTN_TRIGGER + MINIMAL_GAMEPAD_BUTTON_DPAD_UP)
+        return (MinimalGamepadButton)(code - BTN_TRIGGER);
+
+    return MINIMAL_GAMEPAD_BUTTON_UNKNOWN;
+}
+
+static MinimalGamepadAxis minimalEvdevAxis(uint16_t code)
+{
+    switch (code)
+    {
+    case ABS_X:     return MINIMAL_GAMEPAD_AXIS_LEFT_X;
+    case ABS_Y:     return MINIMAL_GAMEPAD_AXIS_LEFT_Y;
+    case ABS_RX:    return MINIMAL_GAMEPAD_AXIS_RIGHT_X;
+    case ABS_RY:    return MINIMAL_GAMEPAD_AXIS_RIGHT_Y;
+    case ABS_Z:     return MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER;
+    case ABS_RZ:    return MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER;
+    default:        return -1;
+    }
+}
+
+static void minimalEvdevSetButton(MinimalGamepad* pad, MinimalGamepadButton button, uint8_t down)
+{
+    if (!minimalGamepadButtonValid(button)) return;
+
+    if (down)   pad->buttons |= (uint32_t)1 << button;
+    else        pad->buttons &= ~((uint32_t)1 << button);
+}
+
+static void minimalEvdevProcessKey(MinimalGamepad* pad, uint16_t code, int32_t value)
+{
+    // digital triggers move the trigger axis all the way
+    if (code == BTN_TL2 || code == BTN_TR2)
+    {
+        MinimalGamepadAxis axis = code == BTN_TL2 ? MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER : MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER;
+        if (pad->max[axis] == pad->min[axis]) pad->values[axis] = value ? 1.0f : 0.0f;
+        return;
+    }
+
+    minimalEvdevSetButton(pad, minimalEvdevButton(code), value != 0);
+}
+
+static void minimalEvdevProcessAbs(MinimalGamepad* pad, uint16_t code, int32_t value)
+{
+    // hats are the dpad of most pads, negative values point up and left
+    if (code == ABS_HAT0X)
+    {
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT, value < 0);
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_RIGHT, value > 0);
+        return;
+    }
+
+    if (code == ABS_HAT0Y)
+    {
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_UP, value < 0);
+        minimalEvdevSetButton(pad, MINIMAL_GAMEPAD_BUTTON_DPAD_DOWN, value > 0);
+        return;
+    }
+
+    MinimalGamepadAxis axis = minimalEvdevAxis(code);
+    if (axis < 0 || pad->max[axis] == pad->min[axis]) return;
+
+    float t = (float)(value - pad->min[axis]) / (float)(pad->max[axis] - pad->min[axis]);
+    pad->values[axis] = minimalGamepadIsTrigger(axis) ? t : t * 2.0f - 1.0f;
+}
+
+/* reads the full device state, on open and after the kernel dropped events */
+static void minimalEvdevSync(MinimalGamepad* pad)
+{
+    unsigned long keys[MINIMAL_EVDEV_LONGS(KEY_CNT)] = { 0 };
+    if (ioctl(pad->fd, EVIOCGKEY(sizeof(keys)), keys) >= 0)
+    {
+        pad->buttons = 0;
+        for (uint16_t code = BTN_MISC; code < BTN_DIGI; ++code)
+            minimalEvdevProcessKey(pad, code, (int32_t)MINIMAL_EVDEV_TEST(keys, code));
+        for (uint16_t code = BTN_DPAD_UP; code <= BTN_DPAD_RIGHT; ++code)
+            minimalEvdevProcessKey(pad, code, (int32_t)MINIMAL_EVDEV_TEST(keys, code));
+    }
+
+    for (uint16_t code = ABS_X; code <= ABS_HAT0Y; ++code)
+    {
+        struct input_absinfo info;
+        if (ioctl(pad->fd, EVIOCGABS(code), &info) >= 0)
+            minimalEvdevProcessAbs(pad, code, info.value);
+    }
+}
+
+static void minimalEvdevClose(MinimalGamepad* pad)
+{
+    if (pad->fd < 0) return;
+
+    MINIMAL_INFO("[Gamepad] Disconnected %s", pad->name);
+
+    close(pad->fd);
+    MINIMAL_MEMSET(pad, 0, sizeof(MinimalGamepad));
+    pad->fd = -1;
+}
+
+static void minimalEvdevOpen(const char* node)
+{
+    if (strncmp(node, "event", 5) != 0) return;
+
+    MinimalGamepad* pad = NULL;
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+    {
+        // udev changes the permissions after creating the node, both report the device
+        if (gamepads.pads[i].fd >= 0 && strcmp(gamepads.pads[i].node, node) == 0) return;
+        if (!pad && gamepads.pads[i].fd < 0) pad = &gamepads.pads[i];
+    }
+
+    if (!pad) return;
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/%s", MINIMAL_GAMEPAD_DEVICE_DIR, node);
+
+    // most devices are not readable without the input group, those are skipped quietly
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return;
+
+    unsigned long keys[MINIMAL_EVDEV_LONGS(KEY_CNT)] = { 0 };
+    unsigned long abs[MINIMAL_EVDEV_LONGS(ABS_CNT)] = { 0 };
+    ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys);
+    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs)), abs);
+
+    // keyboards, mice and motion sensors lack either the buttons or the stick
+    uint8_t buttons = MINIMAL_EVDEV_TEST(keys, BTN_GAMEPAD) || MINIMAL_EVDEV_TEST(keys, BTN_JOYSTICK);
+    if (!buttons || !MINIMAL_EVDEV_TEST(abs, ABS_X))
+    {
+        close(fd);
+        return;
+    }
+
+    MINIMAL_MEMSET(pad, 0, sizeof(MinimalGamepad));
+    pad->fd = fd;
+    snprintf(pad->node, sizeof(pad->node), "%s", node);
+
+    if (ioctl(fd, EVIOCGNAME(sizeof(pad->name)), pad->name) < 0)
+        snprintf(pad->name, sizeof(pad->name), "%s", node);
+
+    for (uint16_t code = ABS_X; code <= ABS_RZ; ++code)
+    {
+        MinimalGamepadAxis axis = minimalEvdevAxis(code);
+        struct input_absinfo info;
+        if (axis < 0 || !MINIMAL_EVDEV_TEST(abs, code) || ioctl(fd, EVIOCGABS(code), &info) < 0) continue;
+
+        pad->min[axis] = info.minimum;
+        pad->max[axis] = info.maximum;
+    }
+
+    minimalEvdevSync(pad);
+    pad->prev_buttons = pad->buttons;
+    minimalGamepadApplyDeadzone(pad);
+
+    MINIMAL_INFO("[Gamepad] Connected %s", pad->name);
+}
+
+static void minimalEvdevRemove(const char* node)
+{
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+    {
+        if (gamepads.pads[i].fd >= 0 && strcmp(gamepads.pads[i].node, node) == 0)
+            minimalEvdevClose(&gamepads.pads[i]);
+    }
+}
+
+static void minimalEvdevProcessEvent(MinimalGamepad* pad, const struct input_event* e)
+{
+    if (e->type == EV_SYN && e->code == SYN_DROPPED)
+    {
+        // the kernel buffer overflowed, everything up to the next report is incomplete
+        pad->dropped = 1;
+        pad->packetCount = 0;
+        return;
+    }
+
+    if (e->type == EV_SYN && e->code == SYN_REPORT)
+    {
+        if (pad->dropped)
+        {
+            minimalEvdevSync(pad);
+            pad->dropped = 0;
+        }
+
+        for (uint32_t i = 0; i < pad->packetCount; ++i)
+        {
+            const struct input_event* p = &pad->packet[i];
+            if (p->type == EV_KEY)      minimalEvdevProcessKey(pad, p->code, p->value);
+            else if (p->type == EV_ABS) minimalEvdevProcessAbs(pad, p->code, p->value);
+        }
+
+        pad->packetCount = 0;
+        return;
+    }
+
+    if (pad->dropped || (e->type != EV_KEY && e->type != EV_ABS)) return;
+
+    if (pad->packetCount == MINIMAL_GAMEPAD_PACKET_SIZE)
+    {
+        pad->dropped = 1;
+        pad->packetCount = 0;
+        return;
+    }
+
+    pad->packet[pad->packetCount++] = *e;
+}
+
+static void minimalEvdevRead(MinimalGamepad* pad)
+{
+    struct input_event events[MINIMAL_GAMEPAD_READ_SIZE];
+
+    // a short read means the device is drained
+    ssize_t size = sizeof(events);
+    while (size == (ssize_t)sizeof(events))
+    {
+        size = read(pad->fd, events, sizeof(events));
+        if (size < 0)
+        {
+            // the node can vanish before inotify reports it
+            if (errno != EAGAIN && errno != EINTR) minimalEvdevClose(pad);
+            return;
+        }
+
+        size_t count = (size_t)size / sizeof(struct input_event);
+        for (size_t i = 0; i < count; ++i)
+            minimalEvdevProcessEvent(pad, &events[i]);
+    }
+}
+
+static void minimalEvdevHotplug()
+{
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    ssize_t size;
+    while ((size = read(gamepads.inotify, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* p = buffer; p < buffer + size; )
+        {
+            const struct inotify_event* e = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + e->len;
+
+            if (!e->len) continue;
+
+            if (e->mask & IN_DELETE)                    minimalEvdevRemove(e->name);
+            else if (e->mask & (IN_CREATE | IN_ATTRIB)) minimalEvdevOpen(e->name);
+        }
+    }
+}
+
+uint8_t minimalGamepadInit()
+{
+    if (gamepads.initialized) return MINIMAL_OK;
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        gamepads.pads[i].fd = -1;
+
+    // without inotify the devices connected now still work
+    gamepads.inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (gamepads.inotify >= 0 && inotify_add_watch(gamepads.inotify, MINIMAL_GAMEPAD_DEVICE_DIR, IN_CREATE | IN_ATTRIB | IN_DELETE) < 0)
+    {
+        close(gamepads.inotify);
+        gamepads.inotify = -1;
+    }
+
+    if (gamepads.inotify < 0)
+        MINIMAL_WARN("[Gamepad] Failed to watch %s, hotplugged devices are not detected", MINIMAL_GAMEPAD_DEVICE_DIR);
+
+    gamepads.initialized = 1;
+
+    DIR* dir = opendir(MINIMAL_GAMEPAD_DEVICE_DIR);
+    if (!dir) return MINIMAL_OK;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL)
+        minimalEvdevOpen(entry->d_name);
+
+    closedir(dir);
+    return MINIMAL_OK;
+}
+
+void minimalGamepadTerminate()
+{
+    if (!gamepads.initialized) return;
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        minimalEvdevClose(&gamepads.pads[i]);
+
+    if (gamepads.inotify >= 0) close(gamepads.inotify);
+    gamepads.inotify = -1;
+    gamepads.initialized = 0;
+}
+
+void minimalUpdateGamepads()
+{
+    if (!gamepads.initialized) return;
+
+    if (gamepads.inotify >= 0) minimalEvdevHotplug();
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+    {
+        MinimalGamepad* pad = &gamepads.pads[i];
+        if (pad->fd < 0) continue;
+
+        pad->prev_buttons = pad->buttons;
+
+        // devices are not read while live input is discarded, buttons keep their state without edges
+        if (minimalEventsDiscarded()) continue;
+
+        minimalEvdevRead(pad);
+
+        if (pad->fd >= 0) minimalGamepadApplyDeadzone(pad);
+    }
+}
+
+#else
+
+uint8_t minimalGamepadInit()
+{
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        gamepads.pads[i].fd = -1;
+
+    gamepads.initialized = 1;
+    return MINIMAL_OK;
+}
+
+void minimalGamepadTerminate()  { gamepads.initialized = 0; }
+void minimalUpdateGamepads()    { }
+
+#endif // __linux__
+
+/* --------------------------| gamepad |--------------------------------- */
+void minimalSetGamepadDeadzone(float deadzone)
+{
+    // a deadzone of one would divide by zero when rescaling
+    if (deadzone < 0.0f)  deadzone = 0.0f;
+    if (deadzone > 0.99f) deadzone = 0.99f;
+
+    gamepads.deadzone = deadzone;
+
+    for (int i = 0; i < MINIMAL_GAMEPAD_MAX; ++i)
+        minimalGamepadApplyDeadzone(&gamepads.pads[i]);
+}
+
+uint8_t minimalGamepadConnected(uint32_t pad)
+{
+    return minimalGamepadValid(pad);
+}
+
+const char* minimalGamepadName(uint32_t pad)
+{
+    return minimalGamepadValid(pad) ? gamepads.pads[pad].name : NULL;
+}
+
+uint8_t minimalGamepadPressed(uint32_t pad, MinimalGamepadButton button)
+{
+    if (!minimalGamepadValid(pad) || !minimalGamepadButtonValid(button)) return 0;
+
+    const MinimalGamepad* p = &gamepads.pads[pad];
+    return ((p->buttons & ~p->prev_buttons) >> button) & 1;
+}
+
+uint8_t minimalGamepadReleased(uint32_t pad, MinimalGamepadButton button)
+{
+    if (!minimalGamepadValid(pad) || !minimalGamepadButtonValid(button)) return 0;
+
+    const MinimalGamepad* p = &gamepads.pads[pad];
+    return ((p->prev_buttons & ~p->buttons) >> button) & 1;
+}
+
+uint8_t minimalGamepadDown(uint32_t pad, MinimalGamepadButton button)
+{
+    if (!minimalGamepadValid(pad) || !minimalGamepadButtonValid(button)) return 0;
+
+    return (gamepads.pads[pad].buttons >> button) & 1;
+}
+
+float minimalGamepadAxis(uint32_t pad, MinimalGamepadAxis axis)
+{
+    if (!minimalGamepadValid(pad) || axis < 0 || axis > MINIMAL_GAMEPAD_AXIS_LAST) return 0.0f;
+
+    return gamepads.pads[pad].axes[axis];
+}
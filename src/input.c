@@ -1,50 +1,181 @@
 #include "minimal.h"
 
+/* one bit per keycode, 256 bits cover every valid keycode */
+#define MINIMAL_KEY_WORDS   4
+
+#if MINIMAL_KEY_LAST >= MINIMAL_KEY_WORDS * 64
+#error "keycodes have to fit into the key bitset"
+#endif
+
+#define MINIMAL_BIT_TEST(bits, i)   (((bits)[(i) >> 6] >> ((i) & 63)) & 1)
+#define MINIMAL_BIT_SET(bits, i)    ((bits)[(i) >> 6] |= (uint64_t)1 << ((i) & 63))
+#define MINIMAL_BIT_CLEAR(bits, i)  ((bits)[(i) >> 6] &= ~((uint64_t)1 << ((i) & 63)))
+
+/* a key or button that changed, in the order the changes happened */
 typedef struct
 {
-    uint8_t keys[MINIMAL_KEY_LAST + 1];
-    uint8_t prev_keys[MINIMAL_KEY_LAST + 1];
+    uint64_t time;
+    int16_t code;
+    uint8_t action;
+} MinimalTransition;
 
-    uint8_t buttons[MINIMAL_MOUSE_BUTTON_LAST + 1];
-    uint8_t prev_buttons[MINIMAL_MOUSE_BUTTON_LAST + 1];
+typedef struct
+{
+    uint64_t keys[MINIMAL_KEY_WORDS];
+    uint64_t prev_keys[MINIMAL_KEY_WORDS];
+
+    // edges since the start of the frame, kept up to date with every key event
+    uint64_t pressed_keys[MINIMAL_KEY_WORDS];
+    uint64_t released_keys[MINIMAL_KEY_WORDS];
+
+    uint8_t buttons;
+    uint8_t prev_buttons;
+
+    // transitions since the start of the frame, later ones are not logged once full
+    MinimalTransition keyLog[MINIMAL_INPUT_LOG_SIZE];
+    uint32_t keyLogCount;
+    MinimalTransition buttonLog[MINIMAL_INPUT_LOG_SIZE];
+    uint32_t buttonLogCount;
 
     float cursorX, cursorY;
+    float frameCursorX, frameCursorY;
+
+    // raw motion of the frame in 24.8 fixed point, exact no matter how many samples add up
+    int32_t rawX, rawY;
+
+    uint8_t recordHistory;
+    uint32_t historyCount;
+    MinimalMouseSample history[MINIMAL_MOUSE_HISTORY_SIZE];
 } MinimalInputState;
 
 static MinimalInputState state = { 0 };
 
+#if MINIMAL_ACTION_MAX > 64
+#error "MINIMAL_ACTION_MAX can be at most 64"
+#endif
+
+#define MINIMAL_BINDING_KEY         0
+#define MINIMAL_BINDING_BUTTON      1
+#define MINIMAL_BINDING_AXIS        2
+
+typedef struct
+{
+    uint8_t kind;
+    uint8_t action;
+    int16_t code;
+    uint32_t keymod;
+    float scale;
+} MinimalBinding;
+
+/*
+ * Bindings are registered in any order and compiled into a table grouped by
+ * kind, which is evaluated in one pass on the first query after the input changed.
+ */
+static struct
+{
+    MinimalBinding bindings[MINIMAL_ACTION_MAX_BINDINGS];
+    uint32_t count;
+
+    MinimalBinding table[MINIMAL_ACTION_MAX_BINDINGS];
+    uint32_t keyCount;
+    uint32_t buttonCount;
+    uint32_t axisCount;
+
+    uint64_t down;
+    uint64_t prev;
+    float values[MINIMAL_ACTION_MAX];
+    uint8_t dirty;
+} actions;
+
+static void minimalEvaluateActions();
+
 void minimalUpdateInput()
 {
-    MINIMAL_MEMCPY(&state.prev_keys, &state.keys, MINIMAL_KEY_LAST + 1);
-    MINIMAL_MEMCPY(&state.prev_buttons, &state.buttons, MINIMAL_MOUSE_BUTTON_LAST + 1);
+    // the previous frame has to be settled before its state becomes the previous one
+    if (actions.dirty) minimalEvaluateActions();
+    actions.prev = actions.down;
+    actions.dirty = 1;
+
+    state.frameCursorX = state.cursorX;
+    state.frameCursorY = state.cursorY;
+    state.rawX = 0;
+    state.rawY = 0;
+
+    // the keys of the frame become the previous ones and there are no edges yet
+    MINIMAL_MEMCPY(state.prev_keys, state.keys, sizeof(state.keys));
+    MINIMAL_MEMSET(state.pressed_keys, 0, sizeof(state.pressed_keys));
+    MINIMAL_MEMSET(state.released_keys, 0, sizeof(state.released_keys));
+    state.prev_buttons = state.buttons;
+    state.keyLogCount = 0;
+    state.buttonLogCount = 0;
+    state.historyCount = 0;
 }
 
 uint8_t minimalProcessKey(MinimalKeycode keycode, uint8_t action)
 {
-    if (minimalKeycodeValid(keycode) && state.keys[keycode] != action)
-    {
-        state.keys[keycode] = action;
-        return MINIMAL_OK;
-    }
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
+
+    if (!minimalKeycodeValid(keycode) || MINIMAL_BIT_TEST(state.keys, keycode) == (action != 0))
+        return MINIMAL_FAIL;
+
+    if (action) MINIMAL_BIT_SET(state.keys, keycode);
+    else        MINIMAL_BIT_CLEAR(state.keys, keycode);
+
+    // only the word holding the key can change its edges
+    int w = keycode >> 6;
+    state.pressed_keys[w] = state.keys[w] & ~state.prev_keys[w];
+    state.released_keys[w] = state.prev_keys[w] & ~state.keys[w];
 
-    return MINIMAL_FAIL;
+    if (state.keyLogCount < MINIMAL_INPUT_LOG_SIZE)
+        state.keyLog[state.keyLogCount++] = (MinimalTransition){ minimalGetEventTime(), keycode, action != 0 };
+
+    actions.dirty = 1;
+    return MINIMAL_OK;
 }
 
 uint8_t minimalProcessMouseButton(MinimalMouseButton button, uint8_t action)
 {
-    if (minimalMouseButtonValid(button) && state.buttons[button] != action)
-    {
-        state.buttons[button] = action;
-        return MINIMAL_OK;
-    }
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
+
+    if (!minimalMouseButtonValid(button)) return MINIMAL_FAIL;
+
+    uint8_t bit = (uint8_t)(1 << button);
+    if (((state.buttons & bit) != 0) == (action != 0)) return MINIMAL_FAIL;
+
+    if (action) state.buttons |= bit;
+    else        state.buttons &= ~bit;
+
+    if (state.buttonLogCount < MINIMAL_INPUT_LOG_SIZE)
+        state.buttonLog[state.buttonLogCount++] = (MinimalTransition){ minimalGetEventTime(), button, action != 0 };
 
-    return MINIMAL_FAIL;
+    actions.dirty = 1;
+    return MINIMAL_OK;
 }
 
 uint8_t minimalProcessMouseMove(float x, float y)
 {
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
+
     state.cursorX = x;
     state.cursorY = y;
+
+    // samples past the capacity are dropped, the cursor position stays current
+    if (state.recordHistory && state.historyCount < MINIMAL_MOUSE_HISTORY_SIZE)
+        state.history[state.historyCount++] = (MinimalMouseSample){ x, y };
+
+    actions.dirty = 1;
+    return MINIMAL_OK;
+}
+
+uint8_t minimalProcessMouseRaw(int32_t dx, int32_t dy)
+{
+    if (minimalEventsDiscarded()) return MINIMAL_FAIL;
+
+    if (!dx && !dy) return MINIMAL_FAIL;
+
+    state.rawX += dx;
+    state.rawY += dy;
+
     return MINIMAL_OK;
 }
 
@@ -60,39 +191,34 @@ uint8_t minimalMouseButtonValid(MinimalMouseButton button)
 
 uint8_t minimalKeyPressed(MinimalKeycode keycode)
 {
-    if (state.keys[keycode])
-    {
-        MINIMAL_INFO("State: %d", state.keys[keycode]);
-        MINIMAL_INFO("Prev:  %d", state.prev_keys[keycode]);
-    }
     if (!minimalKeycodeValid(keycode)) return 0;
-    return state.keys[keycode] && !state.prev_keys[keycode];
+    return MINIMAL_BIT_TEST(state.pressed_keys, keycode);
 }
 
 uint8_t minimalKeyReleased(MinimalKeycode keycode)
 {
     if (!minimalKeycodeValid(keycode)) return 0;
-    return state.prev_keys[keycode] && !state.keys[keycode];
+    return MINIMAL_BIT_TEST(state.released_keys, keycode);
 }
 
 uint8_t minimalKeyDown(MinimalKeycode keycode)
 {
     if (!minimalKeycodeValid(keycode)) return 0;
-    return state.keys[keycode];
+    return MINIMAL_BIT_TEST(state.keys, keycode);
 }
 
 uint8_t minimalKeyModActive(uint32_t keymod)
 {
     if (keymod == 0) return 1;
 
-    if ((keymod & MINIMAL_KEY_MOD_SHIFT) && !state.keys[MINIMAL_KEY_SHIFT])
+    if ((keymod & MINIMAL_KEY_MOD_SHIFT) && !MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_SHIFT))
         return 0;
-    if ((keymod & MINIMAL_KEY_MOD_CONTROL) && !state.keys[MINIMAL_KEY_CONTROL])
+    if ((keymod & MINIMAL_KEY_MOD_CONTROL) && !MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_CONTROL))
         return 0;
-    if ((keymod & MINIMAL_KEY_MOD_ALT) && !state.keys[MINIMAL_KEY_ALT])
+    if ((keymod & MINIMAL_KEY_MOD_ALT) && !MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_ALT))
         return 0;
     if ((keymod & MINIMAL_KEY_MOD_COMMAND) 
-        && !(state.keys[MINIMAL_KEY_LCOMMAND] || state.keys[MINIMAL_KEY_RCOMMAND]))
+        && !(MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_LCOMMAND) || MINIMAL_BIT_TEST(state.keys, MINIMAL_KEY_RCOMMAND)))
         return 0;
 
     return 1;
@@ -102,21 +228,82 @@ uint8_t minimalKeyModActive(uint32_t keymod)
 uint8_t minimalMousePressed(MinimalMouseButton button)
 {
     if (!minimalMouseButtonValid(button)) return 0;
-    return state.buttons[button] && !state.prev_buttons[button];
+    return (state.buttons & ~state.prev_buttons) >> button & 1;
 }
 
 uint8_t minimalMouseReleased(MinimalMouseButton button)
 {
     if (!minimalMouseButtonValid(button)) return 0;
-    return state.prev_buttons[button] && !state.buttons[button];
+    return (state.prev_buttons & ~state.buttons) >> button & 1;
 }
 
 uint8_t minimalMouseDown(MinimalMouseButton button)
 {
     if (!minimalMouseButtonValid(button)) return 0;
-    return state.buttons[button];
+    return state.buttons >> button & 1;
+}
+
+static uint32_t minimalReadKeyLog(uint8_t action, MinimalKeycode* keys, uint32_t max)
+{
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < state.keyLogCount && written < max; ++i)
+    {
+        if (state.keyLog[i].action == action)
+            keys[written++] = state.keyLog[i].code;
+    }
+    return written;
 }
 
+static uint32_t minimalReadButtonLog(uint8_t action, MinimalMouseButton* buttons, uint32_t max)
+{
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < state.buttonLogCount && written < max; ++i)
+    {
+        if (state.buttonLog[i].action == action)
+            buttons[written++] = (MinimalMouseButton)state.buttonLog[i].code;
+    }
+    return written;
+}
+
+/* number of presses of the code in a log and the time of the first one */
+static uint32_t minimalCountPresses(const MinimalTransition* log, uint32_t count, int16_t code, uint64_t* time)
+{
+    uint32_t presses = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (log[i].code != code || log[i].action != MINIMAL_PRESS) continue;
+
+        if (!presses && time) *time = log[i].time;
+        presses++;
+    }
+    return presses;
+}
+
+uint32_t minimalKeyPressCount(MinimalKeycode keycode)
+{
+    return minimalCountPresses(state.keyLog, state.keyLogCount, keycode, NULL);
+}
+
+uint8_t minimalKeyPressedAt(MinimalKeycode keycode, uint64_t* time)
+{
+    return minimalCountPresses(state.keyLog, state.keyLogCount, keycode, time) > 0;
+}
+
+uint32_t minimalMousePressCount(MinimalMouseButton button)
+{
+    return minimalCountPresses(state.buttonLog, state.buttonLogCount, button, NULL);
+}
+
+uint8_t minimalMousePressedAt(MinimalMouseButton button, uint64_t* time)
+{
+    return minimalCountPresses(state.buttonLog, state.buttonLogCount, button, time) > 0;
+}
+
+uint32_t minimalGetPressedKeys(MinimalKeycode* keys, uint32_t max)              { return minimalReadKeyLog(MINIMAL_PRESS, keys, max); }
+uint32_t minimalGetReleasedKeys(MinimalKeycode* keys, uint32_t max)             { return minimalReadKeyLog(MINIMAL_RELEASE, keys, max); }
+uint32_t minimalGetPressedButtons(MinimalMouseButton* buttons, uint32_t max)    { return minimalReadButtonLog(MINIMAL_PRESS, buttons, max); }
+uint32_t minimalGetReleasedButtons(MinimalMouseButton* buttons, uint32_t max)   { return minimalReadButtonLog(MINIMAL_RELEASE, buttons, max); }
+
 void minimalCursorPos(float* x, float* y)
 {
     if (x) *x = state.cursorX;
@@ -125,3 +312,145 @@ void minimalCursorPos(float* x, float* y)
 
 float minimalCursorX() { return state.cursorX; }
 float minimalCursorY() { return state.cursorY; }
+
+void minimalMouseDelta(float* dx, float* dy)
+{
+    if (dx) *dx = (float)state.rawX / MINIMAL_MOUSE_RAW_ONE;
+    if (dy) *dy = (float)state.rawY / MINIMAL_MOUSE_RAW_ONE;
+}
+
+void minimalSetMouseHistory(uint8_t enable)
+{
+    state.recordHistory = enable;
+    state.historyCount = 0;
+}
+
+const MinimalMouseSample* minimalGetMouseHistory(uint32_t* count)
+{
+    if (count) *count = state.historyCount;
+    return state.history;
+}
+
+/* --------------------------| actions |--------------------------------- */
+/* the action is checked before it is narrowed to fit the binding */
+static uint8_t minimalAddBinding(uint8_t kind, uint32_t action, int16_t code, uint32_t keymod, float scale)
+{
+    if (action >= MINIMAL_ACTION_MAX || actions.count >= MINIMAL_ACTION_MAX_BINDINGS)
+    {
+        MINIMAL_ERROR("[Input] Failed to bind action %u", action);
+        return MINIMAL_FAIL;
+    }
+
+    actions.bindings[actions.count++] = (MinimalBinding){ kind, (uint8_t)action, code, keymod, scale };
+    return MINIMAL_OK;
+}
+
+uint8_t minimalBindKey(uint32_t action, MinimalKeycode key, uint32_t keymod, float scale)
+{
+    if (!minimalKeycodeValid(key)) return MINIMAL_FAIL;
+    return minimalAddBinding(MINIMAL_BINDING_KEY, action, key, keymod, scale);
+}
+
+uint8_t minimalBindMouseButton(uint32_t action, MinimalMouseButton button, uint32_t keymod, float scale)
+{
+    if (!minimalMouseButtonValid(button)) return MINIMAL_FAIL;
+    return minimalAddBinding(MINIMAL_BINDING_BUTTON, action, button, keymod, scale);
+}
+
+uint8_t minimalBindMouseAxis(uint32_t action, MinimalMouseAxis axis, float scale)
+{
+    if (axis != MINIMAL_MOUSE_AXIS_X && axis != MINIMAL_MOUSE_AXIS_Y) return MINIMAL_FAIL;
+    return minimalAddBinding(MINIMAL_BINDING_AXIS, action, (int16_t)axis, 0, scale);
+}
+
+void minimalClearBindings()
+{
+    actions.count = 0;
+}
+
+void minimalCompileBindings()
+{
+    uint32_t count = 0;
+    for (uint8_t kind = MINIMAL_BINDING_KEY; kind <= MINIMAL_BINDING_AXIS; ++kind)
+    {
+        uint32_t first = count;
+        for (uint32_t i = 0; i < actions.count; ++i)
+        {
+            if (actions.bindings[i].kind == kind)
+                actions.table[count++] = actions.bindings[i];
+        }
+
+        if (kind == MINIMAL_BINDING_KEY)    actions.keyCount = count - first;
+        if (kind == MINIMAL_BINDING_BUTTON) actions.buttonCount = count - first;
+        if (kind == MINIMAL_BINDING_AXIS)   actions.axisCount = count - first;
+    }
+
+    actions.dirty = 1;
+}
+
+static void minimalEvaluateActions()
+{
+    uint64_t down = 0;
+    MINIMAL_MEMSET(actions.values, 0, sizeof(actions.values));
+
+    const MinimalBinding* b = actions.table;
+    for (const MinimalBinding* end = b + actions.keyCount; b < end; ++b)
+    {
+        if (MINIMAL_BIT_TEST(state.keys, b->code) && minimalKeyModActive(b->keymod))
+        {
+            down |= (uint64_t)1 << b->action;
+            actions.values[b->action] += b->scale;
+        }
+    }
+
+    for (const MinimalBinding* end = b + actions.buttonCount; b < end; ++b)
+    {
+        if ((state.buttons >> b->code & 1) && minimalKeyModActive(b->keymod))
+        {
+            down |= (uint64_t)1 << b->action;
+            actions.values[b->action] += b->scale;
+        }
+    }
+
+    // axes report the cursor movement since the start of the frame
+    for (const MinimalBinding* end = b + actions.axisCount; b < end; ++b)
+    {
+        float delta = b->code == MINIMAL_MOUSE_AXIS_X ? state.cursorX - state.frameCursorX : state.cursorY - state.frameCursorY;
+        if (delta != 0.0f)
+        {
+            down |= (uint64_t)1 << b->action;
+            actions.values[b->action] += delta * b->scale;
+        }
+    }
+
+    actions.down = down;
+    actions.dirty = 0;
+}
+
+uint8_t minimalActionDown(uint32_t action)
+{
+    if (action >= MINIMAL_ACTION_MAX) return 0;
+    if (actions.dirty) minimalEvaluateActions();
+    return actions.down >> action & 1;
+}
+
+uint8_t minimalActionPressed(uint32_t action)
+{
+    if (action >= MINIMAL_ACTION_MAX) return 0;
+    if (actions.dirty) minimalEvaluateActions();
+    return (actions.down & ~actions.prev) >> action & 1;
+}
+
+uint8_t minimalActionReleased(uint32_t action)
+{
+    if (action >= MINIMAL_ACTION_MAX) return 0;
+    if (actions.dirty) minimalEvaluateActions();
+    return (actions.prev & ~actions.down) >> action & 1;
+}
+
+float minimalActionValue(uint32_t action)
+{
+    if (action >= MINIMAL_ACTION_MAX) return 0.0f;
+    if (actions.dirty) minimalEvaluateActions();
+    return actions.values[action];
+}
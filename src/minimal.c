@@ -17,30 +17,159 @@ const char* minimalGetVersionString()
     return MINIMAL_MAKE_VERSION_STR(MINIMAL_VERSION_MAJOR, MINIMAL_VERSION_MINOR, MINIMAL_VERSION_REVISION);
 }
 
+/* --------------------------| time |------------------------------------ */
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define MINIMAL_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #include <cpuid.h>
+    #define MINIMAL_TSC
+#endif
+
+#define MINIMAL_TSC_CALIBRATION_NS  5000000
+
+typedef enum
+{
+    MINIMAL_TICKS_UNKNOWN,
+    MINIMAL_TICKS_TSC,
+    MINIMAL_TICKS_NS
+} MinimalTickSource;
+
+static MinimalTickSource _minimalTickSource = MINIMAL_TICKS_UNKNOWN;
+static uint64_t _minimalTickFrequency = 1000000000;
+
+#ifdef MINIMAL_TSC
+static uint8_t minimalHasInvariantTSC()
+{
+    uint32_t regs[4] = { 0 };
+#ifdef _MSC_VER
+    __cpuid((int*)regs, 0x80000000);
+    if (regs[0] < 0x80000007) return 0;
+    __cpuid((int*)regs, 0x80000007);
+#else
+    if (!__get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3])) return 0;
+#endif
+    // edx bit 8: tsc runs at a constant rate in all p-/c-states
+    return (regs[3] >> 8) & 1;
+}
+#endif
+
+/*
+ * Picks the tick source, called by minimalPlatformInit once its clock runs.
+ * The tsc frequency is measured against minimalGetTimeNs by spinning for a few
+ * milliseconds, which would otherwise stall the first call to minimalGetTicks.
+ */
+void minimalInitTicks()
+{
+    _minimalTickSource = MINIMAL_TICKS_NS;
+    _minimalTickFrequency = 1000000000;
+
+#ifdef MINIMAL_TSC
+    if (!minimalHasInvariantTSC()) return;
+
+    uint64_t ns0 = minimalGetTimeNs();
+    uint64_t tsc0 = __rdtsc();
+
+    uint64_t ns1 = ns0;
+    while (ns1 - ns0 < MINIMAL_TSC_CALIBRATION_NS)
+        ns1 = minimalGetTimeNs();
+
+    uint64_t tsc1 = __rdtsc();
+
+    if (tsc1 <= tsc0) return;
+
+    _minimalTickFrequency = (tsc1 - tsc0) * 1000000000 / (ns1 - ns0);
+    _minimalTickSource = MINIMAL_TICKS_TSC;
+#endif
+}
+
+double minimalGetTime()
+{
+    return (double)minimalGetTimeNs() / 1000000000.0;
+}
+
+uint64_t minimalGetTicks()
+{
+    if (_minimalTickSource == MINIMAL_TICKS_UNKNOWN)
+        minimalInitTicks();
+
+#ifdef MINIMAL_TSC
+    if (_minimalTickSource == MINIMAL_TICKS_TSC)
+        return __rdtsc();
+#endif
+
+    return minimalGetTimeNs();
+}
+
+uint64_t minimalTicksToNs(uint64_t ticks)
+{
+    if (_minimalTickSource != MINIMAL_TICKS_TSC)
+        return ticks;
+
+    // split the division so the multiplication can not overflow
+    uint64_t seconds = ticks / _minimalTickFrequency;
+    uint64_t remainder = ticks % _minimalTickFrequency;
+    return seconds * 1000000000 + remainder * 1000000000 / _minimalTickFrequency;
+}
+
 /* --------------------------| game loop |------------------------------- */
 void minimalRun(MinimalWindow* window, MinimalTickCB on_tick, void* context)
 {
-    double seconds = 0.0;
-    double lastframe = 0.0;
+    uint64_t seconds = 0;
+    uint64_t lastframe = 0;
     uint32_t frames = 0;
 
     MinimalFrameData framedata = {0};
 
     while (!minimalShouldClose(window))
     {
-        double time = minimalGetTime();
-        framedata.deltatime = (float)(time - lastframe);
+        uint64_t time = minimalGetTimeNs();
+        uint64_t delta = lastframe ? time - lastframe : 0;
+
+        // replays run on the recorded clock and end with the recording
+        if (minimalReplaying() && !minimalReplayFrame(&time, &delta))
+        {
+            minimalReplayStop();
+            break;
+        }
+
+        framedata.deltatime = (float)((double)delta / 1000000000);
         lastframe = time;
 
+        minimalRecordFrame(time, delta);
+
+        minimalResetEventArena();
         minimalUpdateInput();
-        minimalPollWindowEvents(window);
+
+        uint64_t pollStart = minimalGetTicks();
+        if (minimalReplaying())
+        {
+            // live input is drained to keep the window responsive, the frame only sees the recording
+            minimalDiscardEvents(1);
+            minimalPollWindowEvents(window);
+            minimalUpdateGamepads();
+            minimalDispatchPostedEvents();
+            minimalDiscardEvents(0);
+
+            minimalReplayEvents(window);
+        }
+        else
+        {
+            minimalRecordCapture(1);
+            minimalPollWindowEvents(window);
+            minimalUpdateGamepads();
+            minimalDispatchPostedEvents();
+            minimalRecordCapture(0);
+        }
+        minimalAddEventPollTime(minimalGetTicks() - pollStart);
 
         on_tick(context, &framedata);
 
         frames++;
-        if ((minimalGetTime() - seconds) > 1.0)
+        if ((time - seconds) > 1000000000)
         {
-            seconds += 1.0;
+            seconds += 1000000000;
             framedata.fps = frames;
             frames = 0;
         }
@@ -1,6 +1,15 @@
 #ifndef MINIMAL_H
 #define MINIMAL_H
 
+/*
+ The linux platforms use posix functions hidden by strict -std=c modes. The
+ define has to come before any system header, so include minimal.h first in
+ the file with the implementation or define _DEFAULT_SOURCE yourself.
+*/
+#if defined(MINIMAL_IMPLEMENTATION) && defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -29,19 +38,19 @@ typedef struct MinimalEvent MinimalEvent;
 /* --------------------------| logging |--------------------------------- */
 #ifndef MINIMAL_DISABLE_LOGGING
 
-#define MINIMAL_TRACE(s, ...)       minimalLoggerPrint(MINIMAL_LOG_TRACE, s, __VA_ARGS__)
-#define MINIMAL_INFO(s, ...)        minimalLoggerPrint(MINIMAL_LOG_INFO, s, __VA_ARGS__)
-#define MINIMAL_WARN(s, ...)        minimalLoggerPrint(MINIMAL_LOG_WARN, s, __VA_ARGS__)
-#define MINIMAL_ERROR(s, ...)       minimalLoggerPrint(MINIMAL_LOG_ERROR, s, __VA_ARGS__)
-#define MINIMAL_CRITICAL(s, ...)    minimalLoggerPrint(MINIMAL_LOG_CRITICAL, s, __VA_ARGS__)
+#define MINIMAL_TRACE(...)          minimalLoggerPrint(MINIMAL_LOG_TRACE, __VA_ARGS__)
+#define MINIMAL_INFO(...)           minimalLoggerPrint(MINIMAL_LOG_INFO, __VA_ARGS__)
+#define MINIMAL_WARN(...)           minimalLoggerPrint(MINIMAL_LOG_WARN, __VA_ARGS__)
+#define MINIMAL_ERROR(...)          minimalLoggerPrint(MINIMAL_LOG_ERROR, __VA_ARGS__)
+#define MINIMAL_CRITICAL(...)       minimalLoggerPrint(MINIMAL_LOG_CRITICAL, __VA_ARGS__)
 
 #else
 
-#define MINIMAL_TRACE(s, ...)
-#define MINIMAL_INFO(s, ...)
-#define MINIMAL_WARN(s, ...)
-#define MINIMAL_ERROR(s, ...)
-#define MINIMAL_CRITICAL(s, ...)
+#define MINIMAL_TRACE(...)
+#define MINIMAL_INFO(...)
+#define MINIMAL_WARN(...)
+#define MINIMAL_ERROR(...)
+#define MINIMAL_CRITICAL(...)
 
 #endif
 
@@ -69,6 +78,8 @@ void minimalLoggerPrintV(MinimalLogLevel level, const char* fmt, va_list args);
 #define MINIMAL_ALLOC(size)             malloc(size)
 #define MINIMAL_FREE(block, size)       free(block)
 #define MINIMAL_MEMCPY(dst, src, size)  memcpy(dst, src, size);
+#define MINIMAL_MEMMOVE(dst, src, size) memmove(dst, src, size)
+#define MINIMAL_MEMSET(dst, val, size)  memset(dst, val, size)
 
 
 /* --------------------------| input |----------------------------------- */
@@ -255,6 +266,15 @@ uint8_t minimalProcessKey(MinimalKeycode keycode, uint8_t action);
 uint8_t minimalProcessMouseButton(MinimalMouseButton button, uint8_t action);
 uint8_t minimalProcessMouseMove(float x, float y);
 
+/*
+ Raw motion is the unaccelerated relative movement reported by the device, in
+ 24.8 fixed point counts. Platforms only report it to windows with
+ MINIMAL_EVENT_MOUSE_RAW enabled in their event mask.
+*/
+#define MINIMAL_MOUSE_RAW_ONE       256
+
+uint8_t minimalProcessMouseRaw(int32_t dx, int32_t dy);
+
 uint8_t minimalKeycodeValid(MinimalKeycode keycode);
 uint8_t minimalMouseButtonValid(MinimalMouseButton button);
 
@@ -268,10 +288,149 @@ uint8_t minimalMousePressed(MinimalMouseButton button);
 uint8_t minimalMouseReleased(MinimalMouseButton button);
 uint8_t minimalMouseDown(MinimalMouseButton button);
 
+/*
+ Keys and buttons that changed since the last minimalUpdateInput, in the order
+ they changed. A key pressed and released within one frame shows up in both.
+ Return the number of entries written to the array.
+*/
+#ifndef MINIMAL_INPUT_LOG_SIZE
+#define MINIMAL_INPUT_LOG_SIZE          64  /* transitions logged per frame */
+#endif
+
+uint32_t minimalGetPressedKeys(MinimalKeycode* keys, uint32_t max);
+uint32_t minimalGetReleasedKeys(MinimalKeycode* keys, uint32_t max);
+uint32_t minimalGetPressedButtons(MinimalMouseButton* buttons, uint32_t max);
+uint32_t minimalGetReleasedButtons(MinimalMouseButton* buttons, uint32_t max);
+
+/*
+ Every logged transition carries the time of its event, so taps shorter than a
+ frame are counted even though they never show up as pressed. The time is the
+ one of the first press in the frame, on the clock of minimalGetTimeNs.
+*/
+uint32_t minimalKeyPressCount(MinimalKeycode keycode);
+uint8_t minimalKeyPressedAt(MinimalKeycode keycode, uint64_t* time);
+uint32_t minimalMousePressCount(MinimalMouseButton button);
+uint8_t minimalMousePressedAt(MinimalMouseButton button, uint64_t* time);
+
 void minimalCursorPos(float* x, float* y);
 float minimalCursorX();
 float minimalCursorY();
 
+/* raw motion summed since the last minimalUpdateInput */
+void minimalMouseDelta(float* dx, float* dy);
+
+/* every cursor sample since the last minimalUpdateInput, recorded only when enabled */
+#ifndef MINIMAL_MOUSE_HISTORY_SIZE
+#define MINIMAL_MOUSE_HISTORY_SIZE      256
+#endif
+
+typedef struct
+{
+    float x, y;
+} MinimalMouseSample;
+
+void minimalSetMouseHistory(uint8_t enable);
+const MinimalMouseSample* minimalGetMouseHistory(uint32_t* count);
+
+/* actions */
+/*
+ Actions are ids below MINIMAL_ACTION_MAX bound to keys and buttons, optionally
+ with required key mods, or to the cursor movement of the current frame. Bindings
+ take effect once they are compiled, so they can be swapped at runtime. The value
+ of an action sums the scale of its active digital bindings and the scaled
+ movement of its axes.
+*/
+#ifndef MINIMAL_ACTION_MAX
+#define MINIMAL_ACTION_MAX              64  /* at most 64 */
+#endif
+
+#ifndef MINIMAL_ACTION_MAX_BINDINGS
+#define MINIMAL_ACTION_MAX_BINDINGS     128
+#endif
+
+typedef enum
+{
+    MINIMAL_MOUSE_AXIS_X,
+    MINIMAL_MOUSE_AXIS_Y
+} MinimalMouseAxis;
+
+uint8_t minimalBindKey(uint32_t action, MinimalKeycode key, uint32_t keymod, float scale);
+uint8_t minimalBindMouseButton(uint32_t action, MinimalMouseButton button, uint32_t keymod, float scale);
+uint8_t minimalBindMouseAxis(uint32_t action, MinimalMouseAxis axis, float scale);
+void minimalClearBindings();
+void minimalCompileBindings();
+
+uint8_t minimalActionDown(uint32_t action);
+uint8_t minimalActionPressed(uint32_t action);
+uint8_t minimalActionReleased(uint32_t action);
+float minimalActionValue(uint32_t action);
+
+/* --------------------------| gamepad |--------------------------------- */
+/*
+ Gamepads and joysticks are read from evdev devices on linux, other platforms
+ report none. minimalGamepadInit opens the connected devices and watches for new
+ ones, minimalRun updates them once per frame with every complete report the
+ devices sent since the last frame. Buttons and axes are mapped to the
+ layout of an xbox controller, sticks range from -1 to 1 with y pointing down,
+ triggers from 0 to 1. Values inside the deadzone read as zero.
+*/
+#ifndef MINIMAL_GAMEPAD_MAX
+#define MINIMAL_GAMEPAD_MAX             4
+#endif
+
+#ifndef MINIMAL_GAMEPAD_DEADZONE
+#define MINIMAL_GAMEPAD_DEADZONE        0.15f   /* initial deadzone as a fraction of the range */
+#endif
+
+#define MINIMAL_GAMEPAD_BUTTON_UNKNOWN      -1
+
+#define MINIMAL_GAMEPAD_BUTTON_A            0
+#define MINIMAL_GAMEPAD_BUTTON_B            1
+#define MINIMAL_GAMEPAD_BUTTON_X            2
+#define MINIMAL_GAMEPAD_BUTTON_Y            3
+#define MINIMAL_GAMEPAD_BUTTON_LEFT_BUMPER  4
+#define MINIMAL_GAMEPAD_BUTTON_RIGHT_BUMPER 5
+#define MINIMAL_GAMEPAD_BUTTON_BACK         6
+#define MINIMAL_GAMEPAD_BUTTON_START        7
+#define MINIMAL_GAMEPAD_BUTTON_GUIDE        8
+#define MINIMAL_GAMEPAD_BUTTON_LEFT_THUMB   9
+#define MINIMAL_GAMEPAD_BUTTON_RIGHT_THUMB  10
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_UP      11
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_RIGHT   12
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_DOWN    13
+#define MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT    14
+
+#define MINIMAL_GAMEPAD_BUTTON_LAST         MINIMAL_GAMEPAD_BUTTON_DPAD_LEFT
+
+#define MINIMAL_GAMEPAD_AXIS_LEFT_X         0
+#define MINIMAL_GAMEPAD_AXIS_LEFT_Y         1
+#define MINIMAL_GAMEPAD_AXIS_RIGHT_X        2
+#define MINIMAL_GAMEPAD_AXIS_RIGHT_Y        3
+#define MINIMAL_GAMEPAD_AXIS_LEFT_TRIGGER   4
+#define MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER  5
+
+#define MINIMAL_GAMEPAD_AXIS_LAST           MINIMAL_GAMEPAD_AXIS_RIGHT_TRIGGER
+
+typedef int8_t MinimalGamepadButton;
+typedef int8_t MinimalGamepadAxis;
+
+uint8_t minimalGamepadInit();
+void minimalGamepadTerminate();
+
+/* starts a new frame for all gamepads, does nothing before minimalGamepadInit */
+void minimalUpdateGamepads();
+
+void minimalSetGamepadDeadzone(float deadzone);
+
+uint8_t minimalGamepadConnected(uint32_t pad);
+const char* minimalGamepadName(uint32_t pad);
+
+uint8_t minimalGamepadPressed(uint32_t pad, MinimalGamepadButton button);
+uint8_t minimalGamepadReleased(uint32_t pad, MinimalGamepadButton button);
+uint8_t minimalGamepadDown(uint32_t pad, MinimalGamepadButton button);
+
+float minimalGamepadAxis(uint32_t pad, MinimalGamepadAxis axis);
+
 /* --------------------------| event |----------------------------------- */
 #define MINIMAL_EVENT_UNKOWN            0
 
@@ -288,20 +447,182 @@ float minimalCursorY();
 #define MINIMAL_EVENT_MOUSE_BUTTON      12
 #define MINIMAL_EVENT_MOUSE_MOVED       13
 #define MINIMAL_EVENT_MOUSE_SCROLLED    14
+#define MINIMAL_EVENT_MOUSE_RAW         15
 
-#define MINIMAL_EVENT_LAST              MINIMAL_EVENT_MOUSE_SCROLLED
+#define MINIMAL_EVENT_LAST              MINIMAL_EVENT_MOUSE_RAW
+
+struct MinimalEvent
+{
+    uint32_t type;
+    uint32_t seq;
+    MinimalWindow* window;
+    uint64_t time;
+    union
+    {
+        struct
+        {
+            uint32_t uParam;
+            int32_t lParam;
+            int32_t rParam;
+        };
+        const void* external;
+    };
+};
 
 /* Dispatch */
 typedef uint8_t(*MinimalEventCB)(void* context, const MinimalEvent* e);
 void minimalSetEventHandler(void* context, MinimalEventCB callback);
 
+/*
+ Subscribers only see events of their type. External types share one list, and
+ its limit, but are still told apart. Higher priorities run first, a callback
+ returning nonzero consumes the event and stops it from reaching lower
+ priorities and the event handler, which runs last. Callbacks may subscribe and
+ unsubscribe, removed subscribers are not called anymore and new ones only see
+ events dispatched after the current delivery returns.
+*/
+#ifndef MINIMAL_EVENT_MAX_SUBSCRIBERS
+#define MINIMAL_EVENT_MAX_SUBSCRIBERS   8   /* per event type */
+#endif
+
+/*
+ With a batch handler the events of one poll are collected and passed in a
+ single call, sorted by arrival, when the platform flushes at the end of the
+ poll. It replaces subscribers and the event handler in callback mode.
+*/
+typedef void(*MinimalEventBatchCB)(void* context, const MinimalEvent* events, size_t count);
+void minimalSetEventBatchHandler(void* context, MinimalEventBatchCB callback);
+
+uint8_t minimalSubscribeEvent(uint32_t type, int32_t priority, void* context, MinimalEventCB callback);
+void minimalUnsubscribeEvent(uint32_t type, void* context, MinimalEventCB callback);
+
+/* Queue */
+#ifndef MINIMAL_EVENT_QUEUE_SIZE
+#define MINIMAL_EVENT_QUEUE_SIZE        256 /* must be a power of two */
+#endif
+
+typedef enum
+{
+    MINIMAL_EVENT_MODE_CALLBACK,    /* events are passed to the event handler while polling */
+    MINIMAL_EVENT_MODE_QUEUE        /* events are buffered until they are pulled with minimalPollEvent */
+} MinimalEventMode;
+
+void minimalSetEventMode(MinimalEventMode mode);
+
+/*
+ Coalescing merges consecutive mouse moves of a window into one event carrying
+ the final position and the summed delta, consecutive raw motion into its sum
+ and consecutive resizes into the last size. In callback mode the last merged event is delivered by minimalFlushEvents,
+ which the platform calls at the end of every poll.
+*/
+void minimalSetEventCoalescing(uint8_t enable);
+void minimalFlushEvents();
+
+uint8_t minimalPollEvent(MinimalEvent* e);
+uint32_t minimalGetDroppedEventCount();
+
 void minimalDispatchEvent(uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam);
+void minimalDispatchWindowEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam);
 void minimalDispatchExternalEvent(uint32_t type, const void* data);
 
+/*
+ While discarding, input from the platforms, gamepads and other threads is
+ drained without updating the input state or reaching any handler. minimalRun
+ discards live input while it replays a recording.
+*/
+void minimalDiscardEvents(uint8_t discard);
+uint8_t minimalEventsDiscarded();
+
+/*
+ Motion events carry the distance to the last motion event of the same window.
+ Platforms reset it when the cursor leaves a window or the window is destroyed,
+ so the next move starts with a zero delta instead of a jump.
+*/
+void minimalResetMouseDelta(MinimalWindow* window);
+
+/*
+ Copies the payload into an arena owned by the event system, so it can be
+ deferred without keeping the data alive. minimalRun resets the arena at the
+ start of every frame, copies are valid until then.
+*/
+#ifndef MINIMAL_EVENT_ARENA_SIZE
+#define MINIMAL_EVENT_ARENA_SIZE        16384   /* must be a multiple of 8 */
+#endif
+
+uint8_t minimalDispatchExternalEventCopy(uint32_t type, const void* data, size_t size);
+void minimalResetEventArena();
+
+/*
+ Events are stamped on the clock of minimalGetTimeNs when they are dispatched.
+ Platforms pass the time the os reported for the input they translate instead,
+ rebasing its millisecond clock with minimalRebaseEventTime. Zero clears it.
+*/
+void minimalSetEventTime(uint64_t ns);
+uint64_t minimalRebaseEventTime(uint32_t ms);
+
+/* the time the next dispatched event is stamped with */
+uint64_t minimalGetEventTime();
+
+/*
+ Posting is safe from any thread and never blocks. The payload is copied into a
+ fixed size slot and handed to handlers as external event data on the main thread
+ by minimalDispatchPostedEvents, which minimalRun calls once per frame. The data
+ is moved to the event arena and stays valid like a copied event, its slot is
+ free again right away. Events are dropped if the queue is full and wait for the
+ next frame if the arena is.
+*/
+#ifndef MINIMAL_POST_QUEUE_SIZE
+#define MINIMAL_POST_QUEUE_SIZE         256 /* must be a power of two */
+#endif
+
+#ifndef MINIMAL_POST_EVENT_SIZE
+#define MINIMAL_POST_EVENT_SIZE         64  /* must be a multiple of 8 */
+#endif
+
+uint8_t minimalPostExternalEvent(uint32_t type, const void* data, size_t size);
+void minimalDispatchPostedEvents();
+uint32_t minimalGetDroppedPostedEventCount();
+
+/*
+ Masked out event types are dropped by the platform before any translation work,
+ on X11 the server stops sending them. Masked keys and mouse buttons do not update
+ the input state either. Windows start with every type but raw motion enabled.
+*/
+#define MINIMAL_EVENT_MASK(type)        ((uint32_t)1 << (type))
+#define MINIMAL_EVENT_MASK_ALL          0xffffffff
+#define MINIMAL_EVENT_MASK_DEFAULT      (MINIMAL_EVENT_MASK_ALL & ~MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW))
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask);
+
+/* used by the platforms, events without a window are always enabled */
+#define MINIMAL_EVENT_ENABLED(window, type) (!(window) || ((window)->eventMask & MINIMAL_EVENT_MASK(type)))
+
+/* Statistics */
+typedef struct
+{
+    uint32_t dispatched[MINIMAL_EVENT_LAST + 2];    /* per builtin type, external events in the last slot */
+    uint32_t coalesced;                             /* events merged into an earlier one */
+    uint32_t dropped;                               /* events lost to a full queue or batch */
+    uint32_t highWater;                             /* most events waiting in the queue or batch */
+    uint64_t pollTime;                              /* ns spent polling in minimalRun, including handlers */
+    uint64_t handlerTime;                           /* ns spent in subscribers and handlers */
+} MinimalEventStats;
+
+/* counters accumulate until they are reset, e.g. once per frame */
+void minimalGetEventStats(MinimalEventStats* stats);
+void minimalResetEventStats();
+
 /* Utility */
 uint8_t minimalEventIsType(const MinimalEvent* e, uint32_t type);
 uint8_t minimalEventIsExternal(const MinimalEvent* e);
 
+/* window the event was sent to, NULL for events without a window */
+MinimalWindow* minimalEventWindow(const MinimalEvent* e);
+
+/* nanoseconds on the clock of minimalGetTimeNs and a number counting up with every dispatched event */
+uint64_t minimalEventTimestamp(const MinimalEvent* e);
+uint32_t minimalEventSequence(const MinimalEvent* e);
+
 const void* minimalExternalEvent(const MinimalEvent* e);
 
 uint8_t minimalEventWindowSize(const MinimalEvent* e, uint32_t* w, uint32_t* h);
@@ -312,6 +633,8 @@ uint8_t minimalEventMouseButtonReleased(const MinimalEvent* e, MinimalMouseButto
 uint16_t minimalEventMouseButtonAction(const MinimalEvent* e);
 
 uint8_t minimalEventMouseMoved(const MinimalEvent* e, float* x, float* y);
+uint8_t minimalEventMouseDelta(const MinimalEvent* e, int32_t* dx, int32_t* dy);
+uint8_t minimalEventMouseRaw(const MinimalEvent* e, float* dx, float* dy);
 uint8_t minimalEventMouseScrolled(const MinimalEvent* e, float* xoffset, float* yoffset);
 
 MinimalKeycode minimalEventKey(const MinimalEvent* e);
@@ -320,26 +643,69 @@ MinimalKeycode minimalEventKeyReleased(const MinimalEvent* e);
 
 char minimalEventChar(const MinimalEvent* e);
 
+/* --------------------------| record |---------------------------------- */
+/*
+ Recordings capture the input minimalRun polls and the time of every frame in a
+ compact binary log. Events dispatched by handlers or on_tick are left out, the
+ replay dispatches them again. Payloads of external events are kept if their
+ size is known (copied and posted events), events passed with a payload to
+ minimalDispatchExternalEvent are left out with a warning. Replaying feeds the
+ events back through the input state and the handlers, with minimalRun running
+ on the recorded clock as fast as possible and returning at the end of the
+ recording. Replayed events are sent to the window passed to minimalRun, live
+ input is discarded until the replay ends.
+*/
+uint8_t minimalRecordStart(const char* path);
+
+/* fails if the recording is incomplete, a failed write ends it early */
+uint8_t minimalRecordStop();
+
+uint8_t minimalReplayStart(const char* path);
+void minimalReplayStop();
+uint8_t minimalReplaying();
+
 
 /* --------------------------| platform |-------------------------------- */
 /*
  Possible platforms
 
 #define MINIMAL_PLATFORM_WINDOWS
+#define MINIMAL_PLATFORM_X11        (link with -lX11 -lXext -lXi -lGL)
+#define MINIMAL_PLATFORM_WAYLAND    (link with -lwayland-client -lwayland-egl -lxkbcommon -lEGL,
+                                     generate the client header and private code of xdg-shell,
+                                     relative-pointer-unstable-v1 and pointer-constraints-unstable-v1
+                                     with wayland-scanner and compile the three protocol .c files)
+#define MINIMAL_PLATFORM_HEADLESS   (link with -lEGL, no display required)
 #define MINIMAL_PLATFORM_GLFW
 
 dissable opengl context creation with:
 #define MINIMAL_NO_CONTEXT
 
+create the context through egl instead of wgl/glx with:
+#define MINIMAL_CONTEXT_EGL         (link with -lEGL, wayland and headless always use egl)
+
 */
 
+#if (defined(MINIMAL_PLATFORM_WAYLAND) || defined(MINIMAL_PLATFORM_HEADLESS)) && !defined(MINIMAL_CONTEXT_EGL)
+#define MINIMAL_CONTEXT_EGL
+#endif
+
+#ifdef MINIMAL_NO_CONTEXT
+#undef MINIMAL_CONTEXT_EGL
+#endif
+
 typedef enum
 {
     MINIMAL_HINT_CONTEXT_MAJOR_VERSION,
     MINIMAL_HINT_CONTEXT_MINOR_VERSION,
+    MINIMAL_HINT_CLIENT_API,
     MINIMAL_HINT_MAX_ENUM
 } MinimalWindowHint;
 
+/* values for MINIMAL_HINT_CLIENT_API, windows without api get no context (e.g. for vulkan) */
+#define MINIMAL_OPENGL_API  0
+#define MINIMAL_NO_API      1
+
 void minimalSetWindowHint(MinimalWindowHint name, int32_t value);
 
 uint8_t minimalPlatformInit();
@@ -352,19 +718,55 @@ void minimalSetWindowTitle(MinimalWindow* window, const char* title);
 
 void minimalPollWindowEvents(MinimalWindow* window);
 
+/* processes the events of every window in one pass */
+void minimalPollAllEvents();
+
+/*
+ * sleeps until events arrive, the timeout in nanoseconds expires or minimalWakeWindow
+ * is called, then processes the events of every window like minimalPollAllEvents
+ */
+#define MINIMAL_WAIT_INFINITE   UINT64_MAX
+
+void minimalWaitWindowEvents(MinimalWindow* window, uint64_t timeout);
+void minimalWakeWindow(MinimalWindow* window); /* can be called from any thread */
+
 uint8_t minimalShouldClose(const MinimalWindow* window);
 void minimalClose(MinimalWindow* window);
 
 void minimalMaximize(MinimalWindow* window);
 void minimalMinimize(MinimalWindow* window);
 
+/* hides the cursor and keeps it inside the window, e.g. for camera control with raw motion */
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock);
+
+/* time since minimalPlatformInit */
 double minimalGetTime();
+uint64_t minimalGetTimeNs();
+
+/* cheap timestamps for hot paths (invariant tsc if available, else nanoseconds) */
+uint64_t minimalGetTicks();
+uint64_t minimalTicksToNs(uint64_t ticks);
 
 void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h);
 void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale);
 
 void* minimalGetNativeWindowHandle(const MinimalWindow* window);
 
+/* Display* on x11, wl_display* on wayland, HINSTANCE on windows */
+void* minimalGetNativeDisplayHandle();
+
+/* cpu framebuffer of 0x00RRGGBB pixels, rows are tightly packed */
+#define MINIMAL_FRAMEBUFFER_COUNT   2
+
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h);
+void minimalDestroyFramebuffer(MinimalWindow* window);
+
+/*
+ * presents the current buffer and returns the one to draw the next frame into,
+ * its previous content is undefined. NULL if the window closes first.
+ */
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window);
+
 #ifndef MINIMAL_NO_CONTEXT
 
 void* minimalGetGLProcAddress(const char* name);
@@ -374,6 +776,41 @@ void minimalSwapBuffers(MinimalWindow* context);
 
 #endif
 
+/* --------------------------| vulkan |---------------------------------- */
+/* instance extensions needed by minimalCreateVulkanSurface, NULL if vulkan is unavailable */
+const char** minimalGetRequiredVulkanInstanceExtensions(uint32_t* count);
+
+#ifdef VK_VERSION_1_0
+VkResult minimalCreateVulkanSurface(VkInstance instance, const MinimalWindow* window, const VkAllocationCallbacks* allocator, VkSurfaceKHR* surface);
+#endif
+
+#ifdef MINIMAL_PLATFORM_HEADLESS
+
+/* queue an event to be processed by the next minimalPollWindowEvents */
+uint8_t minimalInjectEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam);
+
+#endif
+
+#ifdef MINIMAL_CONTEXT_EGL
+
+/* egl context creation shared by the platform backends */
+typedef struct
+{
+    void* surface;
+    void* context;
+} MinimalEGLContext;
+
+uint8_t minimalEGLInit(uint32_t platform, void* nativeDisplay);
+void minimalEGLTerminate();
+
+uint8_t minimalEGLCreateContext(MinimalEGLContext* egl, void* nativeWindow, uint32_t w, uint32_t h, int32_t major, int32_t minor);
+void minimalEGLDestroyContext(MinimalEGLContext* egl);
+
+void minimalEGLSwapBuffers(MinimalEGLContext* egl);
+void minimalEGLSwapInterval(int32_t interval);
+
+#endif
+
 /* --------------------------| game loop |------------------------------- */
 typedef struct
 {
@@ -386,6 +823,18 @@ void minimalRun(MinimalWindow* window, MinimalTickCB on_tick, void* context);
 
 void minimalClose(MinimalWindow* window);
 
+/* --------------------------| internal |-------------------------------- */
+/* shared between the modules, not meant to be called by applications */
+void minimalInitTicks();
+void minimalAddEventPollTime(uint64_t ticks);
+
+void minimalRecordFrame(uint64_t time, uint64_t delta);
+void minimalRecordCapture(uint8_t capture);
+void minimalRecordEvent(const MinimalEvent* e, const void* data, size_t size);
+
+uint8_t minimalReplayFrame(uint64_t* time, uint64_t* delta);
+void minimalReplayEvents(MinimalWindow* window);
+
 /* --------------------------| context |--------------------------------- */
 void minimalSetCurrentContext(MinimalWindow* context);
 MinimalWindow* minimalGetCurrentContext();
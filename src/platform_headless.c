@@ -0,0 +1,379 @@
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "minimal.h"
+
+#ifdef MINIMAL_PLATFORM_HEADLESS
+
+#include <sys/eventfd.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef MINIMAL_NO_CONTEXT
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA   0x31DD
+#endif
+#endif
+
+static uint64_t _minimalTimerOffset = 0;
+
+/* signalled by minimalWakeWindow to interrupt minimalWaitWindowEvents */
+static int      _minimalWakeFd = -1;
+
+uint8_t minimalPlatformInit()
+{
+    // init time
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        MINIMAL_ERROR("[Platform] Monotonic clock is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalTimerOffset = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    minimalInitTicks();
+
+    _minimalWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_minimalWakeFd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create wakeup eventfd");
+        return MINIMAL_FAIL;
+    }
+
+#ifndef MINIMAL_NO_CONTEXT
+    // init egl without any windowing system
+    if (!minimalEGLInit(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+    if (_minimalWakeFd >= 0)
+    {
+        close(_minimalWakeFd);
+        _minimalWakeFd = -1;
+    }
+
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLTerminate();
+#endif
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+#ifndef MINIMAL_HEADLESS_QUEUE_SIZE
+#define MINIMAL_HEADLESS_QUEUE_SIZE 256
+#endif
+
+typedef struct
+{
+    uint32_t type;
+    uint32_t uParam;
+    int32_t lParam;
+    int32_t rParam;
+} MinimalInjectedEvent;
+
+struct MinimalWindow
+{
+#ifndef MINIMAL_NO_CONTEXT
+    MinimalEGLContext egl;
+#endif
+
+    uint32_t width;
+    uint32_t height;
+
+    uint8_t shouldClose;
+    uint32_t eventMask;
+
+    uint32_t* framebuffers[MINIMAL_FRAMEBUFFER_COUNT];
+    uint32_t framebufferIndex;
+
+    MinimalInjectedEvent queue[MINIMAL_HEADLESS_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t count;
+
+    MinimalWindow* next;
+};
+
+/* all open windows, there is no native handle to look them up by */
+static MinimalWindow* _minimalWindows = NULL;
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->width = w;
+    window->height = h;
+    window->shouldClose = 0;
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    window->next = _minimalWindows;
+    _minimalWindows = window;
+
+#ifndef MINIMAL_NO_CONTEXT
+
+    if (windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API)
+        return window;
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    // offscreen surface sized like the requested window
+    if (!minimalEGLCreateContext(&window->egl, NULL, w, h, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    for (MinimalWindow** it = &_minimalWindows; *it; it = &(*it)->next)
+    {
+        if (*it == window)
+        {
+            *it = window->next;
+            break;
+        }
+    }
+
+    minimalDestroyFramebuffer(window);
+    minimalResetMouseDelta(window);
+
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLDestroyContext(&window->egl);
+#endif
+
+    free(window);
+}
+
+uint8_t minimalInjectEvent(MinimalWindow* window, uint32_t type, uint32_t uParam, int32_t lParam, int32_t rParam)
+{
+    if (window->count >= MINIMAL_HEADLESS_QUEUE_SIZE)
+    {
+        MINIMAL_WARN("[Platform] Injected event queue is full");
+        return MINIMAL_FAIL;
+    }
+
+    uint32_t index = (window->head + window->count) % MINIMAL_HEADLESS_QUEUE_SIZE;
+    window->queue[index] = (MinimalInjectedEvent){ .type = type, .uParam = uParam, .lParam = lParam, .rParam = rParam };
+    window->count++;
+
+    return MINIMAL_OK;
+}
+
+static void minimalHeadlessProcessEvent(MinimalWindow* context, const MinimalInjectedEvent* e)
+{
+    // the size is tracked even while its event is disabled
+    if (e->type == MINIMAL_EVENT_WINDOW_SIZE)
+    {
+        context->width = (uint32_t)e->lParam;
+        context->height = (uint32_t)e->rParam;
+    }
+
+    if (e->type <= MINIMAL_EVENT_LAST && !MINIMAL_EVENT_ENABLED(context, e->type)) return;
+
+    switch (e->type)
+    {
+    case MINIMAL_EVENT_KEY:
+        if (minimalProcessKey((MinimalKeycode)e->uParam, (uint8_t)e->lParam))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    case MINIMAL_EVENT_MOUSE_BUTTON:
+    {
+        MinimalMouseButton button = (MinimalMouseButton)(e->uParam >> 16);
+        uint8_t action = (uint8_t)(e->uParam & 0xffff);
+
+        if (minimalProcessMouseButton(button, action))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    }
+    case MINIMAL_EVENT_MOUSE_MOVED:
+        if (minimalProcessMouseMove((float)e->lParam, (float)e->rParam))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    case MINIMAL_EVENT_MOUSE_RAW:
+        if (minimalProcessMouseRaw(e->lParam, e->rParam))
+            minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    default:
+        minimalDispatchWindowEvent(context, e->type, e->uParam, e->lParam, e->rParam);
+        return;
+    }
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    while (context->count)
+    {
+        MinimalInjectedEvent e = context->queue[context->head];
+        context->head = (context->head + 1) % MINIMAL_HEADLESS_QUEUE_SIZE;
+        context->count--;
+
+        minimalHeadlessProcessEvent(context, &e);
+    }
+
+    minimalFlushEvents();
+}
+
+void minimalPollAllEvents()
+{
+    for (MinimalWindow* window = _minimalWindows; window; window = window->next)
+        minimalPollWindowEvents(window);
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    // injected events are the only input, without them there is only the wakeup to wait for
+    if (!context->count)
+    {
+        int ms = -1;
+        if (timeout != MINIMAL_WAIT_INFINITE)
+        {
+            // rounded up so short waits do not turn into spins
+            uint64_t value = (timeout + 999999) / 1000000;
+            ms = value > INT_MAX ? INT_MAX : (int)value;
+        }
+
+        struct pollfd fd = { .fd = _minimalWakeFd, .events = POLLIN };
+        if (poll(&fd, 1, ms) > 0)
+        {
+            uint64_t value;
+            while (read(_minimalWakeFd, &value, sizeof(value)) > 0);
+        }
+    }
+
+    minimalPollWindowEvents(context);
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    // only fails if the counter is already full, which wakes the wait as well
+    uint64_t value = 1;
+    ssize_t result = write(_minimalWakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title) { }
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window) { }
+void minimalMinimize(MinimalWindow* window) { }
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock) { }
+
+uint64_t minimalGetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t value = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    return value - _minimalTimerOffset;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    if (xscale) *xscale = 1.0f;
+    if (yscale) *yscale = 1.0f;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return NULL;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return NULL;
+}
+
+/* --------------------------| framebuffer |----------------------------- */
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        window->framebuffers[i] = calloc((size_t)w * h, sizeof(uint32_t));
+        if (!window->framebuffers[i])
+        {
+            MINIMAL_ERROR("[Platform] Failed to allocate framebuffer");
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+    }
+
+    window->framebufferIndex = 0;
+    return window->framebuffers[0];
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        free(window->framebuffers[i]);
+        window->framebuffers[i] = NULL;
+    }
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    // nothing reads the buffers, presenting only flips them
+    window->framebufferIndex = (window->framebufferIndex + 1) % MINIMAL_FRAMEBUFFER_COUNT;
+    return window->framebuffers[window->framebufferIndex];
+}
+
+/* --------------------------| egl |------------------------------------- */
+#ifndef MINIMAL_NO_CONTEXT
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    // there is nothing to present, swapping a pbuffer has no effect
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    minimalEGLSwapInterval(interval);
+}
+
+#endif // !MINIMAL_NO_CONTEXT
+
+#endif // MINIMAL_PLATFORM_HEADLESS
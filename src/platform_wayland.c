@@ -0,0 +1,1193 @@
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "minimal.h"
+
+#ifdef MINIMAL_PLATFORM_WAYLAND
+
+#include <wayland-client.h>
+#include <xkbcommon/xkbcommon.h>
+
+/* generated with: wayland-scanner client-header xdg-shell.xml xdg-shell-client-protocol.h */
+#include "xdg-shell-client-protocol.h"
+
+/*
+ raw motion and pointer lock, only used if the compositor supports them but required to build:
+ wayland-scanner client-header relative-pointer-unstable-v1.xml relative-pointer-unstable-v1-client-protocol.h
+ wayland-scanner client-header pointer-constraints-unstable-v1.xml pointer-constraints-unstable-v1-client-protocol.h
+*/
+#include "relative-pointer-unstable-v1-client-protocol.h"
+#include "pointer-constraints-unstable-v1-client-protocol.h"
+
+#include <linux/input-event-codes.h>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef MINIMAL_NO_CONTEXT
+#include <wayland-egl.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_WAYLAND_KHR
+#define EGL_PLATFORM_WAYLAND_KHR    0x31D8
+#endif
+#endif
+
+/* upper bound for waiting on a frame callback, hidden surfaces never get one */
+#ifndef MINIMAL_WAYLAND_FRAME_TIMEOUT
+#define MINIMAL_WAYLAND_FRAME_TIMEOUT   100
+#endif
+
+/* buffers added on top of MINIMAL_FRAMEBUFFER_COUNT while the compositor holds on to all of them */
+#ifndef MINIMAL_WAYLAND_FRAMEBUFFER_MAX
+#define MINIMAL_WAYLAND_FRAMEBUFFER_MAX 4
+#endif
+
+static struct wl_display*       _minimalDisplay = NULL;
+static struct wl_registry*      _minimalRegistry = NULL;
+static struct wl_compositor*    _minimalCompositor = NULL;
+static struct xdg_wm_base*      _minimalWMBase = NULL;
+static struct wl_shm*           _minimalShm = NULL;
+static struct wl_seat*          _minimalSeat = NULL;
+static struct wl_keyboard*      _minimalKeyboard = NULL;
+static struct wl_pointer*       _minimalPointer = NULL;
+
+static struct zwp_relative_pointer_manager_v1*  _minimalRelativePointerManager = NULL;
+static struct zwp_relative_pointer_v1*          _minimalRelativePointer = NULL;
+static struct zwp_pointer_constraints_v1*       _minimalPointerConstraints = NULL;
+
+static struct xkb_context*      _minimalXkbContext = NULL;
+static struct xkb_keymap*       _minimalXkbKeymap = NULL;
+static struct xkb_state*        _minimalXkbState = NULL;
+
+/* windows that currently receive keyboard and pointer input */
+static MinimalWindow*           _minimalKeyboardFocus = NULL;
+static MinimalWindow*           _minimalPointerFocus = NULL;
+
+static uint32_t _minimalKeyMods = 0;
+static uint32_t _minimalPointerSerial = 0;
+static float    _minimalCursorX = 0.0f;
+static float    _minimalCursorY = 0.0f;
+
+/* scroll below one notch, carried over to the next axis event */
+static double   _minimalScrollX = 0.0;
+static double   _minimalScrollY = 0.0;
+
+static uint8_t  _minimalSwapInterval = 1;
+
+static uint64_t _minimalTimerOffset = 0;
+
+/* signalled by minimalWakeWindow to interrupt minimalWaitWindowEvents */
+static int      _minimalWakeFd = -1;
+
+static uint64_t minimalWaylandTimeMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* --------------------------| registry |-------------------------------- */
+static void minimalWMBasePing(void* data, struct xdg_wm_base* base, uint32_t serial)
+{
+    xdg_wm_base_pong(base, serial);
+}
+
+static const struct xdg_wm_base_listener _minimalWMBaseListener = {
+    .ping = minimalWMBasePing
+};
+
+static const struct wl_seat_listener _minimalSeatListener;
+
+static void minimalRegistryGlobal(void* data, struct wl_registry* registry, uint32_t name, const char* interface, uint32_t version)
+{
+    if (strcmp(interface, wl_compositor_interface.name) == 0)
+    {
+        _minimalCompositor = wl_registry_bind(registry, name, &wl_compositor_interface, 1);
+    }
+    else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
+    {
+        _minimalWMBase = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(_minimalWMBase, &_minimalWMBaseListener, NULL);
+    }
+    else if (strcmp(interface, wl_shm_interface.name) == 0)
+    {
+        _minimalShm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+    }
+    else if (strcmp(interface, wl_seat_interface.name) == 0 && !_minimalSeat)
+    {
+        _minimalSeat = wl_registry_bind(registry, name, &wl_seat_interface, version < 5 ? version : 5);
+        wl_seat_add_listener(_minimalSeat, &_minimalSeatListener, NULL);
+    }
+    else if (strcmp(interface, zwp_relative_pointer_manager_v1_interface.name) == 0)
+    {
+        _minimalRelativePointerManager = wl_registry_bind(registry, name, &zwp_relative_pointer_manager_v1_interface, 1);
+    }
+    else if (strcmp(interface, zwp_pointer_constraints_v1_interface.name) == 0)
+    {
+        _minimalPointerConstraints = wl_registry_bind(registry, name, &zwp_pointer_constraints_v1_interface, 1);
+    }
+}
+
+static void minimalRegistryGlobalRemove(void* data, struct wl_registry* registry, uint32_t name) { }
+
+static const struct wl_registry_listener _minimalRegistryListener = {
+    .global         = minimalRegistryGlobal,
+    .global_remove  = minimalRegistryGlobalRemove
+};
+
+uint8_t minimalPlatformInit()
+{
+    _minimalDisplay = wl_display_connect(NULL);
+    if (!_minimalDisplay)
+    {
+        MINIMAL_ERROR("[Platform] Failed to connect to Wayland display");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalXkbContext = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    if (!_minimalXkbContext)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create xkb context");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalRegistry = wl_display_get_registry(_minimalDisplay);
+    wl_registry_add_listener(_minimalRegistry, &_minimalRegistryListener, NULL);
+
+    // first roundtrip binds the globals, second one the seat capabilities
+    wl_display_roundtrip(_minimalDisplay);
+    wl_display_roundtrip(_minimalDisplay);
+
+    if (!_minimalCompositor || !_minimalWMBase)
+    {
+        MINIMAL_ERROR("[Platform] Compositor does not support xdg-shell");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_minimalWakeFd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create wakeup eventfd");
+        return MINIMAL_FAIL;
+    }
+
+    // init time
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        MINIMAL_ERROR("[Platform] Monotonic clock is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalTimerOffset = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    minimalInitTicks();
+
+#ifndef MINIMAL_NO_CONTEXT
+    // init egl
+    if (!minimalEGLInit(EGL_PLATFORM_WAYLAND_KHR, _minimalDisplay))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLTerminate();
+#endif
+
+    if (_minimalXkbState)   xkb_state_unref(_minimalXkbState);
+    if (_minimalXkbKeymap)  xkb_keymap_unref(_minimalXkbKeymap);
+    if (_minimalXkbContext) xkb_context_unref(_minimalXkbContext);
+
+    if (_minimalRelativePointer)        zwp_relative_pointer_v1_destroy(_minimalRelativePointer);
+    if (_minimalRelativePointerManager) zwp_relative_pointer_manager_v1_destroy(_minimalRelativePointerManager);
+    if (_minimalPointerConstraints)     zwp_pointer_constraints_v1_destroy(_minimalPointerConstraints);
+
+    if (_minimalKeyboard)   wl_keyboard_destroy(_minimalKeyboard);
+    if (_minimalPointer)    wl_pointer_destroy(_minimalPointer);
+    if (_minimalSeat)       wl_seat_destroy(_minimalSeat);
+    if (_minimalShm)        wl_shm_destroy(_minimalShm);
+    if (_minimalWMBase)     xdg_wm_base_destroy(_minimalWMBase);
+    if (_minimalCompositor) wl_compositor_destroy(_minimalCompositor);
+    if (_minimalRegistry)   wl_registry_destroy(_minimalRegistry);
+
+    if (_minimalWakeFd >= 0)
+    {
+        close(_minimalWakeFd);
+        _minimalWakeFd = -1;
+    }
+
+    if (_minimalDisplay)
+    {
+        wl_display_disconnect(_minimalDisplay);
+        _minimalDisplay = NULL;
+    }
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+typedef struct
+{
+    struct wl_buffer*   buffer;
+    uint32_t*           pixels;
+    size_t              size;
+    uint8_t             busy;
+} MinimalWaylandFramebuffer;
+
+struct MinimalWindow
+{
+    struct wl_surface*      surface;
+    struct xdg_surface*     xdgSurface;
+    struct xdg_toplevel*    xdgToplevel;
+
+    /* pending wl_surface.frame request of the last presented frame */
+    struct wl_callback*     frameCallback;
+
+#ifndef MINIMAL_NO_CONTEXT
+    struct wl_egl_window*   eglWindow;
+    MinimalEGLContext       egl;
+#endif
+
+    /* buffer releases are dispatched on their own queue, never together with input */
+    struct wl_event_queue*  framebufferQueue;
+    MinimalWaylandFramebuffer framebuffers[MINIMAL_WAYLAND_FRAMEBUFFER_MAX];
+    uint32_t    framebufferCount;
+    uint32_t    framebufferIndex;
+    uint32_t    framebufferWidth;
+    uint32_t    framebufferHeight;
+
+    uint32_t width;
+    uint32_t height;
+
+    uint8_t shouldClose;
+
+    uint32_t eventMask;
+
+    struct zwp_locked_pointer_v1* lockedPointer;
+};
+
+/* --------------------------| xdg shell |------------------------------- */
+static void minimalXdgSurfaceConfigure(void* data, struct xdg_surface* surface, uint32_t serial)
+{
+    xdg_surface_ack_configure(surface, serial);
+}
+
+static const struct xdg_surface_listener _minimalXdgSurfaceListener = {
+    .configure = minimalXdgSurfaceConfigure
+};
+
+static void minimalXdgToplevelConfigure(void* data, struct xdg_toplevel* toplevel, int32_t width, int32_t height, struct wl_array* states)
+{
+    MinimalWindow* window = data;
+
+    // zero means the client decides
+    if (width <= 0 || height <= 0) return;
+    if ((uint32_t)width == window->width && (uint32_t)height == window->height) return;
+
+    window->width = (uint32_t)width;
+    window->height = (uint32_t)height;
+
+#ifndef MINIMAL_NO_CONTEXT
+    if (window->eglWindow)
+        wl_egl_window_resize(window->eglWindow, width, height, 0, 0);
+#endif
+
+    if (MINIMAL_EVENT_ENABLED(window, MINIMAL_EVENT_WINDOW_SIZE))
+        minimalDispatchWindowEvent(window, MINIMAL_EVENT_WINDOW_SIZE, 0, width, height);
+}
+
+static void minimalXdgToplevelClose(void* data, struct xdg_toplevel* toplevel)
+{
+    minimalClose(data);
+}
+
+static const struct xdg_toplevel_listener _minimalXdgToplevelListener = {
+    .configure  = minimalXdgToplevelConfigure,
+    .close      = minimalXdgToplevelClose
+};
+
+static void minimalFrameDone(void* data, struct wl_callback* callback, uint32_t time)
+{
+    MinimalWindow* window = data;
+
+    wl_callback_destroy(callback);
+    if (window->frameCallback == callback)
+        window->frameCallback = NULL;
+}
+
+static const struct wl_callback_listener _minimalFrameListener = {
+    .done = minimalFrameDone
+};
+
+/* has to be called before the commit that presents the frame */
+static void minimalWaylandRequestFrame(MinimalWindow* window)
+{
+    if (!_minimalSwapInterval) return;
+
+    if (window->frameCallback) wl_callback_destroy(window->frameCallback);
+
+    window->frameCallback = wl_surface_frame(window->surface);
+    wl_callback_add_listener(window->frameCallback, &_minimalFrameListener, window);
+}
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->width = w;
+    window->height = h;
+    window->shouldClose = 0;
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    // create window, wayland does not let clients position toplevels
+    window->surface = wl_compositor_create_surface(_minimalCompositor);
+    if (!window->surface)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create surface");
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    wl_surface_set_user_data(window->surface, window);
+
+    window->xdgSurface = xdg_wm_base_get_xdg_surface(_minimalWMBase, window->surface);
+    xdg_surface_add_listener(window->xdgSurface, &_minimalXdgSurfaceListener, window);
+
+    window->xdgToplevel = xdg_surface_get_toplevel(window->xdgSurface);
+    xdg_toplevel_add_listener(window->xdgToplevel, &_minimalXdgToplevelListener, window);
+
+    minimalSetWindowTitle(window, title);
+
+    // the surface has to be configured before the first buffer is attached
+    wl_surface_commit(window->surface);
+    wl_display_roundtrip(_minimalDisplay);
+
+#ifndef MINIMAL_NO_CONTEXT
+
+    if (windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API)
+        return window;
+
+    window->eglWindow = wl_egl_window_create(window->surface, (int)window->width, (int)window->height);
+    if (!window->eglWindow)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create EGL window");
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    if (!minimalEGLCreateContext(&window->egl, window->eglWindow, window->width, window->height, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    // pacing is done with frame callbacks, eglSwapBuffers must never block
+    minimalEGLSwapInterval(0);
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    if (_minimalKeyboardFocus == window) _minimalKeyboardFocus = NULL;
+    if (_minimalPointerFocus == window)  _minimalPointerFocus = NULL;
+
+    minimalResetMouseDelta(window);
+
+    minimalDestroyFramebuffer(window);
+
+#ifndef MINIMAL_NO_CONTEXT
+    minimalEGLDestroyContext(&window->egl);
+
+    if (window->eglWindow) wl_egl_window_destroy(window->eglWindow);
+#endif
+
+    if (window->lockedPointer)  zwp_locked_pointer_v1_destroy(window->lockedPointer);
+    if (window->frameCallback)  wl_callback_destroy(window->frameCallback);
+    if (window->xdgToplevel)    xdg_toplevel_destroy(window->xdgToplevel);
+    if (window->xdgSurface)     xdg_surface_destroy(window->xdgSurface);
+    if (window->surface)        wl_surface_destroy(window->surface);
+
+    wl_display_flush(_minimalDisplay);
+
+    free(window);
+}
+
+/*
+ * Reads and dispatches events, blocking up to timeout milliseconds unless
+ * queued events were dispatched already. Writing to wakeFd ends the wait
+ * early, a negative fd is ignored by poll.
+ */
+static void minimalWaylandDispatch(int timeout, int wakeFd)
+{
+    while (wl_display_prepare_read(_minimalDisplay) != 0)
+    {
+        if (wl_display_dispatch_pending(_minimalDisplay) > 0)
+            timeout = 0;
+    }
+
+    wl_display_flush(_minimalDisplay);
+
+    struct pollfd fds[2] = {
+        { .fd = wl_display_get_fd(_minimalDisplay), .events = POLLIN },
+        { .fd = wakeFd, .events = POLLIN }
+    };
+
+    if (poll(fds, 2, timeout) > 0 && (fds[0].revents & POLLIN))
+        wl_display_read_events(_minimalDisplay);
+    else
+        wl_display_cancel_read(_minimalDisplay);
+
+    if (fds[1].revents & POLLIN)
+    {
+        uint64_t value;
+        while (read(wakeFd, &value, sizeof(value)) > 0);
+    }
+
+    wl_display_dispatch_pending(_minimalDisplay);
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    // all windows share one connection, listeners route events to their own window
+    minimalWaylandDispatch(0, -1);
+
+    // hold the next frame back until the compositor is ready to show it
+    uint64_t start = minimalWaylandTimeMs();
+    while (context->frameCallback && !context->shouldClose)
+    {
+        uint64_t elapsed = minimalWaylandTimeMs() - start;
+        if (elapsed >= MINIMAL_WAYLAND_FRAME_TIMEOUT) break;
+
+        minimalWaylandDispatch((int)(MINIMAL_WAYLAND_FRAME_TIMEOUT - elapsed), -1);
+    }
+
+    minimalFlushEvents();
+}
+
+void minimalPollAllEvents()
+{
+    minimalWaylandDispatch(0, -1);
+    minimalFlushEvents();
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    int ms = -1;
+    if (timeout != MINIMAL_WAIT_INFINITE)
+    {
+        // rounded up so short waits do not turn into spins
+        uint64_t value = (timeout + 999999) / 1000000;
+        ms = value > INT_MAX ? INT_MAX : (int)value;
+    }
+
+    minimalWaylandDispatch(ms, _minimalWakeFd);
+    minimalFlushEvents();
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    // only fails if the counter is already full, which wakes the wait as well
+    uint64_t value = 1;
+    ssize_t result = write(_minimalWakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+
+    if ((mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW)) && !_minimalRelativePointerManager)
+        MINIMAL_WARN("[Platform] Raw mouse motion needs zwp_relative_pointer_manager_v1");
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title)
+{
+    xdg_toplevel_set_title(context->xdgToplevel, title);
+}
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window) { xdg_toplevel_set_maximized(window->xdgToplevel); }
+void minimalMinimize(MinimalWindow* window) { xdg_toplevel_set_minimized(window->xdgToplevel); }
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock)
+{
+    if (!lock)
+    {
+        // there is no cursor theme to restore, the compositor picks the cursor once the pointer leaves
+        if (window->lockedPointer) zwp_locked_pointer_v1_destroy(window->lockedPointer);
+        window->lockedPointer = NULL;
+        return;
+    }
+
+    if (window->lockedPointer || !_minimalPointer) return;
+
+    if (!_minimalPointerConstraints)
+    {
+        MINIMAL_WARN("[Platform] Pointer lock needs zwp_pointer_constraints_v1");
+        return;
+    }
+
+    // stays active until it is destroyed, the compositor lifts it while the window is unfocused
+    window->lockedPointer = zwp_pointer_constraints_v1_lock_pointer(_minimalPointerConstraints, window->surface, _minimalPointer,
+                                                                    NULL, ZWP_POINTER_CONSTRAINTS_V1_LIFETIME_PERSISTENT);
+
+    if (_minimalPointerFocus == window)
+        wl_pointer_set_cursor(_minimalPointer, _minimalPointerSerial, NULL, 0, 0);
+}
+
+uint64_t minimalGetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t value = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    return value - _minimalTimerOffset;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    if (xscale) *xscale = 1.0f;
+    if (yscale) *yscale = 1.0f;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return window->surface;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return _minimalDisplay;
+}
+
+/* --------------------------| keyboard |-------------------------------- */
+/* linux evdev scancodes to MINIMAL_KEY_* */
+static const MinimalKeycode _minimalEvdevKeys[256] = {
+    [KEY_ESC]           = MINIMAL_KEY_ESCAPE,
+    [KEY_1]             = MINIMAL_KEY_1,
+    [KEY_2]             = MINIMAL_KEY_2,
+    [KEY_3]             = MINIMAL_KEY_3,
+    [KEY_4]             = MINIMAL_KEY_4,
+    [KEY_5]             = MINIMAL_KEY_5,
+    [KEY_6]             = MINIMAL_KEY_6,
+    [KEY_7]             = MINIMAL_KEY_7,
+    [KEY_8]             = MINIMAL_KEY_8,
+    [KEY_9]             = MINIMAL_KEY_9,
+    [KEY_0]             = MINIMAL_KEY_0,
+    [KEY_MINUS]         = MINIMAL_KEY_MINUS,
+    [KEY_EQUAL]         = MINIMAL_KEY_PLUS,
+    [KEY_BACKSPACE]     = MINIMAL_KEY_BACKSPACE,
+    [KEY_TAB]           = MINIMAL_KEY_TAB,
+    [KEY_Q]             = MINIMAL_KEY_Q,
+    [KEY_W]             = MINIMAL_KEY_W,
+    [KEY_E]             = MINIMAL_KEY_E,
+    [KEY_R]             = MINIMAL_KEY_R,
+    [KEY_T]             = MINIMAL_KEY_T,
+    [KEY_Y]             = MINIMAL_KEY_Y,
+    [KEY_U]             = MINIMAL_KEY_U,
+    [KEY_I]             = MINIMAL_KEY_I,
+    [KEY_O]             = MINIMAL_KEY_O,
+    [KEY_P]             = MINIMAL_KEY_P,
+    [KEY_ENTER]         = MINIMAL_KEY_ENTER,
+    [KEY_LEFTCTRL]      = MINIMAL_KEY_CONTROL,
+    [KEY_A]             = MINIMAL_KEY_A,
+    [KEY_S]             = MINIMAL_KEY_S,
+    [KEY_D]             = MINIMAL_KEY_D,
+    [KEY_F]             = MINIMAL_KEY_F,
+    [KEY_G]             = MINIMAL_KEY_G,
+    [KEY_H]             = MINIMAL_KEY_H,
+    [KEY_J]             = MINIMAL_KEY_J,
+    [KEY_K]             = MINIMAL_KEY_K,
+    [KEY_L]             = MINIMAL_KEY_L,
+    [KEY_SEMICOLON]     = MINIMAL_KEY_SEMICOLON,
+    [KEY_GRAVE]         = MINIMAL_KEY_GRAVE,
+    [KEY_LEFTSHIFT]     = MINIMAL_KEY_SHIFT,
+    [KEY_Z]             = MINIMAL_KEY_Z,
+    [KEY_X]             = MINIMAL_KEY_X,
+    [KEY_C]             = MINIMAL_KEY_C,
+    [KEY_V]             = MINIMAL_KEY_V,
+    [KEY_B]             = MINIMAL_KEY_B,
+    [KEY_N]             = MINIMAL_KEY_N,
+    [KEY_M]             = MINIMAL_KEY_M,
+    [KEY_COMMA]         = MINIMAL_KEY_COMMA,
+    [KEY_DOT]           = MINIMAL_KEY_PERIOD,
+    [KEY_SLASH]         = MINIMAL_KEY_SLASH,
+    [KEY_RIGHTSHIFT]    = MINIMAL_KEY_SHIFT,
+    [KEY_KPASTERISK]    = MINIMAL_KEY_MULTIPLY,
+    [KEY_LEFTALT]       = MINIMAL_KEY_ALT,
+    [KEY_SPACE]         = MINIMAL_KEY_SPACE,
+    [KEY_CAPSLOCK]      = MINIMAL_KEY_CAPITAL,
+    [KEY_F1]            = MINIMAL_KEY_F1,
+    [KEY_F2]            = MINIMAL_KEY_F2,
+    [KEY_F3]            = MINIMAL_KEY_F3,
+    [KEY_F4]            = MINIMAL_KEY_F4,
+    [KEY_F5]            = MINIMAL_KEY_F5,
+    [KEY_F6]            = MINIMAL_KEY_F6,
+    [KEY_F7]            = MINIMAL_KEY_F7,
+    [KEY_F8]            = MINIMAL_KEY_F8,
+    [KEY_F9]            = MINIMAL_KEY_F9,
+    [KEY_F10]           = MINIMAL_KEY_F10,
+    [KEY_NUMLOCK]       = MINIMAL_KEY_NUMLOCK,
+    [KEY_SCROLLLOCK]    = MINIMAL_KEY_SCROLL,
+    [KEY_KP7]           = MINIMAL_KEY_NUMPAD7,
+    [KEY_KP8]           = MINIMAL_KEY_NUMPAD8,
+    [KEY_KP9]           = MINIMAL_KEY_NUMPAD9,
+    [KEY_KPMINUS]       = MINIMAL_KEY_SUBTRACT,
+    [KEY_KP4]           = MINIMAL_KEY_NUMPAD4,
+    [KEY_KP5]           = MINIMAL_KEY_NUMPAD5,
+    [KEY_KP6]           = MINIMAL_KEY_NUMPAD6,
+    [KEY_KPPLUS]        = MINIMAL_KEY_ADD,
+    [KEY_KP1]           = MINIMAL_KEY_NUMPAD1,
+    [KEY_KP2]           = MINIMAL_KEY_NUMPAD2,
+    [KEY_KP3]           = MINIMAL_KEY_NUMPAD3,
+    [KEY_KP0]           = MINIMAL_KEY_NUMPAD0,
+    [KEY_KPDOT]         = MINIMAL_KEY_DECIMAL,
+    [KEY_F11]           = MINIMAL_KEY_F11,
+    [KEY_F12]           = MINIMAL_KEY_F12,
+    [KEY_HENKAN]        = MINIMAL_KEY_CONVERT,
+    [KEY_MUHENKAN]      = MINIMAL_KEY_NONCONVERT,
+    [KEY_KPENTER]       = MINIMAL_KEY_ENTER,
+    [KEY_RIGHTCTRL]     = MINIMAL_KEY_CONTROL,
+    [KEY_KPSLASH]       = MINIMAL_KEY_DIVIDE,
+    [KEY_SYSRQ]         = MINIMAL_KEY_SNAPSHOT,
+    [KEY_RIGHTALT]      = MINIMAL_KEY_ALT,
+    [KEY_HOME]          = MINIMAL_KEY_HOME,
+    [KEY_UP]            = MINIMAL_KEY_UP,
+    [KEY_PAGEUP]        = MINIMAL_KEY_PAGE_UP,
+    [KEY_LEFT]          = MINIMAL_KEY_LEFT,
+    [KEY_RIGHT]         = MINIMAL_KEY_RIGHT,
+    [KEY_END]           = MINIMAL_KEY_END,
+    [KEY_DOWN]          = MINIMAL_KEY_DOWN,
+    [KEY_PAGEDOWN]      = MINIMAL_KEY_PAGE_DOWN,
+    [KEY_INSERT]        = MINIMAL_KEY_INSERT,
+    [KEY_DELETE]        = MINIMAL_KEY_DELETE,
+    [KEY_KPEQUAL]       = MINIMAL_KEY_NUMPAD_EQUAL,
+    [KEY_PAUSE]         = MINIMAL_KEY_PAUSE,
+    [KEY_KPCOMMA]       = MINIMAL_KEY_SEPARATOR,
+    [KEY_LEFTMETA]      = MINIMAL_KEY_LCOMMAND,
+    [KEY_RIGHTMETA]     = MINIMAL_KEY_RCOMMAND,
+    [KEY_COMPOSE]       = MINIMAL_KEY_APPS,
+    [KEY_HELP]          = MINIMAL_KEY_HELP,
+    [KEY_SLEEP]         = MINIMAL_KEY_SLEEP,
+    [KEY_F13]           = MINIMAL_KEY_F13,
+    [KEY_F14]           = MINIMAL_KEY_F14,
+    [KEY_F15]           = MINIMAL_KEY_F15,
+    [KEY_F16]           = MINIMAL_KEY_F16,
+    [KEY_F17]           = MINIMAL_KEY_F17,
+    [KEY_F18]           = MINIMAL_KEY_F18,
+    [KEY_F19]           = MINIMAL_KEY_F19,
+    [KEY_F20]           = MINIMAL_KEY_F20,
+    [KEY_F21]           = MINIMAL_KEY_F21,
+    [KEY_F22]           = MINIMAL_KEY_F22,
+    [KEY_F23]           = MINIMAL_KEY_F23,
+    [KEY_F24]           = MINIMAL_KEY_F24,
+};
+
+static void minimalKeyboardKeymap(void* data, struct wl_keyboard* keyboard, uint32_t format, int32_t fd, uint32_t size)
+{
+    if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1)
+    {
+        close(fd);
+        return;
+    }
+
+    char* source = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (source == MAP_FAILED)
+    {
+        MINIMAL_ERROR("[Platform] Failed to map keymap");
+        return;
+    }
+
+    struct xkb_keymap* keymap = xkb_keymap_new_from_string(_minimalXkbContext, source, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    munmap(source, size);
+
+    if (!keymap)
+    {
+        MINIMAL_ERROR("[Platform] Failed to compile keymap");
+        return;
+    }
+
+    if (_minimalXkbState)   xkb_state_unref(_minimalXkbState);
+    if (_minimalXkbKeymap)  xkb_keymap_unref(_minimalXkbKeymap);
+
+    _minimalXkbKeymap = keymap;
+    _minimalXkbState = xkb_state_new(keymap);
+}
+
+static void minimalKeyboardEnter(void* data, struct wl_keyboard* keyboard, uint32_t serial, struct wl_surface* surface, struct wl_array* keys)
+{
+    // the surface is null if the client destroyed it in the meantime
+    _minimalKeyboardFocus = surface ? wl_surface_get_user_data(surface) : NULL;
+}
+
+static void minimalKeyboardLeave(void* data, struct wl_keyboard* keyboard, uint32_t serial, struct wl_surface* surface)
+{
+    _minimalKeyboardFocus = NULL;
+}
+
+static void minimalKeyboardKey(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t time, uint32_t key, uint32_t state)
+{
+    uint8_t action = state == WL_KEYBOARD_KEY_STATE_PRESSED;
+    uint8_t keys = MINIMAL_EVENT_ENABLED(_minimalKeyboardFocus, MINIMAL_EVENT_KEY);
+    uint8_t chars = action && MINIMAL_EVENT_ENABLED(_minimalKeyboardFocus, MINIMAL_EVENT_CHAR);
+    if (!keys && !chars) return;
+
+    MinimalKeycode keycode = key < 256 ? _minimalEvdevKeys[key] : 0;
+
+    minimalSetEventTime(minimalRebaseEventTime(time));
+
+    if (keys && minimalProcessKey(keycode, action))
+        minimalDispatchWindowEvent(_minimalKeyboardFocus, MINIMAL_EVENT_KEY, (uint32_t)keycode, action, _minimalKeyMods);
+
+    if (chars && _minimalXkbState)
+    {
+        // xkb keycodes are offset by 8 from evdev scancodes
+        uint32_t codepoint = xkb_state_key_get_utf32(_minimalXkbState, key + 8);
+        if (codepoint > 31)
+            minimalDispatchWindowEvent(_minimalKeyboardFocus, MINIMAL_EVENT_CHAR, codepoint, 0, _minimalKeyMods);
+    }
+
+    minimalSetEventTime(0);
+}
+
+static void minimalKeyboardModifiers(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t depressed, uint32_t latched, uint32_t locked, uint32_t group)
+{
+    if (!_minimalXkbState) return;
+
+    xkb_state_update_mask(_minimalXkbState, depressed, latched, locked, 0, 0, group);
+
+    uint32_t mods = 0;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_SHIFT, XKB_STATE_MODS_EFFECTIVE) > 0)  mods |= MINIMAL_KEY_MOD_SHIFT;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_CTRL, XKB_STATE_MODS_EFFECTIVE) > 0)   mods |= MINIMAL_KEY_MOD_CONTROL;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_ALT, XKB_STATE_MODS_EFFECTIVE) > 0)    mods |= MINIMAL_KEY_MOD_ALT;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_LOGO, XKB_STATE_MODS_EFFECTIVE) > 0)   mods |= MINIMAL_KEY_MOD_COMMAND;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_CAPS, XKB_STATE_MODS_EFFECTIVE) > 0)   mods |= MINIMAL_KEY_MOD_CAPS_LOCK;
+    if (xkb_state_mod_name_is_active(_minimalXkbState, XKB_MOD_NAME_NUM, XKB_STATE_MODS_EFFECTIVE) > 0)    mods |= MINIMAL_KEY_MOD_NUM_LOCK;
+    _minimalKeyMods = mods;
+}
+
+static void minimalKeyboardRepeatInfo(void* data, struct wl_keyboard* keyboard, int32_t rate, int32_t delay) { }
+
+static const struct wl_keyboard_listener _minimalKeyboardListener = {
+    .keymap         = minimalKeyboardKeymap,
+    .enter          = minimalKeyboardEnter,
+    .leave          = minimalKeyboardLeave,
+    .key            = minimalKeyboardKey,
+    .modifiers      = minimalKeyboardModifiers,
+    .repeat_info    = minimalKeyboardRepeatInfo
+};
+
+/* --------------------------| pointer |--------------------------------- */
+static MinimalMouseButton minimalWaylandGetMouseButton(uint32_t button)
+{
+    switch (button)
+    {
+    case BTN_LEFT:      return MINIMAL_MOUSE_BUTTON_LEFT;
+    case BTN_RIGHT:     return MINIMAL_MOUSE_BUTTON_RIGHT;
+    case BTN_MIDDLE:    return MINIMAL_MOUSE_BUTTON_MIDDLE;
+    case BTN_SIDE:      return MINIMAL_MOUSE_BUTTON_4;
+    case BTN_EXTRA:     return MINIMAL_MOUSE_BUTTON_5;
+    case BTN_FORWARD:   return MINIMAL_MOUSE_BUTTON_6;
+    case BTN_BACK:      return MINIMAL_MOUSE_BUTTON_7;
+    case BTN_TASK:      return MINIMAL_MOUSE_BUTTON_8;
+    default:            return MINIMAL_MOUSE_BUTTON_UNKNOWN;
+    }
+}
+
+static void minimalPointerMotion(void* data, struct wl_pointer* pointer, uint32_t time, wl_fixed_t sx, wl_fixed_t sy)
+{
+    if (!MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_MOVED)) return;
+
+    _minimalCursorX = (float)wl_fixed_to_double(sx);
+    _minimalCursorY = (float)wl_fixed_to_double(sy);
+
+    // enter events have no timestamp and pass zero
+    minimalSetEventTime(time ? minimalRebaseEventTime(time) : 0);
+
+    if (minimalProcessMouseMove(_minimalCursorX, _minimalCursorY))
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_MOVED, 0, (int32_t)_minimalCursorX, (int32_t)_minimalCursorY);
+
+    minimalSetEventTime(0);
+}
+
+static void minimalPointerEnter(void* data, struct wl_pointer* pointer, uint32_t serial, struct wl_surface* surface, wl_fixed_t sx, wl_fixed_t sy)
+{
+    _minimalPointerFocus = surface ? wl_surface_get_user_data(surface) : NULL;
+    _minimalPointerSerial = serial;
+
+    // the cursor of a surface is set with the serial of its enter event
+    if (_minimalPointerFocus && _minimalPointerFocus->lockedPointer)
+        wl_pointer_set_cursor(pointer, serial, NULL, 0, 0);
+
+    minimalPointerMotion(data, pointer, 0, sx, sy);
+}
+
+static void minimalPointerLeave(void* data, struct wl_pointer* pointer, uint32_t serial, struct wl_surface* surface)
+{
+    if (_minimalPointerFocus) minimalResetMouseDelta(_minimalPointerFocus);
+
+    _minimalPointerFocus = NULL;
+    _minimalScrollX = 0.0;
+    _minimalScrollY = 0.0;
+}
+
+static void minimalPointerButton(void* data, struct wl_pointer* pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state)
+{
+    if (!MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_BUTTON)) return;
+
+    uint32_t action = state == WL_POINTER_BUTTON_STATE_PRESSED;
+    MinimalMouseButton mb = minimalWaylandGetMouseButton(button);
+    int32_t x = (int32_t)_minimalCursorX;
+    int32_t y = (int32_t)_minimalCursorY;
+
+    minimalSetEventTime(minimalRebaseEventTime(time));
+
+    if (minimalProcessMouseButton(mb, action))
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_BUTTON, ((uint32_t)mb << 16) + action, x, y);
+
+    minimalSetEventTime(0);
+}
+
+static void minimalPointerAxis(void* data, struct wl_pointer* pointer, uint32_t time, uint32_t axis, wl_fixed_t value)
+{
+    if (!MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_SCROLLED)) return;
+
+    // one wheel notch is reported as 10, positive values scroll down and right
+    double* remainder = axis == WL_POINTER_AXIS_VERTICAL_SCROLL ? &_minimalScrollY : &_minimalScrollX;
+    *remainder += wl_fixed_to_double(value) / 10.0;
+
+    // touchpads report fractions of a notch, whole notches are sent and the rest is kept
+    int32_t notches = (int32_t)*remainder;
+    *remainder -= notches;
+    if (!notches) return;
+
+    minimalSetEventTime(minimalRebaseEventTime(time));
+
+    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, -notches);
+    else
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_SCROLLED, 0, notches, 0);
+
+    minimalSetEventTime(0);
+}
+
+static void minimalPointerFrame(void* data, struct wl_pointer* pointer) { }
+static void minimalPointerAxisSource(void* data, struct wl_pointer* pointer, uint32_t source) { }
+static void minimalPointerAxisStop(void* data, struct wl_pointer* pointer, uint32_t time, uint32_t axis) { }
+static void minimalPointerAxisDiscrete(void* data, struct wl_pointer* pointer, uint32_t axis, int32_t discrete) { }
+
+static const struct wl_pointer_listener _minimalPointerListener = {
+    .enter          = minimalPointerEnter,
+    .leave          = minimalPointerLeave,
+    .motion         = minimalPointerMotion,
+    .button         = minimalPointerButton,
+    .axis           = minimalPointerAxis,
+    .frame          = minimalPointerFrame,
+    .axis_source    = minimalPointerAxisSource,
+    .axis_stop      = minimalPointerAxisStop,
+    .axis_discrete  = minimalPointerAxisDiscrete
+};
+
+static void minimalRelativePointerMotion(void* data, struct zwp_relative_pointer_v1* pointer, uint32_t utimeHi, uint32_t utimeLo,
+                                         wl_fixed_t dx, wl_fixed_t dy, wl_fixed_t dxUnaccel, wl_fixed_t dyUnaccel)
+{
+    if (!_minimalPointerFocus || !MINIMAL_EVENT_ENABLED(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_RAW)) return;
+
+    // microseconds on the clock of the other input events, which report milliseconds
+    uint64_t utime = ((uint64_t)utimeHi << 32) | utimeLo;
+    minimalSetEventTime(minimalRebaseEventTime((uint32_t)(utime / 1000)));
+
+    // wl_fixed_t is 24.8 fixed point already
+    if (minimalProcessMouseRaw(dxUnaccel, dyUnaccel))
+        minimalDispatchWindowEvent(_minimalPointerFocus, MINIMAL_EVENT_MOUSE_RAW, 0, dxUnaccel, dyUnaccel);
+
+    minimalSetEventTime(0);
+}
+
+static const struct zwp_relative_pointer_v1_listener _minimalRelativePointerListener = {
+    .relative_motion = minimalRelativePointerMotion
+};
+
+/* --------------------------| seat |------------------------------------ */
+static void minimalSeatCapabilities(void* data, struct wl_seat* seat, uint32_t caps)
+{
+    if ((caps & WL_SEAT_CAPABILITY_KEYBOARD) && !_minimalKeyboard)
+    {
+        _minimalKeyboard = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(_minimalKeyboard, &_minimalKeyboardListener, NULL);
+    }
+    else if (!(caps & WL_SEAT_CAPABILITY_KEYBOARD) && _minimalKeyboard)
+    {
+        wl_keyboard_destroy(_minimalKeyboard);
+        _minimalKeyboard = NULL;
+    }
+
+    if ((caps & WL_SEAT_CAPABILITY_POINTER) && !_minimalPointer)
+    {
+        _minimalPointer = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(_minimalPointer, &_minimalPointerListener, NULL);
+
+        // the manager is bound by the first roundtrip, capabilities arrive with the second
+        if (_minimalRelativePointerManager)
+        {
+            _minimalRelativePointer = zwp_relative_pointer_manager_v1_get_relative_pointer(_minimalRelativePointerManager, _minimalPointer);
+            zwp_relative_pointer_v1_add_listener(_minimalRelativePointer, &_minimalRelativePointerListener, NULL);
+        }
+    }
+    else if (!(caps & WL_SEAT_CAPABILITY_POINTER) && _minimalPointer)
+    {
+        if (_minimalRelativePointer) zwp_relative_pointer_v1_destroy(_minimalRelativePointer);
+        _minimalRelativePointer = NULL;
+
+        wl_pointer_destroy(_minimalPointer);
+        _minimalPointer = NULL;
+    }
+}
+
+static void minimalSeatName(void* data, struct wl_seat* seat, const char* name) { }
+
+static const struct wl_seat_listener _minimalSeatListener = {
+    .capabilities   = minimalSeatCapabilities,
+    .name           = minimalSeatName
+};
+
+/* --------------------------| framebuffer |----------------------------- */
+static void minimalBufferRelease(void* data, struct wl_buffer* buffer)
+{
+    MinimalWaylandFramebuffer* fb = data;
+    fb->busy = 0;
+}
+
+static const struct wl_buffer_listener _minimalBufferListener = {
+    .release = minimalBufferRelease
+};
+
+/* anonymous shared memory file, unlinked right away */
+static int minimalWaylandCreateShmFile(size_t size)
+{
+    static uint32_t counter = 0;
+
+    char name[64];
+    snprintf(name, sizeof(name), "/minimal-%d-%u", (int)getpid(), counter++);
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) return -1;
+
+    shm_unlink(name);
+
+    if (ftruncate(fd, (off_t)size) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static uint8_t minimalWaylandCreateBuffer(MinimalWindow* window, MinimalWaylandFramebuffer* fb)
+{
+    int32_t stride = (int32_t)window->framebufferWidth * 4;
+    size_t size = (size_t)stride * window->framebufferHeight;
+
+    int fd = minimalWaylandCreateShmFile(size);
+    if (fd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create shared memory file");
+        return MINIMAL_FAIL;
+    }
+
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED)
+    {
+        MINIMAL_ERROR("[Platform] Failed to map shared memory");
+        close(fd);
+        return MINIMAL_FAIL;
+    }
+
+    struct wl_shm_pool* pool = wl_shm_create_pool(_minimalShm, fd, (int32_t)size);
+    fb->buffer = wl_shm_pool_create_buffer(pool, 0, (int32_t)window->framebufferWidth, (int32_t)window->framebufferHeight, stride, WL_SHM_FORMAT_XRGB8888);
+    fb->pixels = memory;
+    fb->size = size;
+    fb->busy = 0;
+
+    wl_proxy_set_queue((struct wl_proxy*)fb->buffer, window->framebufferQueue);
+    wl_buffer_add_listener(fb->buffer, &_minimalBufferListener, fb);
+
+    wl_shm_pool_destroy(pool);
+    close(fd);
+
+    return MINIMAL_OK;
+}
+
+/* reads events into their queues and dispatches only the ones of queue */
+static void minimalWaylandDispatchQueue(struct wl_event_queue* queue, int timeout)
+{
+    while (wl_display_prepare_read_queue(_minimalDisplay, queue) != 0)
+    {
+        if (wl_display_dispatch_queue_pending(_minimalDisplay, queue) > 0)
+            timeout = 0;
+    }
+
+    wl_display_flush(_minimalDisplay);
+
+    struct pollfd fd = { .fd = wl_display_get_fd(_minimalDisplay), .events = POLLIN };
+    if (poll(&fd, 1, timeout) > 0 && (fd.revents & POLLIN))
+        wl_display_read_events(_minimalDisplay);
+    else
+        wl_display_cancel_read(_minimalDisplay);
+
+    wl_display_dispatch_queue_pending(_minimalDisplay, queue);
+}
+
+static MinimalWaylandFramebuffer* minimalWaylandFreeFramebuffer(MinimalWindow* window)
+{
+    for (uint32_t i = 1; i <= window->framebufferCount; ++i)
+    {
+        uint32_t index = (window->framebufferIndex + i) % window->framebufferCount;
+        if (!window->framebuffers[index].busy)
+        {
+            window->framebufferIndex = index;
+            return &window->framebuffers[index];
+        }
+    }
+    return NULL;
+}
+
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    if (!_minimalShm)
+    {
+        MINIMAL_ERROR("[Platform] Compositor does not support wl_shm");
+        return NULL;
+    }
+
+    window->framebufferQueue = wl_display_create_queue(_minimalDisplay);
+    window->framebufferWidth = w;
+    window->framebufferHeight = h;
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        if (!minimalWaylandCreateBuffer(window, &window->framebuffers[i]))
+        {
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+        window->framebufferCount++;
+    }
+
+    window->framebufferIndex = 0;
+    return window->framebuffers[0].pixels;
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (uint32_t i = 0; i < window->framebufferCount; ++i)
+    {
+        wl_buffer_destroy(window->framebuffers[i].buffer);
+        munmap(window->framebuffers[i].pixels, window->framebuffers[i].size);
+    }
+    memset(window->framebuffers, 0, sizeof(window->framebuffers));
+    window->framebufferCount = 0;
+    window->framebufferIndex = 0;
+
+    if (window->framebufferQueue)
+        wl_event_queue_destroy(window->framebufferQueue);
+
+    window->framebufferQueue = NULL;
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    if (!window->framebufferCount) return NULL;
+
+    MinimalWaylandFramebuffer* current = &window->framebuffers[window->framebufferIndex];
+
+    minimalWaylandRequestFrame(window);
+
+    wl_surface_attach(window->surface, current->buffer, 0, 0);
+    wl_surface_damage(window->surface, 0, 0, INT32_MAX, INT32_MAX);
+    wl_surface_commit(window->surface);
+    current->busy = 1;
+
+    // pick up releases without blocking, input stays queued for the next poll
+    minimalWaylandDispatchQueue(window->framebufferQueue, 0);
+    MinimalWaylandFramebuffer* next = minimalWaylandFreeFramebuffer(window);
+
+    // the compositor still reads from every buffer, draw into a new one instead
+    if (!next && window->framebufferCount < MINIMAL_WAYLAND_FRAMEBUFFER_MAX)
+    {
+        next = &window->framebuffers[window->framebufferCount];
+        if (!minimalWaylandCreateBuffer(window, next)) return NULL;
+
+        window->framebufferIndex = window->framebufferCount++;
+    }
+
+    // a busy buffer is never handed out, wait for the compositor to release one
+    while (!next && !window->shouldClose)
+    {
+        if (wl_display_get_error(_minimalDisplay)) return NULL;
+
+        minimalWaylandDispatchQueue(window->framebufferQueue, MINIMAL_WAYLAND_FRAME_TIMEOUT);
+        next = minimalWaylandFreeFramebuffer(window);
+    }
+
+    return next ? next->pixels : NULL;
+}
+
+/* --------------------------| egl |------------------------------------- */
+#ifndef MINIMAL_NO_CONTEXT
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    // request the next frame before the swap commits the surface
+    minimalWaylandRequestFrame(context);
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    _minimalSwapInterval = interval;
+}
+
+#endif // !MINIMAL_NO_CONTEXT
+
+#endif // MINIMAL_PLATFORM_WAYLAND
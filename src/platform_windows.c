@@ -9,12 +9,16 @@
 
 #define MINIMAL_WNDCLASSNAME L"MINIMALWNDCLASS"
 
+#if !defined(MINIMAL_NO_CONTEXT) && !defined(MINIMAL_CONTEXT_EGL)
+#define MINIMAL_CONTEXT_WGL
+#endif
+
 static uint64_t _minimalTimerFrequency = 0;
 static uint64_t _minimalTimerOffset = 0;
 
 static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
-#ifndef MINIMAL_NO_CONTEXT
+#ifdef MINIMAL_CONTEXT_WGL
 
 static uint8_t minimalWGLInit();
 static void minimalWGLTerminate();
@@ -51,12 +55,13 @@ uint8_t minimalPlatformInit()
     }
 
     QueryPerformanceCounter((LARGE_INTEGER*)&_minimalTimerOffset);
+    minimalInitTicks();
 
-#ifndef MINIMAL_NO_CONTEXT
-    // init wgl
-    if (!minimalWGLInit())
+#if defined(MINIMAL_CONTEXT_EGL)
+    // init egl
+    if (!minimalEGLInit(0, EGL_DEFAULT_DISPLAY))
     {
-        MINIMAL_ERROR("[Platform] Failed to initialize WGL");
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
         return MINIMAL_FAIL;
     }
 #endif
@@ -66,8 +71,10 @@ uint8_t minimalPlatformInit()
 
 uint8_t minimalPlatformTerminate()
 {
-#ifndef MINIMAL_NO_CONTEXT
+#ifdef MINIMAL_CONTEXT_WGL
     minimalWGLTerminate();
+#elif defined(MINIMAL_CONTEXT_EGL)
+    minimalEGLTerminate();
 #endif
 
     // unregister window class
@@ -87,23 +94,51 @@ void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
         windowHints[name] = value;
 }
 
+typedef struct
+{
+    HBITMAP     bitmap;
+    uint32_t*   pixels;
+} MinimalWin32Framebuffer;
+
 struct MinimalWindow
 {
     HWND handle;
 
-#ifndef MINIMAL_NO_CONTEXT
+    HDC         framebufferDC;
+    MinimalWin32Framebuffer framebuffers[MINIMAL_FRAMEBUFFER_COUNT];
+    uint32_t    framebufferWidth;
+    uint32_t    framebufferHeight;
+    uint32_t    framebufferIndex;
+
+    uint32_t width;
+    uint32_t height;
+
+#ifdef MINIMAL_CONTEXT_WGL
     HDC         deviceContext;
     HGLRC       renderContext;
+#elif defined(MINIMAL_CONTEXT_EGL)
+    MinimalEGLContext egl;
 #endif
 
     uint8_t shouldClose;
+    uint8_t pointerLocked;
+    uint8_t cursorTracked;
+
+    uint32_t eventMask;
 };
 
+/* raw mouse input is registered for one window per process, the last one enabling it */
+static MinimalWindow* _minimalRawWindow = NULL;
+
 MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
 {
-    MinimalWindow* window = malloc(sizeof(MinimalWindow));
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
     if (!window) return NULL;
 
+    window->width = w;
+    window->height = h;
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
     // create window
     HINSTANCE instance = GetModuleHandleW(NULL);
 
@@ -117,7 +152,8 @@ MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint
     w += rect.right - rect.left;
     h += rect.bottom - rect.top;
 
-    window->handle = CreateWindowExW(styleEx, MINIMAL_WNDCLASSNAME, NULL, style, x, y, w, h, 0, 0, instance, 0);
+    // the window pointer is stored in GWLP_USERDATA on WM_NCCREATE
+    window->handle = CreateWindowExW(styleEx, MINIMAL_WNDCLASSNAME, NULL, style, x, y, w, h, 0, 0, instance, window);
     if (!window->handle)
     {
         MINIMAL_ERROR("[Platform] Failed to create window");
@@ -130,6 +166,11 @@ MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint
     window->shouldClose = 0;
 
 #ifndef MINIMAL_NO_CONTEXT
+    if (windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API)
+        return window;
+#endif
+
+#ifdef MINIMAL_CONTEXT_WGL
 
     window->deviceContext = GetDC(window->handle);
     window->renderContext = minimalCreateRenderContext(window->deviceContext);
@@ -139,6 +180,17 @@ MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint
         return NULL;
     }
 
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    if (!minimalEGLCreateContext(&window->egl, window->handle, window->width, window->height, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
 #endif
 
     return window;
@@ -146,7 +198,17 @@ MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint
 
 void minimalDestroyWindow(MinimalWindow* window)
 {
-#ifndef MINIMAL_NO_CONTEXT
+    minimalDestroyFramebuffer(window);
+
+    if (_minimalRawWindow == window)
+        minimalSetEventMask(window, window->eventMask & ~MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW));
+
+    if (window->pointerLocked)
+        minimalSetPointerLock(window, 0);
+
+    minimalResetMouseDelta(window);
+
+#ifdef MINIMAL_CONTEXT_WGL
 
     // destroy render context
     if (window->renderContext)
@@ -168,6 +230,10 @@ void minimalDestroyWindow(MinimalWindow* window)
         MINIMAL_ERROR("[Platform] Failed to release device context");
     }
 
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    minimalEGLDestroyContext(&window->egl);
+
 #endif
 
     // destroy window
@@ -179,14 +245,82 @@ void minimalDestroyWindow(MinimalWindow* window)
     free(window);
 }
 
+static void minimalWindowsDispatchMessage(const MSG* msg)
+{
+    // char messages are only generated for windows that want them
+    MinimalWindow* window = (MinimalWindow*)GetWindowLongPtrW(msg->hwnd, GWLP_USERDATA);
+    if (MINIMAL_EVENT_ENABLED(window, MINIMAL_EVENT_CHAR))
+        TranslateMessage(msg);
+
+    DispatchMessageW(msg);
+}
+
 void minimalPollWindowEvents(MinimalWindow* context)
 {
     MSG msg;
     while (PeekMessageW(&msg, context->handle, 0, 0, PM_REMOVE))
+        minimalWindowsDispatchMessage(&msg);
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+void minimalPollAllEvents()
+{
+    // a single queue holds the messages of all windows of the thread
+    MSG msg;
+    while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE))
+        minimalWindowsDispatchMessage(&msg);
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    DWORD ms = INFINITE;
+    if (timeout != MINIMAL_WAIT_INFINITE)
     {
-        TranslateMessage(&msg);
-        DispatchMessageW(&msg);
+        // rounded up so short waits do not turn into spins
+        uint64_t value = (timeout + 999999) / 1000000;
+        ms = value >= INFINITE ? INFINITE - 1 : (DWORD)value;
+    }
+
+    // MWMO_INPUTAVAILABLE also returns for input that was seen but not removed by an earlier peek
+    MsgWaitForMultipleObjectsEx(0, NULL, ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+
+    // the wait returns for messages of any window on the thread, leaving them
+    // queued would end every following wait right away
+    minimalPollAllEvents();
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    PostMessageW(window->handle, WM_NULL, 0, 0);
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+
+    uint8_t raw = (mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW)) != 0;
+    if (raw == (_minimalRawWindow == window)) return;
+
+    // generic desktop page, mouse usage
+    RAWINPUTDEVICE device = {
+        .usUsagePage    = 0x01,
+        .usUsage        = 0x02,
+        .dwFlags        = raw ? 0 : RIDEV_REMOVE,
+        .hwndTarget     = raw ? window->handle : NULL
+    };
+
+    if (!RegisterRawInputDevices(&device, 1, sizeof(device)))
+    {
+        MINIMAL_ERROR("[Platform] Failed to register raw mouse input");
+        return;
     }
+
+    _minimalRawWindow = raw ? window : NULL;
 }
 
 void minimalSetWindowTitle(MinimalWindow* context, const char* title)
@@ -201,22 +335,46 @@ void    minimalClose(MinimalWindow* context)             { context->shouldClose
 void minimalMaximize(MinimalWindow* window) { ShowWindow(window->handle, SW_SHOWMAXIMIZED); }
 void minimalMinimize(MinimalWindow* window) { ShowWindow(window->handle, SW_MINIMIZE); }
 
-double minimalGetTime()
+static void minimalWindowsClipCursor(MinimalWindow* window)
+{
+    RECT rect;
+    GetClientRect(window->handle, &rect);
+    MapWindowPoints(window->handle, NULL, (POINT*)&rect, 2);
+    ClipCursor(&rect);
+}
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock)
+{
+    window->pointerLocked = lock;
+
+    if (lock)
+    {
+        minimalWindowsClipCursor(window);
+        SetCursor(NULL);
+    }
+    else
+    {
+        ClipCursor(NULL);
+        SetCursor(LoadCursorW(NULL, IDC_ARROW));
+    }
+}
+
+uint64_t minimalGetTimeNs()
 {
     uint64_t value;
     QueryPerformanceCounter((LARGE_INTEGER*)&value);
+    value -= _minimalTimerOffset;
 
-    return (double)(value - _minimalTimerOffset) / _minimalTimerFrequency;
+    // split the division so the multiplication can not overflow
+    uint64_t seconds = value / _minimalTimerFrequency;
+    uint64_t remainder = value % _minimalTimerFrequency;
+    return seconds * 1000000000 + remainder * 1000000000 / _minimalTimerFrequency;
 }
 
 void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
 {
-    RECT rect;
-    if (GetClientRect(context->handle, &rect))
-    {
-        if (w) *w = rect.right - rect.left;
-        if (h) *h = rect.bottom - rect.top;
-    }
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
 }
 
 void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
@@ -235,6 +393,11 @@ void* minimalGetNativeWindowHandle(const MinimalWindow* window)
     return window->handle;
 }
 
+void* minimalGetNativeDisplayHandle()
+{
+    return GetModuleHandleW(NULL);
+}
+
 
 static uint32_t minimalGetKeyMods()
 {
@@ -264,14 +427,25 @@ static uint32_t minimalGetMouseButton(UINT msg, WPARAM wParam)
 
 static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
-    MinimalWindow* context = minimalGetCurrentContext();
+    if (msg == WM_NCCREATE)
+    {
+        CREATESTRUCTW* cs = (CREATESTRUCTW*)lParam;
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, (LONG_PTR)cs->lpCreateParams);
+    }
+
+    // windows not created by minimalCreateWindow (e.g. the wgl helper) have no user data
+    MinimalWindow* context = (MinimalWindow*)GetWindowLongPtrW(hwnd, GWLP_USERDATA);
 
     if (!context) return DefWindowProcW(hwnd, msg, wParam, lParam);
 
+    // the message time is only meaningful for input pulled from the queue
+    uint8_t input = (msg >= WM_KEYFIRST && msg <= WM_KEYLAST) || (msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST) || msg == WM_INPUT;
+    minimalSetEventTime(input ? minimalRebaseEventTime((uint32_t)GetMessageTime()) : 0);
+
     switch (msg)
     {
     case WM_DESTROY:
-        PostQuitMessage(0);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0);
         return 0;
     case WM_QUIT:
     case WM_CLOSE:
@@ -281,11 +455,13 @@ static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPar
     case WM_SYSCHAR:
     case WM_UNICHAR:
     {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_CHAR)) return 0;
+
         uint32_t codepoint = (uint32_t)wParam;
         uint32_t mods = minimalGetKeyMods();
 
         if (codepoint > 31)
-            minimalDispatchEvent(MINIMAL_EVENT_CHAR, codepoint, 0, mods);
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_CHAR, codepoint, 0, mods);
 
         return 0;
     }
@@ -294,12 +470,14 @@ static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPar
     case WM_KEYUP:
     case WM_SYSKEYUP:
     {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_KEY)) return 0;
+
         uint8_t action = (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN);
         uint32_t keycode = (uint16_t)wParam;
         uint32_t mods = minimalGetKeyMods();
 
         if (minimalProcessKey(keycode, action))
-            minimalDispatchEvent(MINIMAL_EVENT_KEY, keycode, action, mods);
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_KEY, keycode, action, mods);
 
         return 0;
     }
@@ -312,6 +490,9 @@ static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPar
     case WM_MBUTTONUP:
     case WM_XBUTTONUP:
     {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_BUTTON))
+            return msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP;
+
         uint32_t action = msg == WM_LBUTTONDOWN
                         || msg == WM_RBUTTONDOWN
                         || msg == WM_MBUTTONDOWN
@@ -322,31 +503,91 @@ static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPar
         int32_t y = MINIMAL_GET_Y_LPARAM(lParam);
 
         if (minimalProcessMouseButton(button, action))
-            minimalDispatchEvent(MINIMAL_EVENT_MOUSE_BUTTON, (button << 16) + action, x, y);
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_BUTTON, (button << 16) + action, x, y);
 
         return msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP;
     }
     case WM_MOUSEMOVE:
     {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_MOVED)) return 0;
+
+        // windows only reports the cursor leaving when asked to after it entered
+        if (!context->cursorTracked)
+        {
+            TRACKMOUSEEVENT track = { .cbSize = sizeof(track), .dwFlags = TME_LEAVE, .hwndTrack = hwnd };
+            context->cursorTracked = TrackMouseEvent(&track) != 0;
+        }
+
         int32_t x = MINIMAL_GET_X_LPARAM(lParam);
         int32_t y = MINIMAL_GET_Y_LPARAM(lParam);
 
         if (minimalProcessMouseMove((float)x, (float)y))
-            minimalDispatchEvent(MINIMAL_EVENT_MOUSE_MOVED, 0, x, y);
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_MOVED, 0, x, y);
+        return 0;
+    }
+    case WM_MOUSELEAVE:
+    {
+        context->cursorTracked = 0;
+        minimalResetMouseDelta(context);
         return 0;
     }
+    case WM_INPUT:
+    {
+        RAWINPUT raw;
+        UINT size = sizeof(raw);
+
+        if (MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_RAW)
+            && GetRawInputData((HRAWINPUT)lParam, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) != (UINT)-1
+            && raw.header.dwType == RIM_TYPEMOUSE && !(raw.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE))
+        {
+            int32_t x = (int32_t)raw.data.mouse.lLastX * MINIMAL_MOUSE_RAW_ONE;
+            int32_t y = (int32_t)raw.data.mouse.lLastY * MINIMAL_MOUSE_RAW_ONE;
+
+            if (minimalProcessMouseRaw(x, y))
+                minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_RAW, 0, x, y);
+        }
+
+        // the raw input buffer is released by the default procedure
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_SETCURSOR:
+    {
+        if (context->pointerLocked && LOWORD(lParam) == HTCLIENT)
+        {
+            SetCursor(NULL);
+            return TRUE;
+        }
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_SETFOCUS:
+    case WM_MOVE:
+    {
+        // the clip rectangle is in screen coordinates and does not survive focus changes
+        if (context->pointerLocked && GetFocus() == hwnd)
+            minimalWindowsClipCursor(context);
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+    case WM_KILLFOCUS:
+    {
+        if (context->pointerLocked) ClipCursor(NULL);
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
     case WM_MOUSEWHEEL:
     {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
+
         int32_t scroll = MINIMAL_GET_SCROLL(wParam);
 
-        minimalDispatchEvent(MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, scroll);
+        minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, scroll);
         return 0;
     }
     case WM_MOUSEHWHEEL:
     {
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_SCROLLED)) return 0;
+
         int32_t scroll = MINIMAL_GET_SCROLL(wParam);
 
-        minimalDispatchEvent(MINIMAL_EVENT_MOUSE_SCROLLED, 0, scroll, 0);
+        minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, scroll, 0);
         return 0;
     }
     case WM_SIZE:
@@ -371,15 +612,99 @@ static LRESULT minimalWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPar
         int32_t width  = LOWORD(lParam);
         int32_t height = HIWORD(lParam);
 
-        minimalDispatchEvent(MINIMAL_EVENT_WINDOW_SIZE, 0, width, height);
+        context->width = (uint32_t)width;
+        context->height = (uint32_t)height;
+
+        if (context->pointerLocked && GetFocus() == hwnd)
+            minimalWindowsClipCursor(context);
+
+        if (MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_WINDOW_SIZE))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_WINDOW_SIZE, 0, width, height);
         return 0;
     }
     default: return DefWindowProcW(hwnd, msg, wParam, lParam);
     }
 }
 
+/* --------------------------| framebuffer |----------------------------- */
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    // negative height for a top-down dib
+    BITMAPINFO bmi = { 0 };
+    bmi.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth       = (LONG)w;
+    bmi.bmiHeader.biHeight      = -(LONG)h;
+    bmi.bmiHeader.biPlanes      = 1;
+    bmi.bmiHeader.biBitCount    = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    window->framebufferDC = CreateCompatibleDC(NULL);
+    if (!window->framebufferDC)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create framebuffer device context");
+        return NULL;
+    }
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        MinimalWin32Framebuffer* fb = &window->framebuffers[i];
+        fb->bitmap = CreateDIBSection(window->framebufferDC, &bmi, DIB_RGB_COLORS, (void**)&fb->pixels, NULL, 0);
+        if (!fb->bitmap)
+        {
+            MINIMAL_ERROR("[Platform] Failed to create framebuffer");
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+    }
+
+    window->framebufferWidth = w;
+    window->framebufferHeight = h;
+    window->framebufferIndex = 0;
+
+    return window->framebuffers[0].pixels;
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+    {
+        if (window->framebuffers[i].bitmap)
+            DeleteObject(window->framebuffers[i].bitmap);
+    }
+    memset(window->framebuffers, 0, sizeof(window->framebuffers));
+
+    if (window->framebufferDC)
+    {
+        DeleteDC(window->framebufferDC);
+        window->framebufferDC = NULL;
+    }
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    MinimalWin32Framebuffer* current = &window->framebuffers[window->framebufferIndex];
+    if (!current->bitmap) return NULL;
+
+    // gdi has no shared memory present, blitting the dib section is the one copy left
+    HDC dc = GetDC(window->handle);
+    HGDIOBJ previous = SelectObject(window->framebufferDC, current->bitmap);
+
+    BitBlt(dc, 0, 0, (int)window->framebufferWidth, (int)window->framebufferHeight, window->framebufferDC, 0, 0, SRCCOPY);
+
+    SelectObject(window->framebufferDC, previous);
+    ReleaseDC(window->handle, dc);
+
+    // make sure gdi is done with the bitmap before it is written again
+    GdiFlush();
+
+    window->framebufferIndex = (window->framebufferIndex + 1) % MINIMAL_FRAMEBUFFER_COUNT;
+    return window->framebuffers[window->framebufferIndex].pixels;
+}
+
 /* --------------------------| wgl |------------------------------------- */
-#ifndef MINIMAL_NO_CONTEXT
+#ifdef MINIMAL_CONTEXT_WGL
 
 /* Accepted as an attribute name in <*attribList> */
 #define WGL_CONTEXT_MAJOR_VERSION_ARB               0x2091
@@ -418,30 +743,11 @@ static wglSwapIntervalEXT_T         _wglSwapIntervalEXT = NULL;
 static wglChoosePixelFormatARB_T    _wglChoosePixelFormatARB = NULL;
 
 static HMODULE glModule = NULL;
+static uint8_t _wglInitialized = 0;
 
-uint8_t minimalWGLInit()
+/* loads the wgl extensions through a dummy context, which is deleted again */
+static uint8_t minimalWGLLoadExtensions(HWND helperWnd)
 {
-    // load opengl library
-    glModule = LoadLibraryA("opengl32.dll");
-    if (!glModule)
-    {
-        MINIMAL_ERROR("[WGL] Failed to load opengl32.dll");
-        return MINIMAL_FAIL;
-    }
-
-    // create helper window
-    HINSTANCE instance = GetModuleHandleW(NULL);
-    LPCWSTR className = MINIMAL_WNDCLASSNAME;
-    DWORD exStyle = WS_EX_OVERLAPPEDWINDOW;
-    DWORD style = WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
-    HWND helperWnd = CreateWindowExW(exStyle, className, NULL, style, 0, 0, 1, 1, 0, 0, instance, 0);
-
-    if (!helperWnd)
-    {
-        MINIMAL_ERROR("[WGL] Failed to create helper window");
-        return MINIMAL_FAIL;
-    }
-
     MSG msg;
     while (PeekMessageW(&msg, helperWnd, 0, 0, PM_REMOVE))
     {
@@ -462,6 +768,7 @@ uint8_t minimalWGLInit()
     if (!SetPixelFormat(dc, ChoosePixelFormat(dc, &pfd), &pfd))
     {
         MINIMAL_ERROR("[WGL] Failed to set pixel format for dummy context");
+        ReleaseDC(helperWnd, dc);
         return MINIMAL_FAIL;
     }
 
@@ -469,6 +776,7 @@ uint8_t minimalWGLInit()
     if (!rc)
     {
         MINIMAL_ERROR("[WGL] Failed to create dummy context");
+        ReleaseDC(helperWnd, dc);
         return MINIMAL_FAIL;
     }
 
@@ -480,6 +788,7 @@ uint8_t minimalWGLInit()
         MINIMAL_ERROR("[WGL] Failed to make dummy context current");
         wglMakeCurrent(pdc, prc);
         wglDeleteContext(rc);
+        ReleaseDC(helperWnd, dc);
         return MINIMAL_FAIL;
     }
 
@@ -489,14 +798,56 @@ uint8_t minimalWGLInit()
 
     wglMakeCurrent(pdc, prc);
     wglDeleteContext(rc);
+    ReleaseDC(helperWnd, dc);
+
+    // render contexts are only created through the arb extensions
+    if (!_wglCreateContextAttrARB || !_wglChoosePixelFormatARB)
+    {
+        MINIMAL_ERROR("[WGL] Driver does not support WGL_ARB_create_context and WGL_ARB_pixel_format");
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalWGLInit()
+{
+    // load opengl library
+    glModule = LoadLibraryA("opengl32.dll");
+    if (!glModule)
+    {
+        MINIMAL_ERROR("[WGL] Failed to load opengl32.dll");
+        return MINIMAL_FAIL;
+    }
+
+    // create helper window
+    HINSTANCE instance = GetModuleHandleW(NULL);
+    LPCWSTR className = MINIMAL_WNDCLASSNAME;
+    DWORD exStyle = WS_EX_OVERLAPPEDWINDOW;
+    DWORD style = WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+    HWND helperWnd = CreateWindowExW(exStyle, className, NULL, style, 0, 0, 1, 1, 0, 0, instance, 0);
+
+    if (!helperWnd)
+    {
+        MINIMAL_ERROR("[WGL] Failed to create helper window");
+        minimalWGLTerminate();
+        return MINIMAL_FAIL;
+    }
+
+    uint8_t result = minimalWGLLoadExtensions(helperWnd);
 
     // destroy helper window
     if (!DestroyWindow(helperWnd))
+        MINIMAL_WARN("[WGL] Failed to destroy helper window");
+
+    // nothing is kept from a failed attempt, the next window tries again
+    if (!result)
     {
-        MINIMAL_ERROR("[WGL] Failed to destroy helper window");
+        minimalWGLTerminate();
         return MINIMAL_FAIL;
     }
 
+    _wglInitialized = 1;
     return MINIMAL_OK;
 }
 
@@ -504,10 +855,24 @@ void minimalWGLTerminate()
 {
     if (glModule)
         FreeLibrary(glModule);
+
+    glModule = NULL;
+    _wglInitialized = 0;
+
+    _wglCreateContextAttrARB = NULL;
+    _wglSwapIntervalEXT = NULL;
+    _wglChoosePixelFormatARB = NULL;
 }
 
 HGLRC minimalCreateRenderContext(HDC dc)
 {
+    // the dummy context is only paid for once a window actually needs gl
+    if (!_wglInitialized && !minimalWGLInit())
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize WGL");
+        return NULL;
+    }
+
     int pfAttribs[] = {
         WGL_DRAW_TO_WINDOW_ARB,     1,
         WGL_SUPPORT_OPENGL_ARB,     1,
@@ -586,6 +951,21 @@ void minimalSwapInterval(uint8_t interval)
     if (_wglSwapIntervalEXT) _wglSwapIntervalEXT(interval);
 }
 
-#endif // !MINIMAL_NO_CONTEXT
+#endif // MINIMAL_CONTEXT_WGL
+
+/* --------------------------| egl |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_EGL
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    minimalEGLSwapInterval(interval);
+}
+
+#endif // MINIMAL_CONTEXT_EGL
 
 #endif // MINIMAL_PLATFORM_WINDOWS
\ No newline at end of file
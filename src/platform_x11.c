@@ -0,0 +1,1329 @@
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "minimal.h"
+
+#ifdef MINIMAL_PLATFORM_X11
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/Xresource.h>
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/XInput2.h>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/eventfd.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+#if !defined(MINIMAL_NO_CONTEXT) && !defined(MINIMAL_CONTEXT_EGL)
+#define MINIMAL_CONTEXT_GLX
+#endif
+
+#ifdef MINIMAL_CONTEXT_GLX
+#include <GL/glx.h>
+#elif defined(MINIMAL_CONTEXT_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_X11_KHR
+#define EGL_PLATFORM_X11_KHR    0x31D5
+#endif
+#endif
+
+static Display* _minimalDisplay = NULL;
+static int      _minimalScreen = 0;
+static Window   _minimalRoot = None;
+
+static Atom _minimalWMProtocols;
+static Atom _minimalWMDeleteWindow;
+static Atom _minimalNetWMName;
+static Atom _minimalNetWMState;
+static Atom _minimalNetWMStateMaxVert;
+static Atom _minimalNetWMStateMaxHorz;
+static Atom _minimalUTF8String;
+
+/* maps native window handles to MinimalWindow */
+static XContext _minimalWindowContext;
+
+static uint64_t _minimalTimerOffset = 0;
+static float    _minimalContentScale = 1.0f;
+
+/* signalled by minimalWakeWindow to interrupt minimalWaitWindowEvents */
+static int      _minimalWakeFd = -1;
+
+/* event type of XShmCompletionEvent, -1 without MIT-SHM */
+static int      _minimalShmCompletion = -1;
+
+/* major opcode of XInput2, -1 without it */
+static int      _minimalXIOpcode = -1;
+
+/* raw motion is selected on the root window and reported to the last window enabling it */
+static MinimalWindow* _minimalRawWindow = NULL;
+
+/* blank cursor shown while the pointer is locked */
+static Cursor   _minimalHiddenCursor = None;
+
+/* X11 keycode to MINIMAL_KEY_* */
+static MinimalKeycode _minimalKeycodes[256];
+
+/* set by minimalX11ErrorHandler, requests failing asynchronously are checked by syncing with it installed */
+static uint8_t  _minimalX11Error = 0;
+
+static int minimalX11ErrorHandler(Display* display, XErrorEvent* event)
+{
+    _minimalX11Error = 1;
+    return 0;
+}
+
+static void minimalX11CreateKeyTable();
+static void minimalX11ProcessEvent(XEvent* event);
+
+typedef struct
+{
+    XImage*         image;
+    XShmSegmentInfo shm;
+    uint8_t         busy;
+} MinimalX11Framebuffer;
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+static uint8_t minimalGLXInit();
+static uint8_t minimalGLXChooseConfig(GLXFBConfig* config);
+static GLXContext minimalCreateRenderContext(Window handle, GLXFBConfig config);
+
+#endif
+
+uint8_t minimalPlatformInit()
+{
+    _minimalDisplay = XOpenDisplay(NULL);
+    if (!_minimalDisplay)
+    {
+        MINIMAL_ERROR("[Platform] Failed to open X display");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalScreen = DefaultScreen(_minimalDisplay);
+    _minimalRoot = RootWindow(_minimalDisplay, _minimalScreen);
+
+    _minimalWMProtocols =       XInternAtom(_minimalDisplay, "WM_PROTOCOLS", False);
+    _minimalWMDeleteWindow =    XInternAtom(_minimalDisplay, "WM_DELETE_WINDOW", False);
+    _minimalNetWMName =         XInternAtom(_minimalDisplay, "_NET_WM_NAME", False);
+    _minimalNetWMState =        XInternAtom(_minimalDisplay, "_NET_WM_STATE", False);
+    _minimalNetWMStateMaxVert = XInternAtom(_minimalDisplay, "_NET_WM_STATE_MAXIMIZED_VERT", False);
+    _minimalNetWMStateMaxHorz = XInternAtom(_minimalDisplay, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
+    _minimalUTF8String =        XInternAtom(_minimalDisplay, "UTF8_STRING", False);
+
+    _minimalWindowContext = XUniqueContext();
+
+    // only report a single press for held keys instead of release/press pairs
+    XkbSetDetectableAutoRepeat(_minimalDisplay, True, NULL);
+
+    minimalX11CreateKeyTable();
+
+    // shared memory images only work with a local server, attaching is checked per framebuffer
+    if (XShmQueryExtension(_minimalDisplay))
+        _minimalShmCompletion = XShmGetEventBase(_minimalDisplay) + ShmCompletion;
+
+    // raw motion comes from XInput 2.0 and is only available with it
+    int opcode, xiEvent, xiError, xiMajor = 2, xiMinor = 0;
+    if (XQueryExtension(_minimalDisplay, "XInputExtension", &opcode, &xiEvent, &xiError)
+        && XIQueryVersion(_minimalDisplay, &xiMajor, &xiMinor) == Success)
+        _minimalXIOpcode = opcode;
+
+    // content scale from the desktop's Xft.dpi setting
+    XrmInitialize();
+    char* resources = XResourceManagerString(_minimalDisplay);
+    if (resources)
+    {
+        XrmDatabase db = XrmGetStringDatabase(resources);
+        if (db)
+        {
+            char* type = NULL;
+            XrmValue value;
+            if (XrmGetResource(db, "Xft.dpi", "Xft.Dpi", &type, &value) && type && strcmp(type, "String") == 0)
+                _minimalContentScale = (float)atof(value.addr) / 96.0f;
+            XrmDestroyDatabase(db);
+        }
+    }
+
+    _minimalWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_minimalWakeFd < 0)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create wakeup eventfd");
+        return MINIMAL_FAIL;
+    }
+
+    // init time
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        MINIMAL_ERROR("[Platform] Monotonic clock is not supported");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalTimerOffset = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    minimalInitTicks();
+
+#ifdef MINIMAL_CONTEXT_GLX
+    // init glx
+    if (!minimalGLXInit())
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize GLX");
+        return MINIMAL_FAIL;
+    }
+#elif defined(MINIMAL_CONTEXT_EGL)
+    // init egl on top of the xlib display
+    if (!minimalEGLInit(EGL_PLATFORM_X11_KHR, _minimalDisplay))
+    {
+        MINIMAL_ERROR("[Platform] Failed to initialize EGL");
+        return MINIMAL_FAIL;
+    }
+#endif
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalPlatformTerminate()
+{
+#ifdef MINIMAL_CONTEXT_EGL
+    minimalEGLTerminate();
+#endif
+
+    if (_minimalWakeFd >= 0)
+    {
+        close(_minimalWakeFd);
+        _minimalWakeFd = -1;
+    }
+
+    if (_minimalDisplay)
+    {
+        if (_minimalHiddenCursor != None)
+            XFreeCursor(_minimalDisplay, _minimalHiddenCursor);
+        _minimalHiddenCursor = None;
+
+        XCloseDisplay(_minimalDisplay);
+        _minimalDisplay = NULL;
+    }
+    return MINIMAL_OK;
+}
+
+static int32_t windowHints[MINIMAL_HINT_MAX_ENUM];
+
+void minimalSetWindowHint(MinimalWindowHint name, int32_t value)
+{
+    if (name >= 0 && name < MINIMAL_HINT_MAX_ENUM)
+        windowHints[name] = value;
+}
+
+struct MinimalWindow
+{
+    Window      handle;
+    Colormap    colormap;
+
+#ifdef MINIMAL_CONTEXT_GLX
+    GLXContext  renderContext;
+#elif defined(MINIMAL_CONTEXT_EGL)
+    MinimalEGLContext egl;
+#endif
+
+    Visual* visual;
+    int     depth;
+
+    GC      gc;
+    MinimalX11Framebuffer framebuffers[MINIMAL_FRAMEBUFFER_COUNT];
+    uint32_t framebufferIndex;
+    uint8_t  framebufferShm;
+
+    uint32_t width;
+    uint32_t height;
+
+    uint8_t shouldClose;
+
+    /* raw motion is only reported while one of these is set */
+    uint8_t focused;
+    uint8_t pointerLocked;
+
+    uint32_t eventMask;
+};
+
+/* the input the server has to send for the enabled event types */
+static long minimalX11InputMask(uint32_t mask)
+{
+    long input = StructureNotifyMask | FocusChangeMask;
+
+    if (mask & (MINIMAL_EVENT_MASK(MINIMAL_EVENT_KEY) | MINIMAL_EVENT_MASK(MINIMAL_EVENT_CHAR)))
+        input |= KeyPressMask | KeyReleaseMask;
+    if (mask & (MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_BUTTON) | MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_SCROLLED)))
+        input |= ButtonPressMask | ButtonReleaseMask;
+    if (mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_MOVED))
+        input |= PointerMotionMask | LeaveWindowMask;
+
+    return input;
+}
+
+MinimalWindow* minimalCreateWindow(const char* title, int32_t x, int32_t y, uint32_t w, uint32_t h)
+{
+    MinimalWindow* window = calloc(1, sizeof(MinimalWindow));
+    if (!window) return NULL;
+
+    window->eventMask = MINIMAL_EVENT_MASK_DEFAULT;
+
+    Visual* visual = DefaultVisual(_minimalDisplay, _minimalScreen);
+    int depth = DefaultDepth(_minimalDisplay, _minimalScreen);
+
+#ifndef MINIMAL_NO_CONTEXT
+    uint8_t noApi = windowHints[MINIMAL_HINT_CLIENT_API] == MINIMAL_NO_API;
+#endif
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+    GLXFBConfig config = NULL;
+    if (!noApi && !minimalGLXChooseConfig(&config))
+    {
+        free(window);
+        return NULL;
+    }
+
+    XVisualInfo* vi = noApi ? NULL : glXGetVisualFromFBConfig(_minimalDisplay, config);
+    if (!noApi && !vi)
+    {
+        MINIMAL_ERROR("[GLX] Failed to retrieve visual for framebuffer config");
+        free(window);
+        return NULL;
+    }
+
+    if (vi)
+    {
+        visual = vi->visual;
+        depth = vi->depth;
+        XFree(vi);
+    }
+
+#endif
+
+    // create window
+    window->visual = visual;
+    window->depth = depth;
+    window->colormap = XCreateColormap(_minimalDisplay, _minimalRoot, visual, AllocNone);
+
+    XSetWindowAttributes wa = {
+        .colormap       = window->colormap,
+        .border_pixel   = 0,
+        .event_mask     = minimalX11InputMask(window->eventMask)
+    };
+
+    // failures are reported as an async error, the returned id is never zero
+    _minimalX11Error = 0;
+    int (*handler)(Display*, XErrorEvent*) = XSetErrorHandler(minimalX11ErrorHandler);
+
+    window->handle = XCreateWindow(_minimalDisplay, _minimalRoot, x, y, w, h, 0, depth, InputOutput, visual,
+                                   CWBorderPixel | CWColormap | CWEventMask, &wa);
+    XSync(_minimalDisplay, False);
+
+    XSetErrorHandler(handler);
+
+    if (_minimalX11Error)
+    {
+        MINIMAL_ERROR("[Platform] Failed to create window");
+        window->handle = None;
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+    XSaveContext(_minimalDisplay, window->handle, _minimalWindowContext, (XPointer)window);
+    XSetWMProtocols(_minimalDisplay, window->handle, &_minimalWMDeleteWindow, 1);
+
+    // window managers ignore the requested position without PPosition
+    XSizeHints* hints = XAllocSizeHints();
+    if (hints)
+    {
+        hints->flags = PPosition;
+        hints->x = x;
+        hints->y = y;
+        XSetWMNormalHints(_minimalDisplay, window->handle, hints);
+        XFree(hints);
+    }
+
+    minimalSetWindowTitle(window, title);
+
+    XMapWindow(_minimalDisplay, window->handle);
+    XFlush(_minimalDisplay);
+
+    window->width = w;
+    window->height = h;
+    window->shouldClose = 0;
+
+#ifndef MINIMAL_NO_CONTEXT
+    if (noApi) return window;
+#endif
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+    window->renderContext = minimalCreateRenderContext(window->handle, config);
+    if (!window->renderContext)
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    if (!minimalEGLCreateContext(&window->egl, (void*)(uintptr_t)window->handle, w, h, major, minor))
+    {
+        minimalDestroyWindow(window);
+        return NULL;
+    }
+
+#endif
+
+    return window;
+}
+
+void minimalDestroyWindow(MinimalWindow* window)
+{
+    minimalDestroyFramebuffer(window);
+
+#ifdef MINIMAL_CONTEXT_GLX
+
+    // destroy render context
+    if (window->renderContext)
+    {
+        if (glXGetCurrentContext() == window->renderContext && !glXMakeCurrent(_minimalDisplay, None, NULL))
+        {
+            MINIMAL_ERROR("[GLX] Failed to release render context");
+        }
+
+        glXDestroyContext(_minimalDisplay, window->renderContext);
+    }
+
+#elif defined(MINIMAL_CONTEXT_EGL)
+
+    minimalEGLDestroyContext(&window->egl);
+
+#endif
+
+    if (_minimalRawWindow == window)
+        minimalSetEventMask(window, window->eventMask & ~MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW));
+
+    minimalResetMouseDelta(window);
+
+    // destroy window
+    if (window->handle)
+    {
+        XDeleteContext(_minimalDisplay, window->handle, _minimalWindowContext);
+        XDestroyWindow(_minimalDisplay, window->handle);
+    }
+
+    if (window->colormap)
+        XFreeColormap(_minimalDisplay, window->colormap);
+
+    XFlush(_minimalDisplay);
+
+    free(window);
+}
+
+void minimalPollWindowEvents(MinimalWindow* context)
+{
+    // all windows share one connection, events are routed to the window they belong to
+    minimalPollAllEvents();
+}
+
+void minimalPollAllEvents()
+{
+    while (XPending(_minimalDisplay))
+    {
+        XEvent event;
+        XNextEvent(_minimalDisplay, &event);
+        minimalX11ProcessEvent(&event);
+    }
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
+
+void minimalWaitWindowEvents(MinimalWindow* context, uint64_t timeout)
+{
+    int ms = -1;
+    if (timeout != MINIMAL_WAIT_INFINITE)
+    {
+        // rounded up so short waits do not turn into spins
+        uint64_t value = (timeout + 999999) / 1000000;
+        ms = value > INT_MAX ? INT_MAX : (int)value;
+    }
+
+    // events already buffered by xlib would not wake up poll
+    if (!XPending(_minimalDisplay))
+    {
+        struct pollfd fds[2] = {
+            { .fd = ConnectionNumber(_minimalDisplay), .events = POLLIN },
+            { .fd = _minimalWakeFd, .events = POLLIN }
+        };
+
+        if (poll(fds, 2, ms) > 0 && (fds[1].revents & POLLIN))
+        {
+            uint64_t value;
+            while (read(_minimalWakeFd, &value, sizeof(value)) > 0);
+        }
+    }
+
+    minimalPollWindowEvents(context);
+}
+
+void minimalWakeWindow(MinimalWindow* window)
+{
+    // only fails if the counter is already full, which wakes the wait as well
+    uint64_t value = 1;
+    ssize_t result = write(_minimalWakeFd, &value, sizeof(value));
+    (void)result;
+}
+
+static void minimalX11SelectRawMotion(uint8_t enable)
+{
+    unsigned char bits[XIMaskLen(XI_LASTEVENT)] = { 0 };
+    if (enable) XISetMask(bits, XI_RawMotion);
+
+    XIEventMask mask = { .deviceid = XIAllMasterDevices, .mask_len = sizeof(bits), .mask = bits };
+    XISelectEvents(_minimalDisplay, _minimalRoot, &mask, 1);
+}
+
+void minimalSetEventMask(MinimalWindow* window, uint32_t mask)
+{
+    window->eventMask = mask;
+    XSelectInput(_minimalDisplay, window->handle, minimalX11InputMask(mask));
+
+    uint8_t raw = (mask & MINIMAL_EVENT_MASK(MINIMAL_EVENT_MOUSE_RAW)) != 0;
+    if (raw && _minimalXIOpcode < 0)
+        MINIMAL_WARN("[Platform] Raw mouse motion needs XInput 2.0");
+
+    if (raw)                                _minimalRawWindow = window;
+    else if (_minimalRawWindow == window)   _minimalRawWindow = NULL;
+
+    if (_minimalXIOpcode >= 0)
+        minimalX11SelectRawMotion(_minimalRawWindow != NULL);
+
+    XFlush(_minimalDisplay);
+}
+
+void minimalSetWindowTitle(MinimalWindow* context, const char* title)
+{
+    XStoreName(_minimalDisplay, context->handle, title);
+    XChangeProperty(_minimalDisplay, context->handle, _minimalNetWMName, _minimalUTF8String, 8,
+                    PropModeReplace, (const unsigned char*)title, (int)strlen(title));
+}
+
+uint8_t minimalShouldClose(const MinimalWindow* context) { return context->shouldClose; }
+void    minimalClose(MinimalWindow* context)             { context->shouldClose = 1; }
+
+void minimalMaximize(MinimalWindow* window)
+{
+    XEvent event = { 0 };
+    event.xclient.type = ClientMessage;
+    event.xclient.window = window->handle;
+    event.xclient.message_type = _minimalNetWMState;
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = 1; /* _NET_WM_STATE_ADD */
+    event.xclient.data.l[1] = (long)_minimalNetWMStateMaxVert;
+    event.xclient.data.l[2] = (long)_minimalNetWMStateMaxHorz;
+    event.xclient.data.l[3] = 1; /* normal application */
+
+    XSendEvent(_minimalDisplay, _minimalRoot, False, SubstructureNotifyMask | SubstructureRedirectMask, &event);
+    XFlush(_minimalDisplay);
+}
+
+void minimalMinimize(MinimalWindow* window)
+{
+    XIconifyWindow(_minimalDisplay, window->handle, _minimalScreen);
+    XFlush(_minimalDisplay);
+}
+
+void minimalSetPointerLock(MinimalWindow* window, uint8_t lock)
+{
+    if (!lock)
+    {
+        window->pointerLocked = 0;
+        XUngrabPointer(_minimalDisplay, CurrentTime);
+        XUndefineCursor(_minimalDisplay, window->handle);
+        XFlush(_minimalDisplay);
+        return;
+    }
+
+    if (_minimalHiddenCursor == None)
+    {
+        char bits = 0;
+        XColor black = { 0 };
+        Pixmap pixmap = XCreateBitmapFromData(_minimalDisplay, _minimalRoot, &bits, 1, 1);
+        _minimalHiddenCursor = XCreatePixmapCursor(_minimalDisplay, pixmap, pixmap, &black, &black, 0, 0);
+        XFreePixmap(_minimalDisplay, pixmap);
+    }
+
+    XDefineCursor(_minimalDisplay, window->handle, _minimalHiddenCursor);
+
+    // confining the grab to the window keeps the pointer inside it, raw motion continues at the edges
+    int result = XGrabPointer(_minimalDisplay, window->handle, True, ButtonPressMask | ButtonReleaseMask | PointerMotionMask,
+                              GrabModeAsync, GrabModeAsync, window->handle, _minimalHiddenCursor, CurrentTime);
+    if (result != GrabSuccess)
+        MINIMAL_WARN("[Platform] Failed to grab the pointer");
+
+    window->pointerLocked = result == GrabSuccess;
+
+    XFlush(_minimalDisplay);
+}
+
+uint64_t minimalGetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t value = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    return value - _minimalTimerOffset;
+}
+
+void minimalGetFramebufferSize(const MinimalWindow* context, int32_t* w, int32_t* h)
+{
+    if (w) *w = (int32_t)context->width;
+    if (h) *h = (int32_t)context->height;
+}
+
+void minimalGetWindowContentScale(const MinimalWindow* context, float* xscale, float* yscale)
+{
+    if (xscale) *xscale = _minimalContentScale;
+    if (yscale) *yscale = _minimalContentScale;
+}
+
+void* minimalGetNativeWindowHandle(const MinimalWindow* window)
+{
+    return (void*)(uintptr_t)window->handle;
+}
+
+void* minimalGetNativeDisplayHandle()
+{
+    return _minimalDisplay;
+}
+
+/* --------------------------| keyboard |-------------------------------- */
+#define MINIMAL_KEYSYM_INDEX(sym) ((sym) & 0xff)
+
+/* keysyms in the 0xff00 page (function, cursor, keypad and modifier keys) */
+static const MinimalKeycode _minimalKeysymsMisc[256] = {
+    [MINIMAL_KEYSYM_INDEX(XK_BackSpace)]    = MINIMAL_KEY_BACKSPACE,
+    [MINIMAL_KEYSYM_INDEX(XK_Tab)]          = MINIMAL_KEY_TAB,
+    [MINIMAL_KEYSYM_INDEX(XK_Return)]       = MINIMAL_KEY_ENTER,
+    [MINIMAL_KEYSYM_INDEX(XK_Pause)]        = MINIMAL_KEY_PAUSE,
+    [MINIMAL_KEYSYM_INDEX(XK_Scroll_Lock)]  = MINIMAL_KEY_SCROLL,
+    [MINIMAL_KEYSYM_INDEX(XK_Escape)]       = MINIMAL_KEY_ESCAPE,
+    [MINIMAL_KEYSYM_INDEX(XK_Henkan)]       = MINIMAL_KEY_CONVERT,
+    [MINIMAL_KEYSYM_INDEX(XK_Muhenkan)]     = MINIMAL_KEY_NONCONVERT,
+    [MINIMAL_KEYSYM_INDEX(XK_Home)]         = MINIMAL_KEY_HOME,
+    [MINIMAL_KEYSYM_INDEX(XK_Left)]         = MINIMAL_KEY_LEFT,
+    [MINIMAL_KEYSYM_INDEX(XK_Up)]           = MINIMAL_KEY_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_Right)]        = MINIMAL_KEY_RIGHT,
+    [MINIMAL_KEYSYM_INDEX(XK_Down)]         = MINIMAL_KEY_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_Page_Up)]      = MINIMAL_KEY_PAGE_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_Page_Down)]    = MINIMAL_KEY_PAGE_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_End)]          = MINIMAL_KEY_END,
+    [MINIMAL_KEYSYM_INDEX(XK_Select)]       = MINIMAL_KEY_SELECT,
+    [MINIMAL_KEYSYM_INDEX(XK_Print)]        = MINIMAL_KEY_SNAPSHOT,
+    [MINIMAL_KEYSYM_INDEX(XK_Execute)]      = MINIMAL_KEY_EXECUTE,
+    [MINIMAL_KEYSYM_INDEX(XK_Insert)]       = MINIMAL_KEY_INSERT,
+    [MINIMAL_KEYSYM_INDEX(XK_Menu)]         = MINIMAL_KEY_APPS,
+    [MINIMAL_KEYSYM_INDEX(XK_Help)]         = MINIMAL_KEY_HELP,
+    [MINIMAL_KEYSYM_INDEX(XK_Mode_switch)]  = MINIMAL_KEY_MODECHANGE,
+    [MINIMAL_KEYSYM_INDEX(XK_Num_Lock)]     = MINIMAL_KEY_NUMLOCK,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Enter)]     = MINIMAL_KEY_ENTER,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Home)]      = MINIMAL_KEY_HOME,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Left)]      = MINIMAL_KEY_LEFT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Up)]        = MINIMAL_KEY_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Right)]     = MINIMAL_KEY_RIGHT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Down)]      = MINIMAL_KEY_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Page_Up)]   = MINIMAL_KEY_PAGE_UP,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Page_Down)] = MINIMAL_KEY_PAGE_DOWN,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_End)]       = MINIMAL_KEY_END,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Insert)]    = MINIMAL_KEY_INSERT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Delete)]    = MINIMAL_KEY_DELETE,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Equal)]     = MINIMAL_KEY_NUMPAD_EQUAL,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Multiply)]  = MINIMAL_KEY_MULTIPLY,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Add)]       = MINIMAL_KEY_ADD,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Separator)] = MINIMAL_KEY_SEPARATOR,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Subtract)]  = MINIMAL_KEY_SUBTRACT,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Decimal)]   = MINIMAL_KEY_DECIMAL,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_Divide)]    = MINIMAL_KEY_DIVIDE,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_0)]         = MINIMAL_KEY_NUMPAD0,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_1)]         = MINIMAL_KEY_NUMPAD1,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_2)]         = MINIMAL_KEY_NUMPAD2,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_3)]         = MINIMAL_KEY_NUMPAD3,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_4)]         = MINIMAL_KEY_NUMPAD4,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_5)]         = MINIMAL_KEY_NUMPAD5,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_6)]         = MINIMAL_KEY_NUMPAD6,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_7)]         = MINIMAL_KEY_NUMPAD7,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_8)]         = MINIMAL_KEY_NUMPAD8,
+    [MINIMAL_KEYSYM_INDEX(XK_KP_9)]         = MINIMAL_KEY_NUMPAD9,
+    [MINIMAL_KEYSYM_INDEX(XK_F1)]           = MINIMAL_KEY_F1,
+    [MINIMAL_KEYSYM_INDEX(XK_F2)]           = MINIMAL_KEY_F2,
+    [MINIMAL_KEYSYM_INDEX(XK_F3)]           = MINIMAL_KEY_F3,
+    [MINIMAL_KEYSYM_INDEX(XK_F4)]           = MINIMAL_KEY_F4,
+    [MINIMAL_KEYSYM_INDEX(XK_F5)]           = MINIMAL_KEY_F5,
+    [MINIMAL_KEYSYM_INDEX(XK_F6)]           = MINIMAL_KEY_F6,
+    [MINIMAL_KEYSYM_INDEX(XK_F7)]           = MINIMAL_KEY_F7,
+    [MINIMAL_KEYSYM_INDEX(XK_F8)]           = MINIMAL_KEY_F8,
+    [MINIMAL_KEYSYM_INDEX(XK_F9)]           = MINIMAL_KEY_F9,
+    [MINIMAL_KEYSYM_INDEX(XK_F10)]          = MINIMAL_KEY_F10,
+    [MINIMAL_KEYSYM_INDEX(XK_F11)]          = MINIMAL_KEY_F11,
+    [MINIMAL_KEYSYM_INDEX(XK_F12)]          = MINIMAL_KEY_F12,
+    [MINIMAL_KEYSYM_INDEX(XK_F13)]          = MINIMAL_KEY_F13,
+    [MINIMAL_KEYSYM_INDEX(XK_F14)]          = MINIMAL_KEY_F14,
+    [MINIMAL_KEYSYM_INDEX(XK_F15)]          = MINIMAL_KEY_F15,
+    [MINIMAL_KEYSYM_INDEX(XK_F16)]          = MINIMAL_KEY_F16,
+    [MINIMAL_KEYSYM_INDEX(XK_F17)]          = MINIMAL_KEY_F17,
+    [MINIMAL_KEYSYM_INDEX(XK_F18)]          = MINIMAL_KEY_F18,
+    [MINIMAL_KEYSYM_INDEX(XK_F19)]          = MINIMAL_KEY_F19,
+    [MINIMAL_KEYSYM_INDEX(XK_F20)]          = MINIMAL_KEY_F20,
+    [MINIMAL_KEYSYM_INDEX(XK_F21)]          = MINIMAL_KEY_F21,
+    [MINIMAL_KEYSYM_INDEX(XK_F22)]          = MINIMAL_KEY_F22,
+    [MINIMAL_KEYSYM_INDEX(XK_F23)]          = MINIMAL_KEY_F23,
+    [MINIMAL_KEYSYM_INDEX(XK_F24)]          = MINIMAL_KEY_F24,
+    [MINIMAL_KEYSYM_INDEX(XK_Shift_L)]      = MINIMAL_KEY_SHIFT,
+    [MINIMAL_KEYSYM_INDEX(XK_Shift_R)]      = MINIMAL_KEY_SHIFT,
+    [MINIMAL_KEYSYM_INDEX(XK_Control_L)]    = MINIMAL_KEY_CONTROL,
+    [MINIMAL_KEYSYM_INDEX(XK_Control_R)]    = MINIMAL_KEY_CONTROL,
+    [MINIMAL_KEYSYM_INDEX(XK_Caps_Lock)]    = MINIMAL_KEY_CAPITAL,
+    [MINIMAL_KEYSYM_INDEX(XK_Alt_L)]        = MINIMAL_KEY_ALT,
+    [MINIMAL_KEYSYM_INDEX(XK_Alt_R)]        = MINIMAL_KEY_ALT,
+    [MINIMAL_KEYSYM_INDEX(XK_Super_L)]      = MINIMAL_KEY_LCOMMAND,
+    [MINIMAL_KEYSYM_INDEX(XK_Super_R)]      = MINIMAL_KEY_RCOMMAND,
+    [MINIMAL_KEYSYM_INDEX(XK_Delete)]       = MINIMAL_KEY_DELETE,
+};
+
+/* printable keysyms in the latin-1 page that have a MINIMAL_KEY_* */
+static const MinimalKeycode _minimalKeysymsLatin1[128] = {
+    [XK_space]      = MINIMAL_KEY_SPACE,
+    [XK_semicolon]  = MINIMAL_KEY_SEMICOLON,
+    [XK_equal]      = MINIMAL_KEY_PLUS,
+    [XK_comma]      = MINIMAL_KEY_COMMA,
+    [XK_minus]      = MINIMAL_KEY_MINUS,
+    [XK_period]     = MINIMAL_KEY_PERIOD,
+    [XK_slash]      = MINIMAL_KEY_SLASH,
+    [XK_grave]      = MINIMAL_KEY_GRAVE,
+};
+
+static MinimalKeycode minimalX11TranslateKeysym(KeySym sym)
+{
+    MinimalKeycode key = 0;
+
+    if (sym >= XK_0 && sym <= XK_9)                 key = (MinimalKeycode)(MINIMAL_KEY_0 + (sym - XK_0));
+    else if (sym >= XK_A && sym <= XK_Z)            key = (MinimalKeycode)(MINIMAL_KEY_A + (sym - XK_A));
+    else if (sym >= XK_a && sym <= XK_z)            key = (MinimalKeycode)(MINIMAL_KEY_A + (sym - XK_a));
+    else if (sym < 0x80)                            key = _minimalKeysymsLatin1[sym];
+    else if ((sym & 0xff00) == 0xff00)              key = _minimalKeysymsMisc[MINIMAL_KEYSYM_INDEX(sym)];
+
+    return key ? key : MINIMAL_KEY_UNKNOWN;
+}
+
+static uint8_t minimalX11IsKeypadKeysym(KeySym sym)
+{
+    return sym >= XK_KP_Space && sym <= XK_KP_Equal;
+}
+
+/*
+ * Translating keysyms on every event would cost a round of lookups per key,
+ * so the table from X11 keycodes to MINIMAL_KEY_* is built once here and
+ * events only index into it.
+ */
+static void minimalX11CreateKeyTable()
+{
+    for (int i = 0; i < 256; ++i)
+        _minimalKeycodes[i] = MINIMAL_KEY_UNKNOWN;
+
+    int min = 0, max = 0, width = 0;
+    XDisplayKeycodes(_minimalDisplay, &min, &max);
+
+    KeySym* keysyms = XGetKeyboardMapping(_minimalDisplay, (KeyCode)min, max - min + 1, &width);
+    if (!keysyms) return;
+
+    for (int code = min; code <= max && code < 256; ++code)
+    {
+        const KeySym* syms = keysyms + (code - min) * width;
+
+        // keypad keys report their navigation keysym first, prefer the numlock level
+        if (width > 1 && minimalX11IsKeypadKeysym(syms[1]))
+            _minimalKeycodes[code] = minimalX11TranslateKeysym(syms[1]);
+        else
+            _minimalKeycodes[code] = minimalX11TranslateKeysym(syms[0]);
+    }
+
+    XFree(keysyms);
+}
+
+static uint32_t minimalX11GetCodepoint(KeySym sym)
+{
+    // latin-1 keysyms match their codepoint
+    if ((sym >= 0x20 && sym <= 0x7e) || (sym >= 0xa0 && sym <= 0xff))
+        return (uint32_t)sym;
+
+    // unicode keysyms
+    if ((sym & 0xff000000) == 0x01000000)
+        return (uint32_t)(sym & 0x00ffffff);
+
+    return 0;
+}
+
+static uint32_t minimalX11GetKeyMods(unsigned int state)
+{
+    uint32_t mods = 0;
+    if (state & ShiftMask)      mods |= MINIMAL_KEY_MOD_SHIFT;
+    if (state & ControlMask)    mods |= MINIMAL_KEY_MOD_CONTROL;
+    if (state & Mod1Mask)       mods |= MINIMAL_KEY_MOD_ALT;
+    if (state & Mod4Mask)       mods |= MINIMAL_KEY_MOD_COMMAND;
+    if (state & LockMask)       mods |= MINIMAL_KEY_MOD_CAPS_LOCK;
+    if (state & Mod2Mask)       mods |= MINIMAL_KEY_MOD_NUM_LOCK;
+    return mods;
+}
+
+static MinimalMouseButton minimalX11GetMouseButton(unsigned int button)
+{
+    if (button == Button1)  return MINIMAL_MOUSE_BUTTON_LEFT;
+    if (button == Button2)  return MINIMAL_MOUSE_BUTTON_MIDDLE;
+    if (button == Button3)  return MINIMAL_MOUSE_BUTTON_RIGHT;
+
+    // buttons 4 to 7 are the scroll wheels, extra buttons start at 8
+    if (button >= 8)        return (MinimalMouseButton)(MINIMAL_MOUSE_BUTTON_4 + (button - 8));
+    return MINIMAL_MOUSE_BUTTON_UNKNOWN;
+}
+
+static void minimalX11ProcessRawMotion(MinimalWindow* context, const XIRawEvent* raw)
+{
+    if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_RAW)) return;
+
+    // raw values are packed, only the valuators set in the mask are present
+    const double* values = raw->raw_values;
+    double dx = 0.0, dy = 0.0;
+    if (raw->valuators.mask_len > 0 && XIMaskIsSet(raw->valuators.mask, 0)) dx = *values++;
+    if (raw->valuators.mask_len > 0 && XIMaskIsSet(raw->valuators.mask, 1)) dy = *values;
+
+    int32_t x = (int32_t)(dx * MINIMAL_MOUSE_RAW_ONE);
+    int32_t y = (int32_t)(dy * MINIMAL_MOUSE_RAW_ONE);
+
+    minimalSetEventTime(minimalRebaseEventTime((uint32_t)raw->time));
+
+    if (minimalProcessMouseRaw(x, y))
+        minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_RAW, 0, x, y);
+}
+
+static void minimalX11ProcessEvent(XEvent* event)
+{
+    // raw motion is reported for the root window, not the one that asked for it
+    if (event->type == GenericEvent)
+    {
+        if (event->xcookie.extension == _minimalXIOpcode && XGetEventData(_minimalDisplay, &event->xcookie))
+        {
+            // the root window sees all motion, drop it while the window is in the background
+            MinimalWindow* raw = _minimalRawWindow;
+            if (event->xcookie.evtype == XI_RawMotion && raw && (raw->focused || raw->pointerLocked))
+                minimalX11ProcessRawMotion(raw, (const XIRawEvent*)event->xcookie.data);
+            XFreeEventData(_minimalDisplay, &event->xcookie);
+        }
+        return;
+    }
+
+    if (event->type == MappingNotify)
+    {
+        if (event->xmapping.request == MappingKeyboard)
+        {
+            XRefreshKeyboardMapping(&event->xmapping);
+            minimalX11CreateKeyTable();
+        }
+        return;
+    }
+
+    MinimalWindow* context = NULL;
+    if (XFindContext(_minimalDisplay, event->xany.window, _minimalWindowContext, (XPointer*)&context) != 0 || !context)
+        return;
+
+    // extension events have no fixed type
+    if (event->type == _minimalShmCompletion)
+    {
+        XShmCompletionEvent* completion = (XShmCompletionEvent*)event;
+        for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+        {
+            if (context->framebuffers[i].image && context->framebuffers[i].shm.shmseg == completion->shmseg)
+                context->framebuffers[i].busy = 0;
+        }
+        return;
+    }
+
+    // only input events carry a server timestamp
+    Time time = 0;
+    switch (event->type)
+    {
+    case KeyPress:
+    case KeyRelease:    time = event->xkey.time; break;
+    case ButtonPress:
+    case ButtonRelease: time = event->xbutton.time; break;
+    case MotionNotify:  time = event->xmotion.time; break;
+    }
+    minimalSetEventTime(time ? minimalRebaseEventTime((uint32_t)time) : 0);
+
+    switch (event->type)
+    {
+    case ClientMessage:
+    {
+        if (event->xclient.message_type == _minimalWMProtocols
+            && (Atom)event->xclient.data.l[0] == _minimalWMDeleteWindow)
+            minimalClose(context);
+        return;
+    }
+    case KeyPress:
+    case KeyRelease:
+    {
+        uint8_t action = event->type == KeyPress;
+        uint8_t keys = MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_KEY);
+        uint8_t chars = action && MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_CHAR);
+        if (!keys && !chars) return;
+
+        MinimalKeycode keycode = _minimalKeycodes[event->xkey.keycode & 0xff];
+        uint32_t mods = minimalX11GetKeyMods(event->xkey.state);
+
+        if (keys && minimalProcessKey(keycode, action))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_KEY, (uint32_t)keycode, action, mods);
+
+        if (chars)
+        {
+            char buffer[16];
+            KeySym sym = NoSymbol;
+            XLookupString(&event->xkey, buffer, sizeof(buffer), &sym, NULL);
+
+            uint32_t codepoint = minimalX11GetCodepoint(sym);
+            if (codepoint > 31)
+                minimalDispatchWindowEvent(context, MINIMAL_EVENT_CHAR, codepoint, 0, mods);
+        }
+        return;
+    }
+    case ButtonPress:
+    case ButtonRelease:
+    {
+        uint32_t action = event->type == ButtonPress;
+        unsigned int xbutton = event->xbutton.button;
+
+        if (xbutton >= 4 && xbutton <= 7)
+        {
+            // scroll wheels only report presses
+            if (!action || !MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_SCROLLED)) return;
+
+            int32_t scroll = (xbutton == 4 || xbutton == 7) ? 1 : -1;
+            if (xbutton <= 5)   minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, 0, scroll);
+            else                minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_SCROLLED, 0, scroll, 0);
+            return;
+        }
+
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_BUTTON)) return;
+
+        MinimalMouseButton button = minimalX11GetMouseButton(xbutton);
+        int32_t x = event->xbutton.x;
+        int32_t y = event->xbutton.y;
+
+        if (minimalProcessMouseButton(button, action))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_BUTTON, ((uint32_t)button << 16) + action, x, y);
+        return;
+    }
+    case MotionNotify:
+    {
+        // may still be queued from before the input selection changed
+        if (!MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_MOUSE_MOVED)) return;
+
+        int32_t x = event->xmotion.x;
+        int32_t y = event->xmotion.y;
+
+        if (minimalProcessMouseMove((float)x, (float)y))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_MOUSE_MOVED, 0, x, y);
+        return;
+    }
+    case LeaveNotify:
+    {
+        minimalResetMouseDelta(context);
+        return;
+    }
+    case FocusIn:
+    case FocusOut:
+    {
+        // grabs move the focus temporarily without the window losing it
+        if (event->xfocus.mode == NotifyGrab || event->xfocus.mode == NotifyUngrab)
+            return;
+
+        context->focused = event->type == FocusIn;
+        return;
+    }
+    case ConfigureNotify:
+    {
+        uint32_t width  = (uint32_t)event->xconfigure.width;
+        uint32_t height = (uint32_t)event->xconfigure.height;
+
+        // configure notify is also sent for moves
+        if (width == context->width && height == context->height) return;
+
+        context->width = width;
+        context->height = height;
+
+        if (MINIMAL_EVENT_ENABLED(context, MINIMAL_EVENT_WINDOW_SIZE))
+            minimalDispatchWindowEvent(context, MINIMAL_EVENT_WINDOW_SIZE, 0, (int32_t)width, (int32_t)height);
+        return;
+    }
+    default: return;
+    }
+}
+
+/* --------------------------| framebuffer |----------------------------- */
+/* on failure the image is released without touching its data, which never came from malloc */
+static uint8_t minimalX11ReleaseShmImage(MinimalX11Framebuffer* fb)
+{
+    fb->image->data = NULL;
+    XDestroyImage(fb->image);
+    fb->image = NULL;
+
+    return MINIMAL_FAIL;
+}
+
+static uint8_t minimalX11CreateShmImage(MinimalWindow* window, MinimalX11Framebuffer* fb, uint32_t w, uint32_t h)
+{
+    fb->image = XShmCreateImage(_minimalDisplay, window->visual, (unsigned int)window->depth, ZPixmap, NULL, &fb->shm, w, h);
+    if (!fb->image) return MINIMAL_FAIL;
+
+    fb->shm.shmid = shmget(IPC_PRIVATE, (size_t)fb->image->bytes_per_line * fb->image->height, IPC_CREAT | 0600);
+    if (fb->shm.shmid < 0) return minimalX11ReleaseShmImage(fb);
+
+    fb->shm.shmaddr = shmat(fb->shm.shmid, NULL, 0);
+    if (fb->shm.shmaddr == (char*)-1)
+    {
+        shmctl(fb->shm.shmid, IPC_RMID, NULL);
+        fb->shm.shmaddr = NULL;
+        return minimalX11ReleaseShmImage(fb);
+    }
+
+    fb->image->data = fb->shm.shmaddr;
+    fb->shm.readOnly = False;
+
+    // attaching fails on remote displays, which only shows up as an async error
+    _minimalX11Error = 0;
+    int (*handler)(Display*, XErrorEvent*) = XSetErrorHandler(minimalX11ErrorHandler);
+
+    Status attached = XShmAttach(_minimalDisplay, &fb->shm);
+    XSync(_minimalDisplay, False);
+
+    XSetErrorHandler(handler);
+
+    // the segment is freed once both sides detached
+    shmctl(fb->shm.shmid, IPC_RMID, NULL);
+
+    if (!attached || _minimalX11Error)
+    {
+        shmdt(fb->shm.shmaddr);
+        fb->shm.shmaddr = NULL;
+        return minimalX11ReleaseShmImage(fb);
+    }
+
+    return MINIMAL_OK;
+}
+
+static uint8_t minimalX11CreateImage(MinimalWindow* window, MinimalX11Framebuffer* fb, uint32_t w, uint32_t h)
+{
+    char* data = malloc((size_t)w * h * 4);
+    if (!data) return MINIMAL_FAIL;
+
+    fb->image = XCreateImage(_minimalDisplay, window->visual, (unsigned int)window->depth, ZPixmap, 0, data, w, h, 32, 0);
+    if (!fb->image)
+    {
+        free(data);
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+static void minimalX11DestroyFramebuffer(MinimalWindow* window, MinimalX11Framebuffer* fb)
+{
+    if (fb->shm.shmaddr)
+    {
+        XShmDetach(_minimalDisplay, &fb->shm);
+        shmdt(fb->shm.shmaddr);
+    }
+
+    if (fb->image)
+    {
+        // shared memory is not owned by the image
+        if (fb->shm.shmaddr) fb->image->data = NULL;
+        XDestroyImage(fb->image);
+    }
+
+    memset(fb, 0, sizeof(MinimalX11Framebuffer));
+}
+
+static Bool minimalX11IsShmCompletion(Display* display, XEvent* event, XPointer arg)
+{
+    const MinimalX11Framebuffer* fb = (const MinimalX11Framebuffer*)arg;
+    return event->type == _minimalShmCompletion && ((XShmCompletionEvent*)event)->shmseg == fb->shm.shmseg;
+}
+
+uint32_t* minimalCreateFramebuffer(MinimalWindow* window, uint32_t w, uint32_t h)
+{
+    minimalDestroyFramebuffer(window);
+
+    // pixels are written as 32 bit words, which only matches true color visuals
+    if (window->depth != 24 && window->depth != 32)
+    {
+        MINIMAL_ERROR("[Platform] Framebuffer needs a 24 or 32 bit visual (depth is %d)", window->depth);
+        return NULL;
+    }
+
+    window->framebufferShm = _minimalShmCompletion >= 0;
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT && window->framebufferShm; ++i)
+    {
+        if (!minimalX11CreateShmImage(window, &window->framebuffers[i], w, h))
+        {
+            MINIMAL_WARN("[Platform] MIT-SHM is not available, presenting with XPutImage");
+            minimalDestroyFramebuffer(window);
+            window->framebufferShm = 0;
+        }
+    }
+
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT && !window->framebufferShm; ++i)
+    {
+        if (!minimalX11CreateImage(window, &window->framebuffers[i], w, h))
+        {
+            MINIMAL_ERROR("[Platform] Failed to create framebuffer");
+            minimalDestroyFramebuffer(window);
+            return NULL;
+        }
+    }
+
+    window->gc = XCreateGC(_minimalDisplay, window->handle, 0, NULL);
+    window->framebufferIndex = 0;
+
+    return (uint32_t*)window->framebuffers[0].image->data;
+}
+
+void minimalDestroyFramebuffer(MinimalWindow* window)
+{
+    for (int i = 0; i < MINIMAL_FRAMEBUFFER_COUNT; ++i)
+        minimalX11DestroyFramebuffer(window, &window->framebuffers[i]);
+
+    if (window->gc)
+    {
+        XFreeGC(_minimalDisplay, window->gc);
+        window->gc = NULL;
+    }
+
+    XSync(_minimalDisplay, False);
+}
+
+uint32_t* minimalPresentFramebuffer(MinimalWindow* window)
+{
+    MinimalX11Framebuffer* current = &window->framebuffers[window->framebufferIndex];
+    if (!current->image) return NULL;
+
+    unsigned int w = (unsigned int)current->image->width;
+    unsigned int h = (unsigned int)current->image->height;
+
+    if (window->framebufferShm)
+    {
+        XShmPutImage(_minimalDisplay, window->handle, window->gc, current->image, 0, 0, 0, 0, w, h, True);
+        current->busy = 1;
+    }
+    else
+    {
+        XPutImage(_minimalDisplay, window->handle, window->gc, current->image, 0, 0, 0, 0, w, h);
+    }
+    XFlush(_minimalDisplay);
+
+    window->framebufferIndex = (window->framebufferIndex + 1) % MINIMAL_FRAMEBUFFER_COUNT;
+    MinimalX11Framebuffer* next = &window->framebuffers[window->framebufferIndex];
+
+    // the server may still be reading the buffer presented before
+    if (next->busy)
+    {
+        XEvent event;
+        XIfEvent(_minimalDisplay, &event, minimalX11IsShmCompletion, (XPointer)next);
+        next->busy = 0;
+    }
+
+    return (uint32_t*)next->image->data;
+}
+
+/* --------------------------| glx |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_GLX
+
+#ifndef GLX_ARB_create_context
+#define GLX_CONTEXT_MAJOR_VERSION_ARB               0x2091
+#define GLX_CONTEXT_MINOR_VERSION_ARB               0x2092
+#define GLX_CONTEXT_FLAGS_ARB                       0x2094
+#define GLX_CONTEXT_PROFILE_MASK_ARB                0x9126
+
+#define GLX_CONTEXT_DEBUG_BIT_ARB                   0x0001
+#define GLX_CONTEXT_CORE_PROFILE_BIT_ARB            0x00000001
+#endif
+
+// GLX extension pointer typedefs
+typedef GLXContext(*glXCreateContextAttribsARB_T)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
+typedef void(*glXSwapIntervalEXT_T)(Display*, GLXDrawable, int);
+typedef int(*glXSwapIntervalMESA_T)(unsigned int);
+
+static glXCreateContextAttribsARB_T _glXCreateContextAttribsARB = NULL;
+static glXSwapIntervalEXT_T         _glXSwapIntervalEXT = NULL;
+static glXSwapIntervalMESA_T        _glXSwapIntervalMESA = NULL;
+
+static uint8_t _minimalGLXError = 0;
+
+static int minimalGLXErrorHandler(Display* display, XErrorEvent* event)
+{
+    _minimalGLXError = 1;
+    return 0;
+}
+
+uint8_t minimalGLXInit()
+{
+    int major = 0, minor = 0;
+    if (!glXQueryVersion(_minimalDisplay, &major, &minor) || (major == 1 && minor < 3))
+    {
+        MINIMAL_ERROR("[GLX] GLX 1.3 is required");
+        return MINIMAL_FAIL;
+    }
+
+    _glXCreateContextAttribsARB =   (glXCreateContextAttribsARB_T)glXGetProcAddressARB((const GLubyte*)"glXCreateContextAttribsARB");
+    _glXSwapIntervalEXT =           (glXSwapIntervalEXT_T)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalEXT");
+    _glXSwapIntervalMESA =          (glXSwapIntervalMESA_T)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalMESA");
+
+    return MINIMAL_OK;
+}
+
+uint8_t minimalGLXChooseConfig(GLXFBConfig* config)
+{
+    int fbAttribs[] = {
+        GLX_X_RENDERABLE,   True,
+        GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
+        GLX_RENDER_TYPE,    GLX_RGBA_BIT,
+        GLX_X_VISUAL_TYPE,  GLX_TRUE_COLOR,
+        GLX_DOUBLEBUFFER,   True,
+        GLX_RED_SIZE,       8,
+        GLX_GREEN_SIZE,     8,
+        GLX_BLUE_SIZE,      8,
+        GLX_ALPHA_SIZE,     8,
+        GLX_DEPTH_SIZE,     24,
+        GLX_STENCIL_SIZE,   8,
+        None
+    };
+
+    int count = 0;
+    GLXFBConfig* configs = glXChooseFBConfig(_minimalDisplay, _minimalScreen, fbAttribs, &count);
+    if (!configs || !count)
+    {
+        MINIMAL_ERROR("[GLX] Could not find a suitable framebuffer config");
+        return MINIMAL_FAIL;
+    }
+
+    *config = configs[0];
+    XFree(configs);
+
+    return MINIMAL_OK;
+}
+
+GLXContext minimalCreateRenderContext(Window handle, GLXFBConfig config)
+{
+    int32_t major = windowHints[MINIMAL_HINT_CONTEXT_MAJOR_VERSION];
+    int32_t minor = windowHints[MINIMAL_HINT_CONTEXT_MINOR_VERSION];
+
+    // context creation failures are reported as X errors, which terminate by default
+    _minimalGLXError = 0;
+    XSync(_minimalDisplay, False);
+    int (*handler)(Display*, XErrorEvent*) = XSetErrorHandler(minimalGLXErrorHandler);
+
+    GLXContext rc = NULL;
+    if (_glXCreateContextAttribsARB)
+    {
+        int glAttribs[16];
+        int i = 0;
+
+        // without a version hint the driver picks its default
+        if (major > 0)
+        {
+            glAttribs[i++] = GLX_CONTEXT_MAJOR_VERSION_ARB; glAttribs[i++] = major;
+            glAttribs[i++] = GLX_CONTEXT_MINOR_VERSION_ARB; glAttribs[i++] = minor;
+        }
+
+        if (major > 3 || (major == 3 && minor >= 2))
+        {
+            glAttribs[i++] = GLX_CONTEXT_PROFILE_MASK_ARB;  glAttribs[i++] = GLX_CONTEXT_CORE_PROFILE_BIT_ARB;
+        }
+#ifdef _DEBUG
+        glAttribs[i++] = GLX_CONTEXT_FLAGS_ARB;             glAttribs[i++] = GLX_CONTEXT_DEBUG_BIT_ARB;
+#endif // _DEBUG
+        glAttribs[i] = None;
+
+        rc = _glXCreateContextAttribsARB(_minimalDisplay, config, NULL, True, glAttribs);
+    }
+    else
+    {
+        rc = glXCreateNewContext(_minimalDisplay, config, GLX_RGBA_TYPE, NULL, True);
+    }
+
+    XSync(_minimalDisplay, False);
+    XSetErrorHandler(handler);
+
+    if (!rc || _minimalGLXError)
+    {
+        MINIMAL_ERROR("[GLX] Failed to create render context");
+        return NULL;
+    }
+
+    if (!glXMakeCurrent(_minimalDisplay, handle, rc))
+    {
+        MINIMAL_ERROR("[GLX] Failed to make render context current");
+        glXDestroyContext(_minimalDisplay, rc);
+        return NULL;
+    }
+
+    return rc;
+}
+
+void* minimalGetGLProcAddress(const char* name)
+{
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+}
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    glXSwapBuffers(_minimalDisplay, context->handle);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    GLXDrawable drawable = glXGetCurrentDrawable();
+
+    if (_glXSwapIntervalEXT && drawable)    _glXSwapIntervalEXT(_minimalDisplay, drawable, interval);
+    else if (_glXSwapIntervalMESA)          _glXSwapIntervalMESA(interval);
+}
+
+#endif // MINIMAL_CONTEXT_GLX
+
+/* --------------------------| egl |------------------------------------- */
+#ifdef MINIMAL_CONTEXT_EGL
+
+void minimalSwapBuffers(MinimalWindow* context)
+{
+    minimalEGLSwapBuffers(&context->egl);
+}
+
+void minimalSwapInterval(uint8_t interval)
+{
+    minimalEGLSwapInterval(interval);
+}
+
+#endif // MINIMAL_CONTEXT_EGL
+
+#endif // MINIMAL_PLATFORM_X11
@@ -0,0 +1,273 @@
+#include "minimal.h"
+
+#include <stdio.h>
+
+/*
+ * A recording is a 16 byte file header followed by 40 byte records in native
+ * byte order. Frame records mark the start of a frame and carry its time and
+ * the time since the previous frame, event records are followed by their
+ * payload padded to 8 bytes. Every record starts 8 byte aligned, so the file
+ * is loaded as a whole and read in place. ftell limits it to 2 GB on windows.
+ */
+#define MINIMAL_RECORD_MAGIC        "MINREC\0\0"
+#define MINIMAL_RECORD_VERSION      1
+
+#define MINIMAL_RECORD_FRAME        1
+#define MINIMAL_RECORD_EVENT        2
+
+#define MINIMAL_RECORD_PADDED(size) (((size) + 7) & ~(size_t)7)
+
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+} MinimalRecordHeader;
+
+typedef struct
+{
+    uint32_t kind;
+    uint32_t type;
+    uint64_t time;
+    uint64_t delta;
+    uint32_t uParam;
+    int32_t lParam;
+    int32_t rParam;
+    uint32_t size;
+} MinimalRecord;
+
+static struct
+{
+    FILE* file;
+    uint32_t frames;
+    uint8_t capturing;
+    uint8_t failed;
+} record;
+
+static struct
+{
+    uint8_t* data;
+    size_t size;
+    size_t cursor;
+} replay;
+
+/* --------------------------| record |---------------------------------- */
+/* a failed write ends the recording, minimalRecordStop reports it */
+static void minimalRecordWrite(const void* data, size_t size)
+{
+    if (!record.file || fwrite(data, 1, size, record.file) == size) return;
+
+    MINIMAL_ERROR("[Record] Failed to write the recording, the rest of it is lost");
+    fclose(record.file);
+    record.file = NULL;
+    record.failed = 1;
+}
+
+uint8_t minimalRecordStart(const char* path)
+{
+    minimalRecordStop();
+
+    record.file = fopen(path, "wb");
+    if (!record.file)
+    {
+        MINIMAL_ERROR("[Record] Failed to open %s", path);
+        return MINIMAL_FAIL;
+    }
+
+    MinimalRecordHeader header = { .version = MINIMAL_RECORD_VERSION };
+    MINIMAL_MEMCPY(header.magic, MINIMAL_RECORD_MAGIC, sizeof(header.magic));
+
+    minimalRecordWrite(&header, sizeof(header));
+    record.frames = 0;
+
+    return record.file ? MINIMAL_OK : MINIMAL_FAIL;
+}
+
+uint8_t minimalRecordStop()
+{
+    uint8_t result = !record.failed;
+    if (record.file && fclose(record.file) != 0)
+    {
+        MINIMAL_ERROR("[Record] Failed to finish the recording");
+        result = MINIMAL_FAIL;
+    }
+
+    record.file = NULL;
+    record.failed = 0;
+    return result;
+}
+
+void minimalRecordFrame(uint64_t time, uint64_t delta)
+{
+    if (!record.file) return;
+
+    MinimalRecord r = { .kind = MINIMAL_RECORD_FRAME, .time = time, .delta = delta };
+    minimalRecordWrite(&r, sizeof(r));
+    record.frames++;
+}
+
+void minimalRecordCapture(uint8_t capture)
+{
+    record.capturing = capture;
+}
+
+void minimalRecordEvent(const MinimalEvent* e, const void* data, size_t size)
+{
+    // only input polled as part of a frame is recorded, replayed events are not recorded again
+    if (!record.file || !record.capturing || !record.frames || replay.data) return;
+
+    // a payload of unknown size can not be kept, replaying the event without it would crash its handlers
+    if (e->type > MINIMAL_EVENT_LAST && data && !size)
+    {
+        MINIMAL_WARN("[Record] Event %u has a payload of unknown size and is not recorded, use minimalDispatchExternalEventCopy", e->type);
+        return;
+    }
+
+    MinimalRecord r = { .kind = MINIMAL_RECORD_EVENT, .type = e->type, .time = e->time };
+    if (e->type > MINIMAL_EVENT_LAST)
+    {
+        r.size = (uint32_t)size;
+    }
+    else
+    {
+        r.uParam = e->uParam;
+        r.lParam = e->lParam;
+        r.rParam = e->rParam;
+    }
+
+    minimalRecordWrite(&r, sizeof(r));
+
+    if (r.size)
+    {
+        static const uint8_t padding[8] = { 0 };
+        minimalRecordWrite(data, r.size);
+        minimalRecordWrite(padding, MINIMAL_RECORD_PADDED(r.size) - r.size);
+    }
+}
+
+/* --------------------------| replay |---------------------------------- */
+uint8_t minimalReplayStart(const char* path)
+{
+    minimalReplayStop();
+
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        MINIMAL_ERROR("[Record] Failed to open %s", path);
+        return MINIMAL_FAIL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    MinimalRecordHeader header = { 0 };
+    if (size < 0)
+    {
+        MINIMAL_ERROR("[Record] Failed to read %s", path);
+        fclose(file);
+        return MINIMAL_FAIL;
+    }
+
+    if (size < (long)sizeof(header) || fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, MINIMAL_RECORD_MAGIC, sizeof(header.magic)) != 0
+        || header.version != MINIMAL_RECORD_VERSION)
+    {
+        MINIMAL_ERROR("[Record] %s is not a recording", path);
+        fclose(file);
+        return MINIMAL_FAIL;
+    }
+
+    replay.size = (size_t)size - sizeof(header);
+    replay.data = MINIMAL_ALLOC(replay.size ? replay.size : 1);
+    if (!replay.data || fread(replay.data, 1, replay.size, file) != replay.size)
+    {
+        MINIMAL_ERROR("[Record] Failed to read %s", path);
+        fclose(file);
+        minimalReplayStop();
+        return MINIMAL_FAIL;
+    }
+
+    fclose(file);
+    replay.cursor = 0;
+
+    return MINIMAL_OK;
+}
+
+void minimalReplayStop()
+{
+    if (replay.data) MINIMAL_FREE(replay.data, replay.size);
+
+    replay.data = NULL;
+    replay.size = 0;
+    replay.cursor = 0;
+}
+
+uint8_t minimalReplaying()
+{
+    return replay.data != NULL;
+}
+
+/* the record at the cursor, NULL at the end or if the rest of the file is truncated */
+static const MinimalRecord* minimalReplayPeek()
+{
+    if (replay.size - replay.cursor < sizeof(MinimalRecord)) return NULL;
+
+    const MinimalRecord* r = (const MinimalRecord*)(replay.data + replay.cursor);
+    if (MINIMAL_RECORD_PADDED(r->size) > replay.size - replay.cursor - sizeof(MinimalRecord)) return NULL;
+
+    return r;
+}
+
+uint8_t minimalReplayFrame(uint64_t* time, uint64_t* delta)
+{
+    const MinimalRecord* r = minimalReplayPeek();
+    if (!r || r->kind != MINIMAL_RECORD_FRAME) return MINIMAL_FAIL;
+
+    replay.cursor += sizeof(MinimalRecord);
+    *time = r->time;
+    *delta = r->delta;
+
+    return MINIMAL_OK;
+}
+
+void minimalReplayEvents(MinimalWindow* window)
+{
+    const MinimalRecord* r;
+    while ((r = minimalReplayPeek()) != NULL && r->kind == MINIMAL_RECORD_EVENT)
+    {
+        replay.cursor += sizeof(MinimalRecord) + MINIMAL_RECORD_PADDED(r->size);
+
+        minimalSetEventTime(r->time);
+
+        // input goes through the same state updates as on the platform that recorded it
+        switch (r->type)
+        {
+        case MINIMAL_EVENT_KEY:
+            if (minimalProcessKey((MinimalKeycode)r->uParam, (uint8_t)r->lParam))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        case MINIMAL_EVENT_MOUSE_BUTTON:
+            if (minimalProcessMouseButton((MinimalMouseButton)(r->uParam >> 16), (uint8_t)(r->uParam & 0xffff)))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        case MINIMAL_EVENT_MOUSE_MOVED:
+            if (minimalProcessMouseMove((float)r->lParam, (float)r->rParam))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        case MINIMAL_EVENT_MOUSE_RAW:
+            if (minimalProcessMouseRaw(r->lParam, r->rParam))
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        default:
+            if (r->type > MINIMAL_EVENT_LAST)
+                minimalDispatchExternalEvent(r->type, r->size ? (const void*)(r + 1) : NULL);
+            else
+                minimalDispatchWindowEvent(window, r->type, r->uParam, r->lParam, r->rParam);
+            break;
+        }
+    }
+
+    minimalSetEventTime(0);
+    minimalFlushEvents();
+}
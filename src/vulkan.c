@@ -0,0 +1,151 @@
+#include "minimal.h"
+
+#ifndef MINIMAL_LOAD_MODULE
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       (void*)LoadLibraryA(name)
+    #define MINIMAL_FREE_MODULE(module)     FreeLibrary((HMODULE)(module))
+    #define MINIMAL_MODULE_SYMBOL(m, name)  (void*)GetProcAddress((HMODULE)(m), name)
+#else
+    #include <dlfcn.h>
+
+    #define MINIMAL_LOAD_MODULE(name)       dlopen(name, RTLD_LAZY | RTLD_LOCAL)
+    #define MINIMAL_FREE_MODULE(module)     dlclose(module)
+    #define MINIMAL_MODULE_SYMBOL(m, name)  dlsym(m, name)
+#endif
+#endif
+
+#ifdef _WIN32
+    #define MINIMAL_VKAPI __stdcall
+#else
+    #define MINIMAL_VKAPI
+#endif
+
+/* the subset of vulkan.h needed for surface creation, so vulkan headers stay optional */
+#ifndef VK_VERSION_1_0
+typedef struct VkInstance_T* VkInstance;
+typedef uint64_t VkSurfaceKHR;
+typedef int32_t VkResult;
+typedef struct VkAllocationCallbacks VkAllocationCallbacks;
+
+#define VK_SUCCESS                          0
+#define VK_ERROR_INITIALIZATION_FAILED      -3
+#define VK_ERROR_EXTENSION_NOT_PRESENT      -7
+#endif
+
+typedef void (MINIMAL_VKAPI* MinimalVkVoidFunction)(void);
+typedef MinimalVkVoidFunction(MINIMAL_VKAPI* MinimalVkGetInstanceProcAddr)(VkInstance, const char*);
+
+/* every surface create function has the same signature, only the create info differs */
+typedef VkResult(MINIMAL_VKAPI* MinimalVkCreateSurface)(VkInstance, const void*, const VkAllocationCallbacks*, VkSurfaceKHR*);
+
+typedef struct
+{
+    int32_t     sType;
+    const void* pNext;
+    uint32_t    flags;
+    void*       display;
+    void*       window;
+} MinimalVkSurfaceCreateInfo;
+
+#if defined(MINIMAL_PLATFORM_WINDOWS)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_KHR_win32_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateWin32SurfaceKHR"
+    #define MINIMAL_VK_SURFACE_STYPE        1000009000
+#elif defined(MINIMAL_PLATFORM_X11)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_KHR_xlib_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateXlibSurfaceKHR"
+    #define MINIMAL_VK_SURFACE_STYPE        1000004000
+#elif defined(MINIMAL_PLATFORM_WAYLAND)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_KHR_wayland_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateWaylandSurfaceKHR"
+    #define MINIMAL_VK_SURFACE_STYPE        1000006000
+#elif defined(MINIMAL_PLATFORM_HEADLESS)
+    #define MINIMAL_VK_SURFACE_EXTENSION    "VK_EXT_headless_surface"
+    #define MINIMAL_VK_SURFACE_CREATE       "vkCreateHeadlessSurfaceEXT"
+    #define MINIMAL_VK_SURFACE_STYPE        1000256000
+#endif
+
+#ifdef MINIMAL_VK_SURFACE_EXTENSION
+
+#ifdef _WIN32
+static const char* _minimalVulkanModules[] = { "vulkan-1.dll", NULL };
+#else
+static const char* _minimalVulkanModules[] = { "libvulkan.so.1", "libvulkan.so", NULL };
+#endif
+
+static const char* _minimalVulkanExtensions[] = { "VK_KHR_surface", MINIMAL_VK_SURFACE_EXTENSION };
+
+static void* _minimalVulkanModule = NULL;
+static MinimalVkGetInstanceProcAddr _minimalVkGetInstanceProcAddr = NULL;
+
+/* the loader is looked up once and kept for the lifetime of the process */
+static uint8_t minimalLoadVulkan()
+{
+    if (_minimalVkGetInstanceProcAddr) return MINIMAL_OK;
+
+    for (int i = 0; _minimalVulkanModules[i] && !_minimalVulkanModule; ++i)
+        _minimalVulkanModule = MINIMAL_LOAD_MODULE(_minimalVulkanModules[i]);
+
+    if (!_minimalVulkanModule)
+    {
+        MINIMAL_ERROR("[Vulkan] Failed to load the vulkan loader");
+        return MINIMAL_FAIL;
+    }
+
+    _minimalVkGetInstanceProcAddr = (MinimalVkGetInstanceProcAddr)MINIMAL_MODULE_SYMBOL(_minimalVulkanModule, "vkGetInstanceProcAddr");
+    if (!_minimalVkGetInstanceProcAddr)
+    {
+        MINIMAL_ERROR("[Vulkan] Loader does not export vkGetInstanceProcAddr");
+        MINIMAL_FREE_MODULE(_minimalVulkanModule);
+        _minimalVulkanModule = NULL;
+        return MINIMAL_FAIL;
+    }
+
+    return MINIMAL_OK;
+}
+
+const char** minimalGetRequiredVulkanInstanceExtensions(uint32_t* count)
+{
+    if (count) *count = 0;
+    if (!minimalLoadVulkan()) return NULL;
+
+    if (count) *count = sizeof(_minimalVulkanExtensions) / sizeof(_minimalVulkanExtensions[0]);
+    return _minimalVulkanExtensions;
+}
+
+VkResult minimalCreateVulkanSurface(VkInstance instance, const MinimalWindow* window, const VkAllocationCallbacks* allocator, VkSurfaceKHR* surface)
+{
+    *surface = 0;
+    if (!minimalLoadVulkan()) return VK_ERROR_INITIALIZATION_FAILED;
+
+    MinimalVkCreateSurface createSurface = (MinimalVkCreateSurface)_minimalVkGetInstanceProcAddr(instance, MINIMAL_VK_SURFACE_CREATE);
+    if (!createSurface)
+    {
+        MINIMAL_ERROR("[Vulkan] Instance was created without " MINIMAL_VK_SURFACE_EXTENSION);
+        return VK_ERROR_EXTENSION_NOT_PRESENT;
+    }
+
+    // display and window share the layout of the platform create infos, headless ignores them
+    MinimalVkSurfaceCreateInfo info = {
+        .sType      = MINIMAL_VK_SURFACE_STYPE,
+        .pNext      = NULL,
+        .flags      = 0,
+        .display    = minimalGetNativeDisplayHandle(),
+        .window     = minimalGetNativeWindowHandle(window)
+    };
+
+    VkResult result = createSurface(instance, &info, allocator, surface);
+    if (result != VK_SUCCESS)
+    {
+        MINIMAL_ERROR("[Vulkan] Failed to create surface (%d)", (int)result);
+    }
+
+    return result;
+}
+
+#endif // MINIMAL_VK_SURFACE_EXTENSION